@@ -0,0 +1,203 @@
+#ifndef _ALIGNED_ALLOCATOR_H_
+#define _ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uintptr_t
+#include <limits>      // std::numeric_limits
+#include <new>         // std::align_val_t, std::bad_alloc
+#include <type_traits> // std::true_type
+
+#include <sys/mman.h> // mmap, munmap, madvise
+
+#include "vector.h" // sc::vector, sc::growth
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+/// Grabs room for `count_` objects of `size_` bytes, aligned to `align_`.
+inline void *aligned_new(std::size_t count_, std::size_t size_,
+                         std::size_t align_) {
+  if (count_ > std::numeric_limits<std::size_t>::max() / size_) {
+    throw std::bad_array_new_length{};
+  }
+  return ::operator new(count_ * size_, std::align_val_t{align_});
+}
+inline void aligned_delete(void *ptr_, std::size_t align_) noexcept {
+  ::operator delete(ptr_, std::align_val_t{align_});
+}
+} // namespace detail
+
+/// An allocator whose blocks start on an `Align`-byte boundary.
+/*!
+ * With `sc::vector`, `data()` is then aligned too, so SIMD code may use
+ * aligned loads and no element straddles a cache line needlessly. The
+ * front slack left by `push_front()` moves `data()` past the start of the
+ * block, so there the alignment only holds for the block.
+ *
+ * \tparam T The type of the elements.
+ * \tparam Align The alignment, in bytes: a power of two, at least
+ * `alignof(T)`. 64 is a cache line, and a whole AVX-512 register.
+ */
+template <typename T, std::size_t Align = 64> struct aligned_allocator {
+  static_assert(Align != 0 && (Align & (Align - 1)) == 0,
+                "the alignment must be a power of two");
+  static_assert(Align >= alignof(T),
+                "the alignment must not be weaker than the type's own");
+
+  using value_type = T;
+  using is_always_equal = std::true_type;
+  /// `std::allocator_traits` cannot rebind past the `Align` argument.
+  template <typename U> struct rebind {
+    using other = aligned_allocator<U, Align>;
+  };
+  static constexpr std::size_t alignment = Align; //!< `Align`.
+
+  aligned_allocator(void) noexcept = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Align> &) noexcept {}
+
+  T *allocate(std::size_t count_) {
+    return static_cast<T *>(detail::aligned_new(count_, sizeof(T), Align));
+  }
+  void deallocate(T *ptr_, std::size_t) noexcept {
+    detail::aligned_delete(ptr_, Align);
+  }
+
+  friend bool operator==(const aligned_allocator &, const aligned_allocator &) {
+    return true;
+  }
+  friend bool operator!=(const aligned_allocator &, const aligned_allocator &) {
+    return false;
+  }
+};
+
+/// Where `huge_page_allocator` looks for huge pages.
+enum class huge_pages {
+  /// Transparent huge pages: the kernel is asked (`MADV_HUGEPAGE`) to
+  /// back the block with them, and uses small pages where it cannot.
+  transparent,
+  /// The reserved pool (`MAP_HUGETLB`, see /proc/sys/vm/nr_hugepages)
+  /// first, and transparent huge pages when the pool is short.
+  reserved,
+};
+
+/// An allocator that backs large blocks with 2 MiB pages.
+/*!
+ * Random access over a vector of many gigabytes misses the TLB on nearly
+ * every element with 4 KiB pages; with 2 MiB pages, 512 times fewer
+ * entries cover the same memory. Blocks of at least `huge_page_size` are
+ * mapped with `mmap`, on a 2 MiB boundary and in whole huge pages, so the
+ * kernel can use a huge page for every part of them. Smaller blocks are
+ * not worth a huge page and come from `operator new`, aligned to 64
+ * bytes; so do large ones on systems without `mmap`.
+ *
+ * Huge pages are a request, not a promise: when none are available the
+ * block is backed by small pages and works the same, only slower. Memory
+ * only runs out (`std::bad_alloc`) when `mmap` itself fails.
+ *
+ * \tparam T The type of the elements.
+ * \tparam Mode Where huge pages come from; see `sc::huge_pages`.
+ */
+template <typename T, huge_pages Mode = huge_pages::transparent>
+struct huge_page_allocator {
+  static_assert(alignof(T) <= 64, "huge_page_allocator aligns to 64 bytes");
+
+  using value_type = T;
+  using is_always_equal = std::true_type;
+  /// `std::allocator_traits` cannot rebind past the `Mode` argument.
+  template <typename U> struct rebind {
+    using other = huge_page_allocator<U, Mode>;
+  };
+  static constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+  static constexpr std::size_t alignment = 64; //!< Of the smaller blocks.
+
+  huge_page_allocator(void) noexcept = default;
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U, Mode> &) noexcept {}
+
+  T *allocate(std::size_t count_) {
+    constexpr std::size_t max_bytes =
+        std::numeric_limits<std::size_t>::max() - 2 * huge_page_size;
+    if (count_ > max_bytes / sizeof(T)) {
+      throw std::bad_array_new_length{};
+    }
+    if (!mapped(count_)) {
+      return static_cast<T *>(
+          detail::aligned_new(count_, sizeof(T), alignment));
+    }
+    std::size_t bytes = rounded(count_);
+#if defined(MAP_HUGETLB)
+    if constexpr (Mode == huge_pages::reserved) {
+      void *ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED) {
+        return static_cast<T *>(ptr);
+      }
+    }
+#endif
+    // Map one huge page too many, then trim both ends to a 2 MiB boundary.
+    void *raw = ::mmap(nullptr, bytes + huge_page_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc{};
+    }
+    auto start = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+    if (aligned > start) {
+      ::munmap(raw, aligned - start);
+    }
+    ::munmap(reinterpret_cast<void *>(aligned + bytes),
+             start + huge_page_size - aligned);
+    void *ptr = reinterpret_cast<void *>(aligned);
+#if defined(MADV_HUGEPAGE)
+    // Fails where transparent huge pages are off; small pages do then.
+    ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+    return static_cast<T *>(ptr);
+  }
+  void deallocate(T *ptr_, std::size_t count_) noexcept {
+    if (!mapped(count_)) {
+      detail::aligned_delete(ptr_, alignment);
+    } else {
+      ::munmap(static_cast<void *>(ptr_), rounded(count_));
+    }
+  }
+
+  friend bool operator==(const huge_page_allocator &,
+                         const huge_page_allocator &) {
+    return true;
+  }
+  friend bool operator!=(const huge_page_allocator &,
+                         const huge_page_allocator &) {
+    return false;
+  }
+
+private:
+  /// Whether `count_` elements are mapped rather than taken from the heap.
+  static bool mapped(std::size_t count_) {
+#if defined(MAP_ANONYMOUS)
+    return count_ * sizeof(T) >= huge_page_size;
+#else
+    (void)count_;
+    return false;
+#endif
+  }
+  /// `count_` elements, in whole huge pages.
+  static std::size_t rounded(std::size_t count_) {
+    return (count_ * sizeof(T) + huge_page_size - 1) & ~(huge_page_size - 1);
+  }
+};
+
+/// A vector whose `data()` is aligned to `Align` bytes.
+template <typename T, std::size_t Align = 64,
+          typename GrowthPolicy = growth::doubling>
+using aligned_vector = vector<T, aligned_allocator<T, Align>, GrowthPolicy>;
+
+/// A vector backed by huge pages once it holds 2 MiB or more.
+template <typename T, huge_pages Mode = huge_pages::transparent,
+          typename GrowthPolicy = growth::doubling>
+using huge_page_vector =
+    vector<T, huge_page_allocator<T, Mode>, GrowthPolicy>;
+} // namespace sc.
+
+#endif
@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "aligned_allocator.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Twenty-first batch of tests, focused on aligned and huge-page storage
+// =============================================================
+
+// data() of an aligned_vector stays aligned as it grows and shrinks.
+#define ALIGNED_STORAGE YES
+// Large huge_page_vectors are mapped on 2 MiB boundaries.
+#define HUGE_PAGES YES
+// The allocators behave as allocator_traits expects.
+#define ALLOCATOR_TRAITS YES
+
+namespace {
+/// Whether `ptr_` is a multiple of `align_`.
+bool aligned(const void *ptr_, std::size_t align_) {
+  return reinterpret_cast<std::uintptr_t>(ptr_) % align_ == 0;
+}
+
+/// Whether `vec_` holds 0, 1, 2, ... in order.
+template <typename Vec> bool counts_up(const Vec &vec_) {
+  for (std::size_t i{0}; i < vec_.size(); ++i) {
+    if (vec_[i] != typename Vec::value_type(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+void run_aligned_allocator_tests(void) {
+  TestManager tm{"Aligned allocation testing"};
+
+#if ALIGNED_STORAGE
+  {
+    BEGIN_TEST(tm, "AlignedStorage", "data() is aligned after every growth");
+
+    sc::aligned_vector<char> bytes;
+    bool always{true};
+    for (int i{0}; i < 5000; ++i) {
+      bytes.push_back(char(i));
+      always = always && aligned(bytes.data(), 64);
+    }
+    EXPECT_TRUE(always);
+    bytes.erase(bytes.begin() + 3, bytes.end());
+    bytes.shrink_to_fit();
+    EXPECT_TRUE(aligned(bytes.data(), 64));
+    EXPECT_EQ(bytes[2], char(2));
+
+    sc::aligned_vector<double, 4096> pages(10);
+    EXPECT_TRUE(aligned(pages.data(), 4096));
+    pages.reserve(100'000);
+    EXPECT_TRUE(aligned(pages.data(), 4096));
+
+    sc::aligned_vector<int> ints;
+    for (int i{0}; i < 1000; ++i) {
+      ints.push_back(i);
+    }
+    sc::aligned_vector<int> copy{ints};
+    EXPECT_TRUE(aligned(copy.data(), 64));
+    EXPECT_TRUE(copy == ints);
+    sc::aligned_vector<int> moved{std::move(copy)};
+    EXPECT_TRUE(counts_up(moved));
+    EXPECT_TRUE(aligned(moved.data(), 64));
+  }
+#endif
+
+#if HUGE_PAGES
+  {
+    BEGIN_TEST(tm, "HugePages", "large blocks start on a huge page");
+
+    constexpr std::size_t huge{2 << 20};
+    sc::huge_page_vector<std::uint64_t> vec;
+    // Small blocks come from the heap, still on a cache line.
+    for (std::uint64_t i{0}; i < 100; ++i) {
+      vec.push_back(i);
+    }
+    EXPECT_TRUE(aligned(vec.data(), 64));
+    // Growing past 2 MiB moves the elements to a mapping.
+    for (std::uint64_t i{100}; i < 1'000'000; ++i) {
+      vec.push_back(i);
+    }
+    EXPECT_TRUE(aligned(vec.data(), huge));
+    EXPECT_TRUE(counts_up(vec));
+    vec.erase(vec.begin() + 10, vec.end());
+    vec.shrink_to_fit();
+    EXPECT_TRUE(counts_up(vec));
+    EXPECT_EQ(vec.size(), 10ul);
+
+    // Without a reserved pool, it falls back to transparent huge pages.
+    sc::huge_page_vector<int, sc::huge_pages::reserved> reserved;
+    reserved.reserve(1 << 20);
+    EXPECT_TRUE(aligned(reserved.data(), huge));
+    for (int i{0}; i < (1 << 20); ++i) {
+      reserved.push_back(i);
+    }
+    EXPECT_EQ(reserved.size(), std::size_t{1} << 20);
+    EXPECT_EQ(reserved.back(), (1 << 20) - 1);
+    sc::huge_page_vector<int, sc::huge_pages::reserved> copy{reserved};
+    EXPECT_TRUE(copy == reserved);
+  }
+#endif
+
+#if ALLOCATOR_TRAITS
+  {
+    BEGIN_TEST(tm, "AllocatorTraits", "rebind, equality and raw blocks");
+
+    using bytes = sc::aligned_allocator<char, 256>;
+    using traits = std::allocator_traits<bytes>;
+    using rebound = traits::rebind_alloc<long>;
+    EXPECT_TRUE(
+        (std::is_same<rebound, sc::aligned_allocator<long, 256>>::value));
+    EXPECT_TRUE(traits::is_always_equal::value);
+    EXPECT_TRUE(rebound{bytes{}} == rebound{});
+
+    rebound longs;
+    long *block = longs.allocate(3);
+    EXPECT_TRUE(aligned(block, 256));
+    longs.deallocate(block, 3);
+
+    sc::huge_page_allocator<double> doubles;
+    std::size_t many = (4 << 20) / sizeof(double) + 1;
+    double *big = doubles.allocate(many);
+    EXPECT_TRUE(aligned(big, 2 << 20));
+    // The tail of the last huge page is usable too.
+    big[many - 1] = 1.5;
+    EXPECT_EQ(big[many - 1], 1.5);
+    doubles.deallocate(big, many);
+    using huge_traits = std::allocator_traits<sc::huge_page_allocator<double>>;
+    EXPECT_TRUE((std::is_same<huge_traits::rebind_alloc<int>,
+                              sc::huge_page_allocator<int>>::value));
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Fifth batch of tests, focused on allocator support
+// =============================================================
+
+// Memory comes from the allocator, and all of it is given back.
+#define CUSTOM_ALLOCATOR YES
+// Allocators follow copy/move/swap as their traits ask.
+#define ALLOCATOR_PROPAGATION YES
+// Moving between unequal, non-propagating allocators moves the elements.
+#define UNEQUAL_MOVE YES
+// sc::pmr::vector draws from a memory resource.
+#define PMR_RESOURCE YES
+// Elements of a sc::pmr::vector share its memory resource.
+#define PMR_USES_ALLOCATOR YES
+
+namespace {
+/// Allocator that tags its memory with an id and counts the traffic.
+template <typename T, bool Propagate> struct TaggedAllocator {
+  using value_type = T;
+  using propagate_on_container_copy_assignment =
+      std::integral_constant<bool, Propagate>;
+  using propagate_on_container_move_assignment =
+      std::integral_constant<bool, Propagate>;
+  using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+  using is_always_equal = std::false_type;
+
+  static long live; //!< Bytes currently handed out, across all instances.
+  int id;           //!< Allocators with different ids are unequal.
+
+  explicit TaggedAllocator(int i = 0) : id{i} {}
+  template <typename U>
+  TaggedAllocator(const TaggedAllocator<U, Propagate> &other) : id{other.id} {}
+
+  T *allocate(std::size_t n) {
+    live += long(n * sizeof(T));
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T *ptr, std::size_t n) {
+    live -= long(n * sizeof(T));
+    ::operator delete(ptr);
+  }
+  friend bool operator==(const TaggedAllocator &a, const TaggedAllocator &b) {
+    return a.id == b.id;
+  }
+  friend bool operator!=(const TaggedAllocator &a, const TaggedAllocator &b) {
+    return a.id != b.id;
+  }
+};
+template <typename T, bool Propagate> long TaggedAllocator<T, Propagate>::live{0};
+} // namespace
+
+void run_allocator_tests(void) {
+  TestManager tm{"Allocator testing"};
+
+#if CUSTOM_ALLOCATOR
+  {
+    BEGIN_TEST(tm, "CustomAllocator", "vector<T, Alloc>");
+    using alloc_t = TaggedAllocator<std::string, true>;
+
+    {
+      sc::vector<std::string, alloc_t> vec{alloc_t{1}};
+      for (int i{0}; i < 100; ++i)
+        vec.push_back(std::to_string(i));
+      vec.insert(vec.begin(), {"a", "b"});
+      vec.erase(vec.begin() + 5, vec.begin() + 10);
+      vec.shrink_to_fit();
+      EXPECT_EQ(vec.size(), 97);
+      EXPECT_EQ(vec[2], "0");
+      EXPECT_EQ(alloc_t::live, long(97 * sizeof(std::string)));
+      EXPECT_EQ(vec.get_allocator().id, 1);
+    }
+    EXPECT_EQ(alloc_t::live, 0);
+  }
+#endif
+
+#if ALLOCATOR_PROPAGATION
+  {
+    BEGIN_TEST(tm, "AllocatorPropagation", "POCCA, POCMA and POCS");
+    using alloc_t = TaggedAllocator<int, true>;
+
+    sc::vector<int, alloc_t> vec1({1, 2, 3}, alloc_t{1});
+    sc::vector<int, alloc_t> vec2({4, 5}, alloc_t{2});
+
+    vec2 = vec1;
+    EXPECT_EQ(vec2.get_allocator().id, 1);
+    EXPECT_EQ(vec2, vec1);
+
+    sc::vector<int, alloc_t> vec3({7}, alloc_t{3});
+    vec3 = std::move(vec1);
+    EXPECT_EQ(vec3.get_allocator().id, 1);
+    EXPECT_EQ(vec3.size(), 3);
+    EXPECT_TRUE(vec1.empty());
+
+    sc::vector<int, alloc_t> vec4({8, 9}, alloc_t{4});
+    swap(vec3, vec4);
+    EXPECT_EQ(vec3.get_allocator().id, 4);
+    EXPECT_EQ(vec4.get_allocator().id, 1);
+    EXPECT_EQ(vec4[2], 3);
+  }
+#endif
+
+#if UNEQUAL_MOVE
+  {
+    BEGIN_TEST(tm, "UnequalMove", "move between unequal allocators");
+    using alloc_t = TaggedAllocator<int, false>;
+
+    {
+      sc::vector<int, alloc_t> vec1({1, 2, 3}, alloc_t{1});
+      sc::vector<int, alloc_t> vec2(alloc_t{2});
+      vec2 = std::move(vec1);
+      // vec2 keeps its own allocator, so the storage could not be stolen.
+      EXPECT_EQ(vec2.get_allocator().id, 2);
+      EXPECT_EQ(vec2, (sc::vector<int, alloc_t>{1, 2, 3}));
+      EXPECT_TRUE(vec1.empty());
+
+      sc::vector<int, alloc_t> vec3(std::move(vec2), alloc_t{3});
+      EXPECT_EQ(vec3.get_allocator().id, 3);
+      EXPECT_EQ(vec3.size(), 3);
+    }
+    EXPECT_EQ(alloc_t::live, 0);
+  }
+#endif
+
+#if PMR_RESOURCE
+  {
+    BEGIN_TEST(tm, "PmrResource", "sc::pmr::vector on a monotonic buffer");
+
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource()};
+    sc::pmr::vector<int> vec{&arena};
+    for (int i{0}; i < 200; ++i)
+      vec.push_back(i);
+
+    auto *first = reinterpret_cast<std::byte *>(vec.data());
+    EXPECT_TRUE(first >= buffer && first < buffer + sizeof(buffer));
+    EXPECT_EQ(vec.size(), 200);
+    EXPECT_EQ(vec.back(), 199);
+  }
+#endif
+
+#if PMR_USES_ALLOCATOR
+  {
+    BEGIN_TEST(tm, "PmrUsesAllocator", "elements share the memory resource");
+
+    std::pmr::unsynchronized_pool_resource pool;
+    sc::pmr::vector<std::pmr::string> vec{&pool};
+    vec.emplace_back("a string long enough to skip the small buffer");
+    vec.push_back(std::pmr::string{"another fairly long string, not inline"});
+
+    EXPECT_TRUE(vec.get_allocator().resource() == &pool);
+    EXPECT_TRUE(vec[0].get_allocator().resource() == &pool);
+    EXPECT_TRUE(vec[1].get_allocator().resource() == &pool);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,80 @@
+/*!
+ * @file allocator_bench.cpp
+ * @brief Compares where sc::vector gets its memory from on a request-like load.
+ *
+ * A "request" builds a handful of short-lived vectors of mixed sizes, fills
+ * them and throws them away. The same request runs over:
+ *  - `sc::vector` with the default allocator (malloc/realloc);
+ *  - `sc::pmr::vector` on a `monotonic_buffer_resource` released per request;
+ *  - `sc::pmr::vector` on an `unsynchronized_pool_resource`.
+ */
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+constexpr std::size_t requests{2'000};           //!< Requests per run.
+constexpr std::array<std::size_t, 6> sizes{4, 16, 7, 64, 3, 256}; //!< Vectors per request.
+
+/// One request: fill a vector of each size, with `make` building an empty one.
+template <typename MakeVec> long one_request(MakeVec &&make_) {
+  long sum{0};
+  for (std::size_t n : sizes) {
+    auto vec = make_();
+    for (std::size_t i{0}; i < n; ++i)
+      vec.push_back(int(i));
+    sum += vec.back();
+  }
+  return sum;
+}
+
+/// Total number of push_back()s a run performs, to report ns per element.
+constexpr std::size_t pushes_per_run(void) {
+  std::size_t total{0};
+  for (std::size_t n : sizes)
+    total += n;
+  return total * requests;
+}
+} // namespace
+
+int main(void) {
+  std::vector<bench::Result> results;
+
+  results.push_back(bench::run("sc::vector<int> / malloc", requests,
+                               pushes_per_run(), [] {
+                                 long sum{0};
+                                 for (std::size_t r{0}; r < requests; ++r)
+                                   sum += one_request(
+                                       [] { return sc::vector<int>{}; });
+                                 bench::do_not_optimize(sum);
+                               }));
+
+  // The arena lives on the stack and is rewound after every request.
+  results.push_back(bench::run(
+      "sc::pmr::vector<int> / monotonic arena", requests, pushes_per_run(), [] {
+        alignas(std::max_align_t) static std::byte buffer[64 * 1024];
+        long sum{0};
+        for (std::size_t r{0}; r < requests; ++r) {
+          std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer)};
+          sum += one_request([&arena] { return sc::pmr::vector<int>{&arena}; });
+        }
+        bench::do_not_optimize(sum);
+      }));
+
+  results.push_back(bench::run(
+      "sc::pmr::vector<int> / pool", requests, pushes_per_run(), [] {
+        static std::pmr::unsynchronized_pool_resource pool;
+        long sum{0};
+        for (std::size_t r{0}; r < requests; ++r)
+          sum += one_request([] { return sc::pmr::vector<int>{&pool}; });
+        bench::do_not_optimize(sum);
+      }));
+
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/*!
+ * @file bench.h
+ * @brief A tiny, self-contained micro-benchmark harness.
+ *
+ * Each benchmark is a callable that performs a known number of operations;
+ * the harness repeats it until enough time has passed and keeps the fastest
+ * run, which is the one least disturbed by the rest of the system.
+ */
+
+#include <algorithm> // std::min
+#include <chrono>    // std::chrono::steady_clock
+#include <cstddef>   // std::size_t
+#include <iomanip>   // std::setw
+#include <iostream>  // std::cout
+#include <limits>    // std::numeric_limits
+#include <string>    // std::string
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+/// Micro-benchmark harness namespace.
+namespace bench {
+/// Keeps the compiler from optimizing `value` (and its computation) away.
+template <typename T> inline void do_not_optimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// Makes every pending write to memory observable.
+inline void clobber_memory(void) { asm volatile("" : : : "memory"); }
+
+/// A single measurement.
+struct Result {
+  std::string name; //!< What was measured.
+  std::size_t n;    //!< Problem size.
+  double ns_per_op; //!< Best time per operation, in nanoseconds.
+};
+
+/*! Times `fn_`, which performs `ops_` operations per call.
+ * \param name_ label shown in the report.
+ * \param n_ problem size shown in the report.
+ * \param ops_ number of operations performed by a single call to `fn_`.
+ * \param fn_ the code being measured.
+ * \param min_seconds_ keep repeating until this much time has been spent.
+ * \return the fastest run, in nanoseconds per operation.
+ */
+template <typename Fn>
+Result run(const std::string &name_, std::size_t n_, std::size_t ops_,
+           Fn &&fn_, double min_seconds_ = 0.2) {
+  using clock = std::chrono::steady_clock;
+  double best{std::numeric_limits<double>::max()};
+  double total{0};
+  std::size_t reps{0};
+  do {
+    auto start = clock::now();
+    fn_();
+    clobber_memory();
+    std::chrono::duration<double> elapsed = clock::now() - start;
+    best = std::min(best, elapsed.count());
+    total += elapsed.count();
+    ++reps;
+  } while ((total < min_seconds_ || reps < 3) && reps < 1000);
+  return Result{name_, n_, best * 1e9 / double(ops_ ? ops_ : 1)};
+}
+
+/*! Like `run()`, but calls `setup_` before each repetition, untimed, and
+ * hands its result to `fn_`. Use it when the operation consumes its input.
+ */
+template <typename Setup, typename Fn>
+Result run(const std::string &name_, std::size_t n_, std::size_t ops_,
+           Setup &&setup_, Fn &&fn_, double min_seconds_ = 0.2) {
+  using clock = std::chrono::steady_clock;
+  double best{std::numeric_limits<double>::max()};
+  double total{0};
+  std::size_t reps{0};
+  auto wall_start = clock::now();
+  do {
+    auto state = setup_();
+    auto start = clock::now();
+    fn_(state);
+    clobber_memory();
+    std::chrono::duration<double> elapsed = clock::now() - start;
+    best = std::min(best, elapsed.count());
+    total += elapsed.count();
+    ++reps;
+    // Setup may dominate; do not let it stretch the run forever.
+    std::chrono::duration<double> wall = clock::now() - wall_start;
+    if (wall.count() > 20 * min_seconds_ && reps >= 3)
+      break;
+  } while ((total < min_seconds_ || reps < 3) && reps < 1000);
+  return Result{name_, n_, best * 1e9 / double(ops_ ? ops_ : 1)};
+}
+
+/// Prints `results_` as an aligned table.
+inline void print_table(std::ostream &os_, const std::vector<Result> &results_) {
+  os_ << std::left << std::setw(44) << "benchmark" << std::right
+      << std::setw(12) << "n" << std::setw(14) << "ns/op" << "\n";
+  os_ << std::string(70, '-') << "\n";
+  for (const auto &r : results_) {
+    os_ << std::left << std::setw(44) << r.name << std::right << std::setw(12)
+        << r.n << std::setw(14) << std::fixed << std::setprecision(3)
+        << r.ns_per_op << "\n";
+  }
+}
+/// Escapes `text_` to be written inside a JSON string.
+inline std::string json_escape(const std::string &text_) {
+  std::string out;
+  for (char c : text_) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out;
+}
+
+/*! Prints `results_` as JSON, in the spirit of Google Benchmark's output:
+ * a `context` object with the `context_` key/value pairs, and a
+ * `benchmarks` array with one object per result.
+ */
+inline void print_json(
+    std::ostream &os_, const std::vector<Result> &results_,
+    const std::vector<std::pair<std::string, std::string>> &context_ = {}) {
+  os_ << "{\n  \"context\": {";
+  for (std::size_t i{0}; i < context_.size(); ++i) {
+    os_ << (i ? ", " : "") << "\"" << json_escape(context_[i].first)
+        << "\": \"" << json_escape(context_[i].second) << "\"";
+  }
+  os_ << "},\n  \"benchmarks\": [";
+  for (std::size_t i{0}; i < results_.size(); ++i) {
+    const auto &r = results_[i];
+    os_ << (i ? "," : "") << "\n    {\"name\": \"" << json_escape(r.name)
+        << "\", \"n\": " << r.n << ", \"ns_per_op\": " << std::fixed
+        << std::setprecision(3) << r.ns_per_op << "}";
+  }
+  os_ << "\n  ]\n}\n";
+}
+} // namespace bench
+
+#endif
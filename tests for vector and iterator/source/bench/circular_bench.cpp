@@ -0,0 +1,145 @@
+/*!
+ * @file circular_bench.cpp
+ * @brief A sliding window of samples: sc::circular_vector against the
+ * alternatives.
+ *
+ * Each operation records one sample into a window of the last `n`; once
+ * the window is full, the oldest sample goes. The contenders are
+ * sc::circular_vector (one at a time and in chunks), std::deque with
+ * pop_front(), and a hand-written ring that wraps with `%`.
+ *
+ * Reading the window back is timed too, through the wrapping iterator and
+ * through the two segments from as_spans().
+ */
+
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "circular_vector.h"
+
+namespace {
+constexpr std::size_t samples{1 << 20}; //!< Samples recorded per operation.
+constexpr std::size_t chunk{256};       //!< Samples per bulk push_back().
+
+/// The `i_`-th sample.
+inline std::uint32_t sample(std::size_t i_) {
+  return std::uint32_t(i_ * 2654435761u);
+}
+
+/// A ring over a std::vector that wraps with a modulo.
+class ModuloRing {
+public:
+  explicit ModuloRing(std::size_t capacity_) : m_slots(capacity_) {}
+  void push_back(std::uint32_t value_) {
+    m_slots[(m_head + m_size) % m_slots.size()] = value_;
+    if (m_size < m_slots.size())
+      ++m_size;
+    else
+      m_head = (m_head + 1) % m_slots.size();
+  }
+  std::uint32_t back(void) const {
+    return m_slots[(m_head + m_size - 1) % m_slots.size()];
+  }
+
+private:
+  std::vector<std::uint32_t> m_slots;
+  std::size_t m_head{0};
+  std::size_t m_size{0};
+};
+
+bench::Result ring(std::size_t n_) {
+  return bench::run("push / sc::circular_vector", n_, samples, [n_] {
+    sc::circular_vector<std::uint32_t> window(n_);
+    for (std::size_t i{0}; i < samples; ++i)
+      window.push_back(sample(i));
+    bench::do_not_optimize(window.back());
+  });
+}
+
+bench::Result ring_bulk(std::size_t n_) {
+  std::vector<std::uint32_t> batch(chunk);
+  return bench::run("push chunks / sc::circular_vector", n_, samples,
+                    [n_, &batch] {
+                      sc::circular_vector<std::uint32_t> window(n_);
+                      for (std::size_t i{0}; i < samples; i += chunk) {
+                        for (std::size_t j{0}; j < chunk; ++j)
+                          batch[j] = sample(i + j);
+                        window.push_back(batch.data(), batch.data() + chunk);
+                      }
+                      bench::do_not_optimize(window.back());
+                    });
+}
+
+bench::Result deque(std::size_t n_) {
+  return bench::run("push / std::deque", n_, samples, [n_] {
+    std::deque<std::uint32_t> window;
+    for (std::size_t i{0}; i < samples; ++i) {
+      window.push_back(sample(i));
+      if (window.size() > n_)
+        window.pop_front();
+    }
+    bench::do_not_optimize(window.back());
+  });
+}
+
+bench::Result modulo(std::size_t n_) {
+  // One short of a power of two, as a ring sized by hand often is.
+  return bench::run("push / modulo ring", n_, samples, [n_] {
+    ModuloRing window(n_ - 1);
+    for (std::size_t i{0}; i < samples; ++i)
+      window.push_back(sample(i));
+    bench::do_not_optimize(window.back());
+  });
+}
+
+/// A full window that has wrapped around, ready to be read.
+sc::circular_vector<std::uint32_t> full_window(std::size_t n_) {
+  sc::circular_vector<std::uint32_t> window(n_);
+  for (std::size_t i{0}; i < n_ + n_ / 3; ++i)
+    window.push_back(sample(i));
+  return window;
+}
+
+bench::Result read_iterator(std::size_t n_) {
+  auto window = full_window(n_);
+  return bench::run("read iterator / sc::circular_vector", n_, n_, [&window] {
+    std::uint64_t sum{0};
+    for (std::uint32_t v : window)
+      sum += v;
+    bench::do_not_optimize(sum);
+  });
+}
+
+bench::Result read_spans(std::size_t n_) {
+  auto window = full_window(n_);
+  return bench::run("read as_spans / sc::circular_vector", n_, n_, [&window] {
+    std::uint64_t sum{0};
+    auto halves = window.as_spans();
+    for (std::uint32_t v : halves.first)
+      sum += v;
+    for (std::uint32_t v : halves.second)
+      sum += v;
+    bench::do_not_optimize(sum);
+  });
+}
+} // namespace
+
+int main(void) {
+  std::vector<bench::Result> results;
+  for (std::size_t n : {1'024ul, 65'536ul}) {
+    results.push_back(ring(n));
+    results.push_back(ring_bulk(n));
+    results.push_back(deque(n));
+    results.push_back(modulo(n));
+  }
+  for (std::size_t n : {1'024ul, 65'536ul, 1'048'576ul}) {
+    results.push_back(read_iterator(n));
+    results.push_back(read_spans(n));
+  }
+  bench::print_table(std::cout, results);
+  return 0;
+}
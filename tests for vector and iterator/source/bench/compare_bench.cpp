@@ -0,0 +1,69 @@
+/*!
+ * @file compare_bench.cpp
+ * @brief Comparing whole vectors: sc::vector against std::vector.
+ *
+ * The inputs are the worst case for a dedup pass: pairs of large vectors
+ * that are equal, or that only differ in their last element, so the
+ * whole of both has to be read. Each row compares one pair once.
+ *
+ * Usage: compare_bench [elements, default 2^22]
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+/// Times `==` and `<` on two copies of `values_`, the second one with its
+/// last element replaced by `last_`.
+template <typename Vec, typename T>
+void measure(const std::string &name_, const std::vector<T> &values_, T last_,
+             std::vector<bench::Result> &results_) {
+  Vec lhs(values_.begin(), values_.end());
+  Vec rhs(values_.begin(), values_.end());
+  std::size_t n = values_.size();
+  results_.push_back(bench::run("== (equal) / " + name_, n, n, [&] {
+    bench::do_not_optimize(lhs == rhs);
+  }));
+  rhs[n - 1] = last_;
+  results_.push_back(bench::run("== (last differs) / " + name_, n, n, [&] {
+    bench::do_not_optimize(lhs == rhs);
+  }));
+  results_.push_back(bench::run("< (last differs) / " + name_, n, n, [&] {
+    bench::do_not_optimize(lhs < rhs);
+  }));
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 22;
+
+  std::vector<std::int32_t> ints(n);
+  std::vector<std::uint8_t> bytes(n);
+  std::vector<double> doubles(n);
+  std::vector<std::string> words(n / 64);
+  for (std::size_t i{0}; i < n; ++i) {
+    ints[i] = std::int32_t(i);
+    bytes[i] = std::uint8_t(i);
+    doubles[i] = double(i);
+  }
+  for (std::size_t i{0}; i < words.size(); ++i)
+    words[i] = "word number " + std::to_string(i);
+
+  std::vector<bench::Result> results;
+  measure<sc::vector<std::int32_t>>("sc::vector<int32_t>", ints, -1, results);
+  measure<std::vector<std::int32_t>>("std::vector<int32_t>", ints, -1, results);
+  measure<sc::vector<std::uint8_t>>("sc::vector<uint8_t>", bytes, std::uint8_t(0xff), results);
+  measure<std::vector<std::uint8_t>>("std::vector<uint8_t>", bytes, std::uint8_t(0xff), results);
+  measure<sc::vector<double>>("sc::vector<double>", doubles, -1.0, results);
+  measure<std::vector<double>>("std::vector<double>", doubles, -1.0, results);
+  measure<sc::vector<std::string>>("sc::vector<string>", words, std::string("~"), results);
+  measure<std::vector<std::string>>("std::vector<string>", words, std::string("~"), results);
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*!
+ * @file concurrent_bench.cpp
+ * @brief Filling one vector from many threads.
+ *
+ * Every run appends the same total number of ints, split evenly across
+ * 1, 2, 4... threads, into a fresh container:
+ * - sc::concurrent_vector, one push_back() per element;
+ * - sc::concurrent_vector, grow_by() blocks of 256 filled in place;
+ * - sc::vector behind a std::mutex, locked for every push_back().
+ * A container that scales keeps the time per element falling as threads
+ * are added.
+ *
+ * Usage: concurrent_bench [max threads, default hardware concurrency]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.h"
+#include "concurrent_vector.h"
+#include "vector.h"
+
+namespace {
+constexpr std::size_t total{1 << 23}; //!< Elements appended per run.
+constexpr std::size_t block{256};     //!< Elements per grow_by().
+
+/// Runs `work_(t)` on threads 0..`threads_`-1 and waits for them.
+template <typename Work> void on_threads(std::size_t threads_, Work work_) {
+  std::vector<std::thread> pool;
+  for (std::size_t t{0}; t < threads_; ++t)
+    pool.emplace_back(work_, t);
+  for (auto &thread : pool)
+    thread.join();
+}
+
+bench::Result push_back(std::size_t threads_) {
+  return bench::run("push_back / sc::concurrent_vector", threads_, total,
+                    [threads_] {
+                      sc::concurrent_vector<int> vec;
+                      on_threads(threads_, [&vec, threads_](std::size_t t) {
+                        for (std::size_t i{t}; i < total; i += threads_)
+                          vec.push_back(int(i));
+                      });
+                      bench::do_not_optimize(vec[0]);
+                    });
+}
+
+bench::Result grow_by(std::size_t threads_) {
+  return bench::run("grow_by / sc::concurrent_vector", threads_, total,
+                    [threads_] {
+                      sc::concurrent_vector<int> vec;
+                      on_threads(threads_, [&vec, threads_](std::size_t t) {
+                        for (std::size_t i{t * block}; i < total;
+                             i += threads_ * block) {
+                          auto it = vec.grow_by(block);
+                          for (std::size_t j{0}; j < block; ++j)
+                            it[j] = int(i + j);
+                        }
+                      });
+                      bench::do_not_optimize(vec[0]);
+                    });
+}
+
+bench::Result mutex(std::size_t threads_) {
+  return bench::run("push_back / mutex + sc::vector", threads_, total,
+                    [threads_] {
+                      sc::vector<int> vec;
+                      std::mutex lock;
+                      on_threads(threads_, [&vec, &lock, threads_](std::size_t t) {
+                        for (std::size_t i{t}; i < total; i += threads_) {
+                          std::lock_guard<std::mutex> guard{lock};
+                          vec.push_back(int(i));
+                        }
+                      });
+                      bench::do_not_optimize(vec.data());
+                    });
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t max_threads = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                       : std::thread::hardware_concurrency();
+  if (max_threads == 0)
+    max_threads = 1;
+
+  // The "n" column is the number of threads.
+  std::vector<bench::Result> results;
+  for (std::size_t threads{1}; threads <= max_threads; threads *= 2) {
+    results.push_back(push_back(threads));
+    results.push_back(grow_by(threads));
+    results.push_back(mutex(threads));
+  }
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*!
+ * @file front_bench.cpp
+ * @brief push_front()/pop_front() on sc::vector against std::deque.
+ *
+ * sc::vector keeps spare room before its first element, so both ends grow
+ * in amortized O(1). The baseline without that room is `insert(begin())`
+ * on std::vector, which shifts every element on each call.
+ */
+
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+/// Builds a container with `n_` push_front()s.
+template <typename Vec> void fill_front(std::size_t n_) {
+  Vec vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_front(int(i));
+  bench::do_not_optimize(vec.back());
+}
+
+/// The same with `insert(begin())`, for std::vector.
+void fill_shift(std::size_t n_) {
+  std::vector<int> vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.insert(vec.begin(), int(i));
+  bench::do_not_optimize(vec.back());
+}
+
+/// A FIFO of `n_` ints: push_back() one, pop_front() one, `n_` times over.
+template <typename Vec> bench::Result queue(const std::string &name_, std::size_t n_) {
+  return bench::run(
+      name_, n_, n_,
+      [n_] {
+        Vec vec;
+        for (std::size_t i{0}; i < n_; ++i)
+          vec.push_back(int(i));
+        return vec;
+      },
+      [n_](Vec &vec) {
+        for (std::size_t i{0}; i < n_; ++i) {
+          vec.push_back(int(i));
+          vec.pop_front();
+        }
+        bench::do_not_optimize(vec.front());
+      });
+}
+
+/// Sums every element, to show what the deque's blocks cost on reads.
+template <typename Vec> bench::Result scan(const std::string &name_, std::size_t n_) {
+  Vec vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_front(int(i));
+  return bench::run(name_, n_, n_, [&vec] {
+    long sum{0};
+    for (int v : vec)
+      sum += v;
+    bench::do_not_optimize(sum);
+  });
+}
+} // namespace
+
+int main(void) {
+  std::vector<bench::Result> results;
+  for (std::size_t n : {100ul, 10'000ul, 1'000'000ul}) {
+    results.push_back(bench::run("push_front / sc::vector", n, n,
+                                 [n] { fill_front<sc::vector<int>>(n); }));
+    results.push_back(bench::run("push_front / std::deque", n, n,
+                                 [n] { fill_front<std::deque<int>>(n); }));
+    // Quadratic: stop before it takes minutes.
+    if (n <= 10'000)
+      results.push_back(bench::run("insert(begin) / std::vector", n, n,
+                                   [n] { fill_shift(n); }));
+  }
+  for (std::size_t n : {100ul, 10'000ul, 1'000'000ul}) {
+    results.push_back(queue<sc::vector<int>>("queue / sc::vector", n));
+    results.push_back(queue<std::deque<int>>("queue / std::deque", n));
+  }
+  for (std::size_t n : {100ul, 10'000ul, 1'000'000ul}) {
+    results.push_back(scan<sc::vector<int>>("scan / sc::vector", n));
+    results.push_back(scan<std::deque<int>>("scan / std::deque", n));
+  }
+  bench::print_table(std::cout, results);
+  return 0;
+}
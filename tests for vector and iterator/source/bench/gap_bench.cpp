@@ -0,0 +1,103 @@
+/*!
+ * @file gap_bench.cpp
+ * @brief Replays a cursor-edit trace on sc::gap_vector and sc::vector.
+ *
+ * The trace is what an editor sends: the cursor mostly stays put or moves
+ * a few positions, sometimes jumps elsewhere, and at each stop a burst of
+ * characters is typed or deleted. sc::vector shifts the whole tail on
+ * every edit; sc::gap_vector only shifts when the cursor moves.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "gap_vector.h"
+#include "vector.h"
+
+namespace {
+constexpr std::size_t edits{20'000}; //!< Edits in the trace.
+
+/// One edit: insert `ch` before `pos`, or erase the element before it.
+struct Edit {
+  std::uint32_t pos; //!< Cursor position when the edit happens.
+  char ch;           //!< Character typed, or 0 for a backspace.
+};
+
+/// A trace over a document of `n_` characters.
+std::vector<Edit> make_trace(std::size_t n_) {
+  std::mt19937 gen{11};
+  std::vector<Edit> trace;
+  trace.reserve(edits);
+  std::size_t size{n_};
+  std::size_t cursor{n_ / 2};
+  while (trace.size() < edits) {
+    // Where the next burst happens.
+    if (gen() % 16 == 0) {
+      cursor = gen() % (size + 1);
+    } else {
+      std::size_t step = gen() % 32;
+      cursor = (gen() % 2 == 0) ? std::min(size, cursor + step)
+                                : cursor - std::min(cursor, step);
+    }
+    bool typing = gen() % 4 != 0;
+    for (std::size_t burst = 1 + gen() % 16; burst > 0 && trace.size() < edits;
+         --burst) {
+      if (typing) {
+        trace.push_back({std::uint32_t(cursor), char('a' + gen() % 26)});
+        ++cursor;
+        ++size;
+      } else if (cursor > 0) {
+        trace.push_back({std::uint32_t(cursor), 0});
+        --cursor;
+        --size;
+      }
+    }
+  }
+  return trace;
+}
+
+/// Applies the trace to a document of `n_` characters.
+template <typename Vec>
+bench::Result replay(const std::string &name_, std::size_t n_) {
+  const std::vector<Edit> trace = make_trace(n_);
+  return bench::run(
+      name_, n_, edits,
+      [n_] {
+        Vec text;
+        text.reserve(n_ + edits);
+        for (std::size_t i{0}; i < n_; ++i)
+          text.push_back(char('a' + i % 26));
+        return text;
+      },
+      [&trace](Vec &text) {
+        for (const Edit &edit : trace) {
+          if (edit.ch != 0)
+            text.insert(text.begin() + edit.pos, edit.ch);
+          else
+            text.erase(text.begin() + (edit.pos - 1));
+        }
+        bench::do_not_optimize(text[0]);
+      });
+}
+} // namespace
+
+int main(void) {
+  std::vector<bench::Result> results;
+  for (std::size_t n : {1'000ul, 100'000ul, 10'000'000ul}) {
+    results.push_back(replay<sc::gap_vector<char>>("edit trace / sc::gap_vector", n));
+    results.push_back(replay<sc::vector<char>>("edit trace / sc::vector", n));
+  }
+  bench::print_table(std::cout, results);
+
+  // Results come in (gap_vector, vector) pairs.
+  std::cout << "\nsc::vector time relative to sc::gap_vector:\n";
+  for (std::size_t i{0}; i + 1 < results.size(); i += 2) {
+    std::cout << "  n=" << results[i].n << ": "
+              << results[i + 1].ns_per_op / results[i].ns_per_op << "x\n";
+  }
+  return 0;
+}
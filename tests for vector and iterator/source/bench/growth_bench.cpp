@@ -0,0 +1,93 @@
+/*!
+ * @file growth_bench.cpp
+ * @brief Peak memory vs push_back throughput for each growth policy.
+ *
+ * Each policy runs in a child process of its own, so the kernel can report
+ * that child's peak resident set size (`ru_maxrss`) in isolation.
+ *
+ * Usage: growth_bench [element count, default 50'000'000]
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+/// What a child sends back to the parent.
+struct Report {
+  double seconds;          //!< Time spent pushing.
+  std::size_t capacity;    //!< Capacity at the end.
+};
+
+/// Pushes `n_` elements into an empty vector using `Policy`.
+template <typename Policy> Report fill(std::size_t n_) {
+  auto start = std::chrono::steady_clock::now();
+  sc::vector<int, std::allocator<int>, Policy> vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(int(i));
+  bench::do_not_optimize(vec.data());
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return Report{elapsed.count(), vec.capacity()};
+}
+
+/// Runs `fill<Policy>` in a child and prints one table row.
+template <typename Policy> void measure(const std::string &name_, std::size_t n_) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    std::perror("pipe");
+    std::exit(1);
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    Report report = fill<Policy>(n_);
+    ssize_t written = write(fds[1], &report, sizeof(report));
+    _exit(written == sizeof(report) ? 0 : 1);
+  }
+  close(fds[1]);
+  Report report{};
+  ssize_t got = read(fds[0], &report, sizeof(report));
+  close(fds[0]);
+  int status{0};
+  struct rusage usage {};
+  wait4(pid, &status, 0, &usage);
+  if (got != sizeof(report) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    std::cout << std::left << std::setw(24) << name_ << "child failed\n";
+    return;
+  }
+  double payload_mb = double(n_ * sizeof(int)) / (1 << 20);
+  double capacity_mb = double(report.capacity * sizeof(int)) / (1 << 20);
+  double peak_mb = double(usage.ru_maxrss) / 1024; // ru_maxrss is in KiB.
+  std::cout << std::left << std::setw(24) << name_ << std::right << std::fixed
+            << std::setprecision(1) << std::setw(12)
+            << n_ / report.seconds / 1e6 << std::setw(12) << payload_mb
+            << std::setw(12) << capacity_mb << std::setw(12) << peak_mb
+            << std::setw(10) << std::setprecision(2) << peak_mb / payload_mb
+            << "\n";
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+
+  std::cout << "push_back of " << n << " ints, one child process per policy\n";
+  std::cout << std::left << std::setw(24) << "policy" << std::right
+            << std::setw(12) << "Mpush/s" << std::setw(12) << "data MiB"
+            << std::setw(12) << "cap MiB" << std::setw(12) << "peak MiB"
+            << std::setw(10) << "peak/data" << "\n";
+  std::cout << std::string(82, '-') << "\n";
+  measure<sc::growth::doubling>("doubling (2x)", n);
+  measure<sc::growth::golden>("golden (1.5x)", n);
+  measure<sc::growth::size_class>("size_class (1.5x+)", n);
+  measure<sc::growth::fixed_step<1 << 20>>("fixed_step<1M>", n);
+  return 0;
+}
@@ -0,0 +1,127 @@
+/*!
+ * @file huge_page_bench.cpp
+ * @brief Random gathers over a large vector, with and without huge pages.
+ *
+ * The same table of 64-bit values lives in a `sc::vector` (malloc, small
+ * pages), a `sc::aligned_vector` (64-byte aligned, small pages) and a
+ * `sc::huge_page_vector` (2 MiB pages when the kernel has them). "gather"
+ * sums elements at random positions, which is bound by TLB misses once
+ * the table is far larger than what the TLB covers; "chase" hashes each
+ * value read into the next position, one dependent load after the other,
+ * so every page walk is paid in full. Times are per element read. The
+ * share of the table on huge pages comes from /proc/self/smaps.
+ *
+ * Usage: huge_page_bench [elements, default 2^27] [reads, default 2^22]
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "aligned_allocator.h"
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+/// A cheap random sequence, so no index array competes for the TLB.
+struct xorshift {
+  std::uint64_t state{0x9E3779B97F4A7C15ull};
+  std::uint64_t operator()(void) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+/// Maps the 64-bit `value_` to a position in [0, `n_`).
+std::size_t below(std::uint64_t value_, std::size_t n_) {
+  return std::size_t((unsigned __int128)value_ * n_ >> 64);
+}
+
+/// Fraction of the mapping at `ptr_` that /proc/self/smaps reports on
+/// transparent or reserved huge pages.
+double huge_share(const void *ptr_) {
+  std::ifstream smaps{"/proc/self/smaps"};
+  auto address = reinterpret_cast<std::uintptr_t>(ptr_);
+  bool inside{false};
+  double size{0}, huge{0};
+  for (std::string line; std::getline(smaps, line);) {
+    std::uintptr_t from{0}, to{0};
+    char dash{0};
+    std::istringstream fields{line};
+    if (fields >> std::hex >> from >> dash >> to && dash == '-') {
+      inside = from <= address && address < to;
+      continue;
+    }
+    if (!inside) {
+      continue;
+    }
+    std::string key;
+    double kib{0};
+    fields.clear();
+    fields.str(line);
+    fields >> std::dec >> key >> kib;
+    if (key == "Size:") {
+      size = kib;
+    } else if (key == "AnonHugePages:" || key == "Private_Hugetlb:") {
+      huge += kib;
+    }
+  }
+  return size > 0 ? huge / size : 0;
+}
+
+/// Fills `vec_` with 0, 1, ..., `n_` - 1.
+template <typename Vec> void fill(Vec &vec_, std::size_t n_) {
+  vec_.reserve(n_);
+  for (std::size_t i{0}; i < n_; ++i) {
+    vec_.push_back(i);
+  }
+}
+
+template <typename Vec>
+void measure(std::vector<bench::Result> &results_, const std::string &name_,
+             std::size_t n_, std::size_t reads_) {
+  Vec vec;
+  fill(vec, n_);
+  std::cout << name_ << ": " << int(huge_share(vec.data()) * 100)
+            << "% on huge pages\n";
+  results_.push_back(bench::run("gather / " + name_, n_, reads_, [&] {
+    xorshift random;
+    std::uint64_t total{0};
+    for (std::size_t i{0}; i < reads_; ++i) {
+      total += vec[below(random(), n_)];
+    }
+    bench::do_not_optimize(total);
+  }));
+  results_.push_back(bench::run("chase / " + name_, n_, reads_, [&] {
+    // Hashing (rather than storing the next position) avoids the short
+    // cycles of a random successor function, which would stay in cache.
+    std::uint64_t at{0};
+    for (std::size_t i{0}; i < reads_; ++i) {
+      at = below((vec[at] + i) * 0x9E3779B97F4A7C15ull, n_);
+    }
+    bench::do_not_optimize(at);
+  }));
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 27;
+  std::size_t reads =
+      (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1 << 22;
+
+  std::vector<bench::Result> results;
+  measure<sc::vector<std::uint64_t>>(results, "sc::vector", n, reads);
+  measure<sc::aligned_vector<std::uint64_t>>(results, "sc::aligned_vector", n,
+                                             reads);
+  measure<sc::huge_page_vector<std::uint64_t>>(results, "sc::huge_page_vector",
+                                               n, reads);
+
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,106 @@
+/*!
+ * @file io_bench.cpp
+ * @brief Ingesting a file into a growing byte vector, chunk by chunk.
+ *
+ * Every row reads the same file, cached by the kernel, to its end, in
+ * 1 MiB read() calls appended to a single vector. The std::vector row
+ * grows with resize(), which zeroes each chunk before read() overwrites
+ * it; the sc::vector row does the same with value-initialized elements;
+ * sc::read_append reads straight into the spare capacity. Times are per
+ * byte; the summary turns them into GB/s.
+ *
+ * Usage: io_bench [file size in MiB, default 256] [directory, default /tmp]
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "io.h"
+#include "vector.h"
+
+namespace {
+constexpr std::size_t chunk = 1 << 20;
+
+/// Creates a file of `bytes_` bytes at `path_`.
+void make_file(const std::string &path_, std::size_t bytes_) {
+  std::vector<char> block(chunk);
+  for (std::size_t i{0}; i < chunk; ++i) {
+    block[i] = char(i * 31);
+  }
+  std::FILE *file = std::fopen(path_.c_str(), "wb");
+  for (std::size_t done{0}; done < bytes_; done += chunk) {
+    std::fwrite(block.data(), 1, std::min(chunk, bytes_ - done), file);
+  }
+  std::fclose(file);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t mib = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 256;
+  std::string dir = (argc > 2) ? argv[2] : "/tmp";
+  std::string path = dir + "/io_bench.data";
+  std::size_t bytes = mib << 20;
+  make_file(path, bytes);
+
+  std::vector<bench::Result> results;
+  results.push_back(bench::run("std::vector, resize + read", bytes, bytes, [&] {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    std::vector<char> data;
+    for (;;) {
+      std::size_t old_size = data.size();
+      data.resize(old_size + chunk);
+      ssize_t got = ::read(fd, data.data() + old_size, chunk);
+      data.resize(old_size + std::size_t(got > 0 ? got : 0));
+      if (got <= 0)
+        break;
+    }
+    ::close(fd);
+    bench::do_not_optimize(data.data());
+  }));
+  results.push_back(bench::run("sc::vector, zeroed chunk + read", bytes, bytes, [&] {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    sc::vector<char> data;
+    for (;;) {
+      std::size_t old_size = data.size();
+      char *dst = data.append_uninitialized(chunk);
+      std::fill(dst, dst + chunk, 0);
+      ssize_t got = ::read(fd, dst, chunk);
+      data.resize_for_overwrite(old_size + std::size_t(got > 0 ? got : 0));
+      if (got <= 0)
+        break;
+    }
+    ::close(fd);
+    bench::do_not_optimize(data.data());
+  }));
+  results.push_back(bench::run("sc::read_append", bytes, bytes, [&] {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    sc::vector<char> data;
+    while (sc::read_append(fd, data, chunk) > 0) {
+    }
+    ::close(fd);
+    bench::do_not_optimize(data.data());
+  }));
+  results.push_back(bench::run("sc::read_append, reserved", bytes, bytes, [&] {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    sc::vector<char> data;
+    data.reserve(bytes + chunk);
+    while (sc::read_append(fd, data, chunk) > 0) {
+    }
+    ::close(fd);
+    bench::do_not_optimize(data.data());
+  }));
+  bench::print_table(std::cout, results);
+
+  std::cout << "\nThroughput, GB/s:\n";
+  for (const auto &r : results)
+    std::cout << "  " << r.name << ": " << 1.0 / r.ns_per_op << "\n";
+  std::remove(path.c_str());
+  return 0;
+}
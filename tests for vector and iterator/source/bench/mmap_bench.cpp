@@ -0,0 +1,101 @@
+/*!
+ * @file mmap_bench.cpp
+ * @brief sc::mmap_vector against loading a file into sc::vector.
+ *
+ * The data set is a file of 16-byte records. "build" appends every record
+ * and ends with the file on disk: for sc::vector that means a final
+ * write(). "open" gets the records ready to be used: sc::vector reads the
+ * whole file, sc::mmap_vector only maps it. "scan" then reads every
+ * record once, which is where a mapping pays for its page faults. Times
+ * are per record.
+ *
+ * Usage: mmap_bench [records, default 2^22] [directory, default /tmp]
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "mmap_vector.h"
+#include "vector.h"
+
+namespace {
+struct record {
+  std::uint64_t id;
+  double value;
+};
+
+/// Sums one field of every record.
+template <typename Vec> double scan(const Vec &vec_) {
+  double total{0};
+  for (std::size_t i{0}; i < vec_.size(); ++i) {
+    total += vec_[i].value;
+  }
+  return total;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 22;
+  std::string dir = (argc > 2) ? argv[2] : "/tmp";
+  std::string path = dir + "/mmap_bench.data";
+
+  std::vector<bench::Result> results;
+  results.push_back(bench::run("build / sc::vector + fwrite", n, n, [&] {
+    sc::vector<record> vec;
+    for (std::uint64_t i{0}; i < n; ++i) {
+      vec.push_back(record{i, double(i)});
+    }
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    std::fwrite(vec.data(), sizeof(record), vec.size(), file);
+    std::fclose(file);
+  }));
+  results.push_back(bench::run("build / sc::mmap_vector", n, n, [&] {
+    sc::mmap_vector<record> vec{path, sc::open_mode::truncate};
+    for (std::uint64_t i{0}; i < n; ++i) {
+      vec.push_back(record{i, double(i)});
+    }
+  }));
+
+  results.push_back(bench::run("open / sc::vector + fread", n, n, [&] {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    sc::vector<record> vec(n);
+    std::size_t read = std::fread(vec.data(), sizeof(record), n, file);
+    std::fclose(file);
+    bench::do_not_optimize(read);
+    bench::do_not_optimize(vec.data());
+  }));
+  results.push_back(bench::run("open / sc::mmap_vector", n, n, [&] {
+    sc::mmap_vector<record> vec{path, sc::open_mode::read_only};
+    bench::do_not_optimize(vec.data());
+  }));
+
+  {
+    sc::vector<record> loaded(n);
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    std::size_t read = std::fread(loaded.data(), sizeof(record), n, file);
+    std::fclose(file);
+    bench::do_not_optimize(read);
+    results.push_back(bench::run("scan / sc::vector", n, n, [&] {
+      bench::do_not_optimize(scan(loaded));
+    }));
+  }
+  results.push_back(bench::run("open + scan / sc::mmap_vector", n, n, [&] {
+    sc::mmap_vector<record> vec{path, sc::open_mode::read_only};
+    bench::do_not_optimize(scan(vec));
+  }));
+  results.push_back(
+      bench::run("open + scan / sc::mmap_vector, sequential", n, n, [&] {
+        sc::mmap_vector<record> vec{path, sc::open_mode::read_only};
+        vec.advise(sc::access_hint::sequential);
+        bench::do_not_optimize(scan(vec));
+      }));
+
+  bench::print_table(std::cout, results);
+  std::remove(path.c_str());
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*!
+ * @file parallel_bench.cpp
+ * @brief How sc::parallel algorithms scale with the number of threads.
+ *
+ * Every algorithm runs over the same sc::vector<double> on pools of 1, 2,
+ * 4... threads, with the default grain. The sequential std algorithm is
+ * measured first, as the "0 threads" row. An algorithm that scales keeps
+ * the time per element falling as threads are added, until memory
+ * bandwidth runs out.
+ *
+ * Usage: parallel_bench [max threads, default hardware concurrency]
+ *                       [elements, default 2^23]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.h"
+#include "parallel.h"
+#include "vector.h"
+
+namespace {
+/// Runs every algorithm on `pool_`, or sequentially with `pool_` null.
+void measure(sc::parallel::thread_pool *pool_, std::size_t threads_,
+             sc::vector<double> &in_, sc::vector<double> &out_,
+             std::vector<bench::Result> &results_) {
+  std::size_t n = in_.size();
+  auto first = in_.begin();
+  auto last = in_.end();
+  const std::string tag = pool_ ? " / sc::parallel" : " / std";
+
+  results_.push_back(bench::run("for_each" + tag, threads_, n, [&] {
+    auto scale = [](double &x) { x *= 1.0000001; };
+    if (pool_)
+      sc::parallel::for_each(*pool_, first, last, scale);
+    else
+      std::for_each(first, last, scale);
+    bench::do_not_optimize(in_[0]);
+  }));
+  results_.push_back(bench::run("transform" + tag, threads_, n, [&] {
+    auto root = [](double x) { return std::sqrt(x); };
+    if (pool_)
+      sc::parallel::transform(*pool_, first, last, out_.begin(), root);
+    else
+      std::transform(first, last, out_.begin(), root);
+    bench::do_not_optimize(out_[0]);
+  }));
+  results_.push_back(bench::run("reduce" + tag, threads_, n, [&] {
+    double sum = pool_ ? sc::parallel::reduce(*pool_, first, last, 0.0)
+                       : std::accumulate(first, last, 0.0);
+    bench::do_not_optimize(sum);
+  }));
+  results_.push_back(bench::run("transform_reduce" + tag, threads_, n, [&] {
+    double dot = pool_ ? sc::parallel::transform_reduce(*pool_, first, last,
+                                                        out_.begin(), 0.0)
+                       : std::inner_product(first, last, out_.begin(), 0.0);
+    bench::do_not_optimize(dot);
+  }));
+  results_.push_back(bench::run("inclusive_scan" + tag, threads_, n, [&] {
+    if (pool_)
+      sc::parallel::inclusive_scan(*pool_, first, last, out_.begin());
+    else
+      std::inclusive_scan(first, last, out_.begin());
+    bench::do_not_optimize(out_[0]);
+  }));
+  results_.push_back(bench::run("count_if" + tag, threads_, n, [&] {
+    auto big = [](double x) { return x > 0.5; };
+    long count = pool_ ? sc::parallel::count_if(*pool_, first, last, big)
+                       : std::count_if(first, last, big);
+    bench::do_not_optimize(count);
+  }));
+  results_.push_back(bench::run("find_if (no match)" + tag, threads_, n, [&] {
+    auto negative = [](double x) { return x < 0; };
+    auto it = pool_ ? sc::parallel::find_if(*pool_, first, last, negative)
+                    : std::find_if(first, last, negative);
+    bench::do_not_optimize(it);
+  }));
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t max_threads = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                       : std::thread::hardware_concurrency();
+  std::size_t n = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1 << 23;
+  if (max_threads == 0)
+    max_threads = 1;
+
+  sc::vector<double> in(n);
+  sc::vector<double> out(n);
+  for (std::size_t i{0}; i < n; ++i)
+    in[i] = double(i % 1000) / 1000.0;
+
+  // The "n" column is the number of threads.
+  std::vector<bench::Result> results;
+  measure(nullptr, 0, in, out, results);
+  for (std::size_t threads{1}; threads <= max_threads; threads *= 2) {
+    sc::parallel::thread_pool pool{threads};
+    measure(&pool, threads, in, out, results);
+  }
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*!
+ * @file radix_sort_bench.cpp
+ * @brief sc::sort and sc::parallel::sort against std::sort.
+ *
+ * Every key type is sorted on three input shapes: uniform random keys,
+ * already sorted keys and keys with only 16 distinct values. The last
+ * rows sort 8-byte key/value records by key. Each run sorts a fresh copy
+ * of the input, reserved to twice its size so the radix sorts can use
+ * the spare capacity as scratch.
+ *
+ * Usage: radix_sort_bench [elements, default 2^22]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "sort.h"
+#include "vector.h"
+
+namespace {
+/// A key/value record.
+struct Record {
+  std::uint32_t key;   //!< Sort key.
+  std::uint32_t value; //!< Payload.
+};
+
+enum class shape { uniform, sorted, duplicates };
+
+/// `n_` keys of the given shape.
+template <typename T> sc::vector<T> keys(std::size_t n_, shape shape_) {
+  std::mt19937_64 gen{42};
+  sc::vector<T> vec;
+  vec.reserve(2 * n_);
+  for (std::size_t i{0}; i < n_; ++i) {
+    std::uint64_t bits = gen();
+    if (shape_ == shape::duplicates)
+      bits %= 16;
+    if constexpr (std::is_floating_point<T>::value)
+      vec.push_back(T(double(bits >> 11) * 0x1p-53 - 0.5));
+    else
+      vec.push_back(T(bits));
+  }
+  if (shape_ == shape::sorted)
+    std::sort(vec.begin(), vec.end());
+  return vec;
+}
+
+/// Measures `sort_` on fresh copies of `input_`.
+template <typename T, typename Sort>
+bench::Result measure(const std::string &name_, const sc::vector<T> &input_,
+                      Sort sort_) {
+  std::size_t n = input_.size();
+  return bench::run(
+      name_, n, n,
+      [&input_] {
+        sc::vector<T> copy;
+        copy.reserve(2 * input_.size());
+        for (const auto &x : input_)
+          copy.push_back(x);
+        return copy;
+      },
+      [&sort_](sc::vector<T> &vec) {
+        sort_(vec);
+        bench::do_not_optimize(vec.data());
+      });
+}
+
+template <typename T>
+void compare(const std::string &type_, std::size_t n_,
+             std::vector<bench::Result> &results_) {
+  const char *names[] = {"uniform", "sorted", "duplicates"};
+  for (shape s : {shape::uniform, shape::sorted, shape::duplicates}) {
+    auto input = keys<T>(n_, s);
+    std::string suffix = " / " + type_ + " " + names[int(s)];
+    results_.push_back(measure("std::sort" + suffix, input, [](sc::vector<T> &v) {
+      std::sort(v.begin(), v.end());
+    }));
+    results_.push_back(measure("sc::sort" + suffix, input,
+                               [](sc::vector<T> &v) { sc::sort(v); }));
+    results_.push_back(measure("sc::parallel::sort" + suffix, input,
+                               [](sc::vector<T> &v) { sc::parallel::sort(v); }));
+  }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 22;
+
+  std::vector<bench::Result> results;
+  compare<std::uint32_t>("uint32", n, results);
+  compare<std::uint64_t>("uint64", n, results);
+  compare<float>("float", n, results);
+
+  sc::vector<Record> records;
+  std::mt19937 gen{7};
+  for (std::uint32_t i{0}; i < n; ++i)
+    records.push_back(Record{std::uint32_t(gen()), i});
+  auto by_key = [](const Record &a, const Record &b) { return a.key < b.key; };
+  results.push_back(measure("std::sort / records", records,
+                            [&by_key](sc::vector<Record> &v) {
+                              std::sort(v.begin(), v.end(), by_key);
+                            }));
+  results.push_back(measure("std::stable_sort / records", records,
+                            [&by_key](sc::vector<Record> &v) {
+                              std::stable_sort(v.begin(), v.end(), by_key);
+                            }));
+  results.push_back(measure("sc::sort (pdqsort) / records", records,
+                            [&by_key](sc::vector<Record> &v) { sc::sort(v, by_key); }));
+  results.push_back(measure("sc::sort_by_key / records", records,
+                            [](sc::vector<Record> &v) {
+                              sc::sort_by_key(v, [](const Record &r) { return r.key; });
+                            }));
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*!
+ * @file relocation_bench.cpp
+ * @brief Measures the memcpy/memmove/realloc path for relocatable elements.
+ *
+ * Each operation runs twice: once over a plain arithmetic `T`, which takes
+ * the fast path, and once over `Boxed<T>`, a wrapper with the same layout
+ * but user-provided copy/move constructors. The wrapper forces the
+ * element-by-element loops, which is how every type used to be handled.
+ */
+
+#include <iostream>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+/// Same bytes as `T`, but not trivially copyable.
+template <typename T> struct Boxed {
+  T value;
+  Boxed(T v) : value{v} {}
+  Boxed(const Boxed &other) : value{other.value} {}
+  Boxed(Boxed &&other) noexcept : value{other.value} {}
+  Boxed &operator=(const Boxed &other) {
+    value = other.value;
+    return *this;
+  }
+  Boxed &operator=(Boxed &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+};
+
+/// `n_` push_back()s into an empty vector, paying for every reallocation.
+template <typename E>
+bench::Result push_back_growth(const std::string &name_, std::size_t n_) {
+  return bench::run(name_, n_, n_, [n_] {
+    sc::vector<E> vec;
+    for (std::size_t i{0}; i < n_; ++i)
+      vec.push_back(E(i));
+    bench::do_not_optimize(vec.data());
+  });
+}
+
+/// A vector holding `0..n_-1`, with room for `extra_` more elements.
+template <typename E> sc::vector<E> make_filled(std::size_t n_, std::size_t extra_) {
+  sc::vector<E> vec;
+  vec.reserve(n_ + extra_);
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(E(i));
+  return vec;
+}
+
+/// `reps` inserts of a 16-element range at the middle of an `n_` vector.
+template <typename E>
+bench::Result middle_insert(const std::string &name_, std::size_t n_) {
+  constexpr std::size_t reps{64};
+  sc::vector<E> src = make_filled<E>(16, 0);
+  return bench::run(
+      name_, n_, reps, [n_] { return make_filled<E>(n_, reps * 16); },
+      [&src](sc::vector<E> &vec) {
+        for (std::size_t r{0}; r < reps; ++r)
+          vec.insert(vec.begin() + vec.size() / 2, src.begin(), src.end());
+        bench::do_not_optimize(vec.data());
+      });
+}
+
+/// `reps` erases at the front of an `n_` vector.
+template <typename E>
+bench::Result front_erase(const std::string &name_, std::size_t n_) {
+  constexpr std::size_t reps{64};
+  return bench::run(
+      name_, n_, reps, [n_] { return make_filled<E>(n_, 0); },
+      [](sc::vector<E> &vec) {
+        for (std::size_t r{0}; r < reps; ++r)
+          vec.erase(vec.begin());
+        bench::do_not_optimize(vec.data());
+      });
+}
+
+template <typename T>
+void run_suite(const std::string &type_, std::vector<bench::Result> &out_) {
+  for (std::size_t n : {1'000ul, 100'000ul, 10'000'000ul}) {
+    out_.push_back(push_back_growth<T>("push_back<" + type_ + ">", n));
+    out_.push_back(push_back_growth<Boxed<T>>("push_back<Boxed<" + type_ + ">>", n));
+  }
+  for (std::size_t n : {1'000ul, 100'000ul, 1'000'000ul}) {
+    out_.push_back(middle_insert<T>("insert_middle<" + type_ + ">", n));
+    out_.push_back(middle_insert<Boxed<T>>("insert_middle<Boxed<" + type_ + ">>", n));
+    out_.push_back(front_erase<T>("erase_front<" + type_ + ">", n));
+    out_.push_back(front_erase<Boxed<T>>("erase_front<Boxed<" + type_ + ">>", n));
+  }
+}
+} // namespace
+
+int main(void) {
+  std::vector<bench::Result> results;
+  run_suite<int>("int", results);
+  run_suite<double>("double", results);
+  bench::print_table(std::cout, results);
+
+  // Results come in (fast path, loop) pairs.
+  std::cout << "\nspeedup of the relocation fast path over the element loop:\n";
+  for (std::size_t i{0}; i + 1 < results.size(); i += 2) {
+    std::cout << "  " << results[i].name << " n=" << results[i].n << ": "
+              << results[i + 1].ns_per_op / results[i].ns_per_op << "x\n";
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*!
+ * @file segmented_bench.cpp
+ * @brief sc::segmented_vector against sc::vector and std::vector.
+ *
+ * The first table fills each container with push_back(), in a child
+ * process of its own (see growth_bench.cpp), and reports the throughput,
+ * the slowest single push_back() and the peak resident set size; a vector
+ * stalls and briefly needs old and new buffers when it grows, a segmented
+ * vector only adds a segment. The second table times reading the elements
+ * back: in order through the iterator, segment by segment, and at random.
+ *
+ * Usage: segmented_bench [element count, default 50'000'000]
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "segmented_vector.h"
+#include "vector.h"
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+/// What a child sends back to the parent.
+struct Report {
+  double seconds;       //!< Time spent pushing.
+  double worst_seconds; //!< Slowest single push_back().
+};
+
+/// Pushes `n_` ints into an empty `Vec`, timing each call.
+template <typename Vec> Report fill(std::size_t n_) {
+  Report report{0, 0};
+  auto start = clock_type::now();
+  Vec vec;
+  for (std::size_t i{0}; i < n_; ++i) {
+    auto before = clock_type::now();
+    vec.push_back(int(i));
+    std::chrono::duration<double> took = clock_type::now() - before;
+    if (took.count() > report.worst_seconds)
+      report.worst_seconds = took.count();
+  }
+  bench::do_not_optimize(vec[n_ / 2]);
+  std::chrono::duration<double> elapsed = clock_type::now() - start;
+  report.seconds = elapsed.count();
+  return report;
+}
+
+/// Runs `fill<Vec>` in a child and prints one table row.
+template <typename Vec> void measure(const std::string &name_, std::size_t n_) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    std::perror("pipe");
+    std::exit(1);
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    Report report = fill<Vec>(n_);
+    ssize_t written = write(fds[1], &report, sizeof(report));
+    _exit(written == sizeof(report) ? 0 : 1);
+  }
+  close(fds[1]);
+  Report report{};
+  ssize_t got = read(fds[0], &report, sizeof(report));
+  close(fds[0]);
+  int status{0};
+  struct rusage usage {};
+  wait4(pid, &status, 0, &usage);
+  if (got != sizeof(report) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    std::cout << std::left << std::setw(24) << name_ << "child failed\n";
+    return;
+  }
+  double payload_mb = double(n_ * sizeof(int)) / (1 << 20);
+  double peak_mb = double(usage.ru_maxrss) / 1024; // ru_maxrss is in KiB.
+  std::cout << std::left << std::setw(24) << name_ << std::right << std::fixed
+            << std::setprecision(1) << std::setw(12)
+            << n_ / report.seconds / 1e6 << std::setw(16)
+            << report.worst_seconds * 1e3 << std::setw(12) << peak_mb
+            << std::setw(10) << std::setprecision(2) << peak_mb / payload_mb
+            << "\n";
+}
+
+template <typename Vec> Vec make(std::size_t n_) {
+  Vec vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(int(i));
+  return vec;
+}
+
+template <typename Vec>
+bench::Result scan(const std::string &name_, const Vec &vec_) {
+  return bench::run(name_, vec_.size(), vec_.size(), [&vec_] {
+    std::int64_t sum{0};
+    for (int v : vec_)
+      sum += v;
+    bench::do_not_optimize(sum);
+  });
+}
+
+bench::Result scan_segments(const std::string &name_,
+                            const sc::segmented_vector<int> &vec_) {
+  return bench::run(name_, vec_.size(), vec_.size(), [&vec_] {
+    std::int64_t sum{0};
+    vec_.for_each_segment([&sum](sc::span<const int> part) {
+      for (int v : part)
+        sum += v;
+    });
+    bench::do_not_optimize(sum);
+  });
+}
+
+template <typename Vec>
+bench::Result random_reads(const std::string &name_, const Vec &vec_) {
+  constexpr std::size_t queries{1 << 16};
+  std::mt19937 gen{9};
+  std::vector<std::uint32_t> where(queries);
+  for (auto &p : where)
+    p = std::uint32_t(gen() % vec_.size());
+  return bench::run(name_, vec_.size(), queries, [&vec_, &where] {
+    std::int64_t sum{0};
+    for (std::uint32_t p : where)
+      sum += vec_[p];
+    bench::do_not_optimize(sum);
+  });
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+
+  std::cout << "push_back of " << n << " ints\n";
+  std::cout << std::left << std::setw(24) << "container" << std::right
+            << std::setw(12) << "Mpush/s" << std::setw(16) << "worst push ms"
+            << std::setw(12) << "peak MB" << std::setw(10) << "peak/data"
+            << "\n";
+  measure<std::vector<int>>("std::vector", n);
+  measure<sc::vector<int>>("sc::vector", n);
+  measure<sc::segmented_vector<int>>("sc::segmented_vector", n);
+  std::cout << "\n";
+
+  std::vector<bench::Result> results;
+  for (std::size_t size : {10'000ul, 1'000'000ul, n}) {
+    const auto flat = make<sc::vector<int>>(size);
+    const auto segmented = make<sc::segmented_vector<int>>(size);
+    results.push_back(scan("scan / sc::vector", flat));
+    results.push_back(scan("scan / sc::segmented_vector", segmented));
+    results.push_back(scan_segments("scan segments / sc::segmented_vector", segmented));
+    results.push_back(random_reads("random read / sc::vector", flat));
+    results.push_back(random_reads("random read / sc::segmented_vector", segmented));
+  }
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*!
+ * @file serialize_bench.cpp
+ * @brief Saving and loading an sc::vector: binary format against text.
+ *
+ * The text rows write the vector with operator<< and parse it back with
+ * operator>>, the only way out of the process before sc::save. The binary
+ * rows save with one writev, load into a new vector (checksum included),
+ * or only map the file as a vector_view. The nested rows save and load a
+ * vector of 256-element rows. Times are per element; the summary turns
+ * them into MB/s of elements.
+ *
+ * Usage: serialize_bench [elements, default 2^22] [directory, default /tmp]
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "serialize.h"
+#include "vector.h"
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 22;
+  std::string dir = (argc > 2) ? argv[2] : "/tmp";
+  std::string path = dir + "/serialize_bench.data";
+
+  sc::vector<std::int32_t> values;
+  for (std::size_t i{0}; i < n; ++i) {
+    values.push_back(std::int32_t(i * 2654435761u));
+  }
+  sc::vector<sc::vector<std::int32_t>> rows;
+  for (std::size_t r{0}; r < n / 256; ++r) {
+    rows.emplace_back(values.begin() + r * 256, values.begin() + (r + 1) * 256);
+  }
+
+  std::vector<bench::Result> results;
+  results.push_back(bench::run("save / text", n, n, [&] {
+    std::ofstream out{path};
+    out << values;
+  }));
+  results.push_back(bench::run("load / text", n, n, [&] {
+    std::ifstream in{path};
+    sc::vector<std::int32_t> loaded;
+    char brace;
+    in >> brace;
+    std::int32_t value;
+    while (in >> value) {
+      loaded.push_back(value);
+    }
+    bench::do_not_optimize(loaded.data());
+  }));
+  results.push_back(bench::run("save / binary", n, n, [&] {
+    sc::save(path, values);
+  }));
+  results.push_back(bench::run("load / binary", n, n, [&] {
+    bench::do_not_optimize(sc::load<std::int32_t>(path).data());
+  }));
+  results.push_back(bench::run("open / vector_view", n, n, [&] {
+    sc::vector_view<std::int32_t> view{path};
+    bench::do_not_optimize(view.data());
+  }));
+  results.push_back(bench::run("open + verify / vector_view", n, n, [&] {
+    sc::vector_view<std::int32_t> view{path, true};
+    bench::do_not_optimize(view.data());
+  }));
+  results.push_back(bench::run("save / binary, nested", n, n, [&] {
+    sc::save(path, rows);
+  }));
+  results.push_back(bench::run("load / binary, nested", n, n, [&] {
+    bench::do_not_optimize(sc::load_nested<std::int32_t>(path).data());
+  }));
+  bench::print_table(std::cout, results);
+
+  std::cout << "\nThroughput, MB/s of elements:\n";
+  for (const auto &r : results)
+    std::cout << "  " << r.name << ": "
+              << sizeof(std::int32_t) * 1e3 / r.ns_per_op << "\n";
+  std::remove(path.c_str());
+  return 0;
+}
@@ -0,0 +1,190 @@
+/*!
+ * @file shm_bench.cpp
+ * @brief Reader processes sharing one sc::shm_vector vs private copies.
+ *
+ * A lookup table of 64-bit values is needed by several reader processes.
+ * With private copies, every reader loads the table from a file into an
+ * sc::vector of its own; with sc::shm_vector, one writer fills a segment
+ * and every reader attaches to it. Each reader then scans the whole table
+ * once and waits, so that all of them are alive while the parent reads
+ * their memory use from /proc/<pid>/smaps_rollup: Pss splits a shared
+ * page among the processes that map it, so the sum of the readers' Pss is
+ * what the table costs the host.
+ *
+ * Usage: shm_bench [elements, default 2^24] [readers, default 8]
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "serialize.h"
+#include "shm_vector.h"
+#include "vector.h"
+
+namespace {
+/// What a reader sends back to the parent.
+struct Report {
+  double attach_seconds; //!< Time until the table could be read.
+  double scan_seconds;   //!< Time to read every element once.
+};
+
+/// Memory of one process, in KiB, from /proc/<pid>/smaps_rollup.
+struct Memory {
+  double pss{0};      //!< Proportional set size.
+  double private_{0}; //!< Pages no other process maps.
+};
+
+Memory memory_of(pid_t pid_) {
+  std::ifstream rollup{"/proc/" + std::to_string(pid_) + "/smaps_rollup"};
+  Memory memory;
+  // The first line names the address range; then come "Key: value kB".
+  for (std::string line; std::getline(rollup, line);) {
+    std::istringstream fields{line};
+    std::string key;
+    double kib{0};
+    if (!(fields >> key >> kib)) {
+      continue;
+    }
+    if (key == "Pss:") {
+      memory.pss = kib;
+    } else if (key == "Private_Clean:" || key == "Private_Dirty:") {
+      memory.private_ += kib;
+    }
+  }
+  return memory;
+}
+
+template <typename Vec> std::uint64_t scan(const Vec &vec_) {
+  std::uint64_t total{0};
+  for (std::size_t i{0}; i < vec_.size(); ++i) {
+    total += vec_[i];
+  }
+  return total;
+}
+
+/*! Forks `readers_` children running `attach_` (which returns the table)
+ * and prints one table row once all of them have scanned it.
+ */
+template <typename Attach>
+void measure(const std::string &name_, std::size_t n_, int readers_,
+             Attach attach_) {
+  int reports[2], release[2];
+  if (pipe(reports) != 0 || pipe(release) != 0) {
+    std::perror("pipe");
+    std::exit(1);
+  }
+  std::vector<pid_t> pids;
+  for (int r{0}; r < readers_; ++r) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(reports[0]);
+      close(release[1]);
+      auto start = std::chrono::steady_clock::now();
+      auto table = attach_();
+      auto attached = std::chrono::steady_clock::now();
+      bench::do_not_optimize(scan(table));
+      std::chrono::duration<double> attach = attached - start;
+      std::chrono::duration<double> scanned =
+          std::chrono::steady_clock::now() - attached;
+      Report report{attach.count(), scanned.count()};
+      ssize_t written = write(reports[1], &report, sizeof(report));
+      // Stays alive, with the table mapped, until the parent is done.
+      char byte;
+      ssize_t ignored = read(release[0], &byte, 1);
+      (void)ignored;
+      _exit(written == sizeof(report) ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  close(reports[1]);
+  close(release[0]);
+
+  Report total{0, 0};
+  int got{0};
+  for (Report report{}; got < readers_ &&
+                        read(reports[0], &report, sizeof(report)) ==
+                            ssize_t(sizeof(report));
+       ++got) {
+    total.attach_seconds += report.attach_seconds;
+    total.scan_seconds += report.scan_seconds;
+  }
+  Memory memory;
+  for (pid_t pid : pids) {
+    Memory one = memory_of(pid);
+    memory.pss += one.pss;
+    memory.private_ += one.private_;
+  }
+  close(release[1]);
+  close(reports[0]);
+  bool failed{got != readers_};
+  for (pid_t pid : pids) {
+    int status{0};
+    waitpid(pid, &status, 0);
+    failed = failed || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+  }
+  if (failed) {
+    std::cout << std::left << std::setw(28) << name_ << "reader failed\n";
+    return;
+  }
+  double table_mb = double(n_ * sizeof(std::uint64_t)) / (1 << 20);
+  double pss_mb = memory.pss / 1024;
+  std::cout << std::left << std::setw(28) << name_ << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12)
+            << total.attach_seconds / readers_ * 1e3 << std::setw(12)
+            << total.scan_seconds / readers_ * 1e3 << std::setprecision(1)
+            << std::setw(12) << pss_mb << std::setw(12)
+            << memory.private_ / 1024 / readers_ << std::setw(10)
+            << std::setprecision(2) << pss_mb / table_mb << "\n";
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 24;
+  int readers = (argc > 2) ? std::atoi(argv[2]) : 8;
+  std::string path = "/tmp/shm_bench." + std::to_string(getpid());
+  std::string segment = "/shm_bench." + std::to_string(getpid());
+
+  {
+    sc::vector<std::uint64_t> table;
+    table.reserve(n);
+    for (std::uint64_t i{0}; i < n; ++i) {
+      table.push_back(i * 0x9E3779B97F4A7C15ull);
+    }
+    sc::save(path, table);
+  }
+
+  std::cout << n << " uint64 (" << n * sizeof(std::uint64_t) / (1 << 20)
+            << " MiB), " << readers << " reader processes\n";
+  std::cout << std::left << std::setw(28) << "table" << std::right
+            << std::setw(12) << "attach ms" << std::setw(12) << "scan ms"
+            << std::setw(12) << "Pss MiB" << std::setw(12) << "priv MiB"
+            << std::setw(10) << "Pss/data" << "\n";
+  std::cout << std::string(86, '-') << "\n";
+
+  measure("private sc::vector (load)", n, readers,
+          [&] { return sc::load<std::uint64_t>(path); });
+  {
+    sc::shm_vector<std::uint64_t> writer{segment, sc::open_mode::truncate};
+    sc::vector_view<std::uint64_t> source{path};
+    writer.assign(source.begin(), source.end());
+    writer.publish();
+    measure("shared sc::shm_vector", n, readers, [&] {
+      return sc::shm_vector<std::uint64_t>{segment, sc::open_mode::read_only};
+    });
+  }
+  sc::shm_vector<std::uint64_t>::remove(segment);
+  std::remove(path.c_str());
+  return 0;
+}
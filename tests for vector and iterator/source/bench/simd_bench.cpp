@@ -0,0 +1,94 @@
+/*!
+ * @file simd_bench.cpp
+ * @brief Throughput of the sc::simd kernels at every instruction set level.
+ *
+ * Each kernel scans a whole sc::vector<std::int32_t> and
+ * sc::vector<float>: find and contains look for a value that is not
+ * there. The std rows run the same algorithm through the iterators, as
+ * plain code would. Times are per byte scanned; the summary turns them
+ * into GB/s.
+ *
+ * Usage: simd_bench [elements, default 2^20]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace {
+const char *level_names[] = {"scalar", "sse2", "avx2", "avx512"};
+
+template <typename T>
+void measure(const std::string &type_, const sc::vector<T> &vec_,
+             std::vector<bench::Result> &results_) {
+  std::size_t n = vec_.size();
+  std::size_t bytes = n * sizeof(T);
+  const T missing = T(-1);
+  auto first = vec_.begin();
+  auto last = vec_.end();
+  std::string tag = " / " + type_ + " std";
+
+  results_.push_back(bench::run("find" + tag, n, bytes, [&] {
+    bench::do_not_optimize(std::find(first, last, missing));
+  }));
+  results_.push_back(bench::run("count" + tag, n, bytes, [&] {
+    bench::do_not_optimize(std::count(first, last, missing));
+  }));
+  results_.push_back(bench::run("minmax" + tag, n, bytes, [&] {
+    bench::do_not_optimize(std::minmax_element(first, last));
+  }));
+  results_.push_back(bench::run("sum" + tag, n, bytes, [&] {
+    bench::do_not_optimize(std::accumulate(first, last, sc::simd::sum_t<T>{0}));
+  }));
+
+  for (auto level : {sc::simd::level::scalar, sc::simd::level::sse2,
+                     sc::simd::level::avx2, sc::simd::level::avx512}) {
+    if (sc::simd::set_level(level) != level)
+      continue; // Not supported by this CPU.
+    tag = " / " + type_ + " " + level_names[int(level)];
+    results_.push_back(bench::run("find" + tag, n, bytes, [&] {
+      bench::do_not_optimize(sc::simd::find(vec_, missing));
+    }));
+    results_.push_back(bench::run("count" + tag, n, bytes, [&] {
+      bench::do_not_optimize(sc::simd::count(vec_, missing));
+    }));
+    results_.push_back(bench::run("minmax" + tag, n, bytes, [&] {
+      bench::do_not_optimize(sc::simd::minmax(vec_));
+    }));
+    results_.push_back(bench::run("sum" + tag, n, bytes, [&] {
+      bench::do_not_optimize(sc::simd::sum(vec_));
+    }));
+  }
+  sc::simd::set_level(sc::simd::detected_level());
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+
+  sc::vector<std::int32_t> ints(n);
+  sc::vector<float> floats(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    ints[i] = std::int32_t(i % 1000);
+    floats[i] = float(i % 1000) * 0.5f;
+  }
+
+  // The "ns/op" column is nanoseconds per byte.
+  std::vector<bench::Result> results;
+  measure("int32", ints, results);
+  measure("float", floats, results);
+  bench::print_table(std::cout, results);
+
+  std::cout << "\nThroughput, GB/s:\n";
+  for (const auto &r : results)
+    std::cout << "  " << r.name << ": " << 1.0 / r.ns_per_op << "\n";
+  return 0;
+}
@@ -0,0 +1,87 @@
+/*!
+ * @file small_vector_bench.cpp
+ * @brief sc::small_vector against sc::vector for short-lived, small vectors.
+ *
+ * One operation builds a vector, push_back()s `n` ints into it and throws
+ * it away, for every `n` from 0 to 64. The first table counts the heap
+ * allocations each operation makes; the second one times it.
+ */
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+constexpr std::size_t reps{10'000}; //!< Operations per timed call.
+constexpr std::size_t max_n{64};    //!< Largest size measured.
+
+/// std::allocator that counts its allocate() calls.
+template <typename T> struct CountingAllocator : std::allocator<T> {
+  template <typename U> struct rebind { using other = CountingAllocator<U>; };
+  static std::size_t allocations; //!< Number of allocate() calls.
+
+  CountingAllocator(void) = default;
+  template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    ++allocations;
+    return std::allocator<T>::allocate(n);
+  }
+};
+template <typename T> std::size_t CountingAllocator<T>::allocations{0};
+
+/// One operation: fill a fresh `Vec` with `n_` ints.
+template <typename Vec> int fill(std::size_t n_) {
+  Vec vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(int(i));
+  bench::do_not_optimize(vec.data());
+  return int(vec.size());
+}
+
+/// Heap allocations made by one `fill<Vec>(n_)`.
+template <typename Vec> std::size_t allocations(std::size_t n_) {
+  using alloc_t = typename Vec::allocator_type;
+  alloc_t::allocations = 0;
+  fill<Vec>(n_);
+  return alloc_t::allocations;
+}
+
+template <typename Vec> bench::Result latency(const std::string &name_, std::size_t n_) {
+  return bench::run(name_, n_, reps, [n_] {
+    int sum{0};
+    for (std::size_t r{0}; r < reps; ++r)
+      sum += fill<Vec>(n_);
+    bench::do_not_optimize(sum);
+  }, 0.05);
+}
+} // namespace
+
+int main(void) {
+  using counting_t = CountingAllocator<int>;
+  std::cout << "heap allocations per vector\n";
+  std::cout << std::setw(4) << "n" << std::setw(14) << "vector"
+            << std::setw(18) << "small_vector<8>" << std::setw(18)
+            << "small_vector<16>" << "\n";
+  for (std::size_t n{0}; n <= max_n; ++n) {
+    std::cout << std::setw(4) << n << std::setw(14)
+              << allocations<sc::vector<int, counting_t>>(n) << std::setw(18)
+              << allocations<sc::small_vector<int, 8, counting_t>>(n)
+              << std::setw(18)
+              << allocations<sc::small_vector<int, 16, counting_t>>(n) << "\n";
+  }
+  std::cout << "\n";
+
+  std::vector<bench::Result> results;
+  for (std::size_t n{0}; n <= max_n; n = (n < 4) ? n + 1 : n * 2) {
+    results.push_back(latency<sc::vector<int>>("sc::vector<int>", n));
+    results.push_back(latency<sc::small_vector<int, 8>>("sc::small_vector<int, 8>", n));
+    results.push_back(latency<sc::small_vector<int, 16>>("sc::small_vector<int, 16>", n));
+  }
+  bench::print_table(std::cout, results);
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*!
+ * @file sort_bench.cpp
+ * @brief Standard algorithms over sc::vector against std::vector.
+ *
+ * With random access iterators, `std::sort`, `std::lower_bound` and
+ * `std::copy` take the same code paths over both containers, so the
+ * columns should match.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+namespace {
+/// `n_` pseudo-random ints, the same for every container.
+template <typename Vec> Vec random_ints(std::size_t n_) {
+  std::mt19937 gen{42};
+  Vec vec;
+  vec.reserve(n_);
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(int(gen()));
+  return vec;
+}
+
+/// Sorts a fresh copy of the random input.
+template <typename Vec> bench::Result sort(const std::string &name_, std::size_t n_) {
+  return bench::run(
+      name_, n_, n_, [n_] { return random_ints<Vec>(n_); },
+      [](Vec &vec) {
+        std::sort(vec.begin(), vec.end());
+        bench::do_not_optimize(vec.data());
+      });
+}
+
+/// Looks up `queries` random keys in a sorted vector.
+template <typename Vec>
+bench::Result lower_bound(const std::string &name_, std::size_t n_) {
+  constexpr std::size_t queries{1 << 16};
+  Vec vec = random_ints<Vec>(n_);
+  std::sort(vec.begin(), vec.end());
+  std::vector<int> keys = random_ints<std::vector<int>>(queries);
+  return bench::run(name_, n_, queries, [&vec, &keys] {
+    std::intptr_t sum{0};
+    for (int key : keys)
+      sum += std::lower_bound(vec.begin(), vec.end(), key) - vec.begin();
+    bench::do_not_optimize(sum);
+  });
+}
+
+/// Copies the whole vector into a preallocated one.
+template <typename Vec> bench::Result copy(const std::string &name_, std::size_t n_) {
+  Vec src = random_ints<Vec>(n_);
+  Vec dst = random_ints<Vec>(n_);
+  return bench::run(name_, n_, n_, [&src, &dst] {
+    std::copy(src.cbegin(), src.cend(), dst.begin());
+    bench::do_not_optimize(dst.data());
+  });
+}
+} // namespace
+
+int main(void) {
+  std::vector<bench::Result> results;
+  for (std::size_t n : {1'000ul, 100'000ul, 10'000'000ul}) {
+    results.push_back(sort<sc::vector<int>>("std::sort / sc::vector<int>", n));
+    results.push_back(sort<std::vector<int>>("std::sort / std::vector<int>", n));
+  }
+  for (std::size_t n : {1'000ul, 100'000ul, 10'000'000ul}) {
+    results.push_back(lower_bound<sc::vector<int>>("std::lower_bound / sc::vector<int>", n));
+    results.push_back(lower_bound<std::vector<int>>("std::lower_bound / std::vector<int>", n));
+  }
+  for (std::size_t n : {1'000ul, 100'000ul, 10'000'000ul}) {
+    results.push_back(copy<sc::vector<int>>("std::copy / sc::vector<int>", n));
+    results.push_back(copy<std::vector<int>>("std::copy / std::vector<int>", n));
+  }
+  bench::print_table(std::cout, results);
+
+  // Results come in (sc, std) pairs.
+  std::cout << "\nsc::vector time relative to std::vector:\n";
+  for (std::size_t i{0}; i + 1 < results.size(); i += 2) {
+    std::cout << "  " << results[i].name << " n=" << results[i].n << ": "
+              << results[i].ns_per_op / results[i + 1].ns_per_op << "x\n";
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*!
+ * @file tiered_bench.cpp
+ * @brief Where sc::tiered_vector starts beating sc::vector.
+ *
+ * For each size, one operation is an insert at a random position followed
+ * by an erase at another one, so the size stays put. sc::vector pays O(n)
+ * for each, sc::tiered_vector O(sqrt n). Random reads are timed too, since
+ * that is what the tiered layout gives up. The last table lists, per
+ * size, how many times faster sc::tiered_vector is at edits; the crossover
+ * is where that goes above 1.
+ */
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tiered_vector.h"
+#include "vector.h"
+
+namespace {
+/// Random positions, the same for every container.
+std::vector<std::uint32_t> positions(std::size_t count_, std::size_t n_) {
+  std::mt19937 gen{5};
+  std::vector<std::uint32_t> pos(count_);
+  for (auto &p : pos)
+    p = std::uint32_t(gen() % n_);
+  return pos;
+}
+
+template <typename Vec> Vec make(std::size_t n_) {
+  Vec vec;
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(int(i));
+  return vec;
+}
+
+/// Edits per timed call: fewer for the big O(n) ones.
+std::size_t edit_reps(std::size_t n_) { return n_ >= 1'000'000 ? 64 : 1'024; }
+
+template <typename Vec> bench::Result edits(const std::string &name_, std::size_t n_) {
+  const std::size_t reps = edit_reps(n_);
+  const auto where = positions(2 * reps, n_);
+  Vec vec = make<Vec>(n_);
+  return bench::run(name_, n_, reps, [&vec, &where, reps] {
+    for (std::size_t r{0}; r < reps; ++r) {
+      vec.insert(vec.begin() + where[2 * r], int(r));
+      vec.erase(vec.begin() + where[2 * r + 1]);
+    }
+    bench::do_not_optimize(vec[0]);
+  });
+}
+
+template <typename Vec> bench::Result reads(const std::string &name_, std::size_t n_) {
+  constexpr std::size_t queries{1 << 16};
+  const auto where = positions(queries, n_);
+  const Vec vec = make<Vec>(n_);
+  return bench::run(name_, n_, queries, [&vec, &where] {
+    std::int64_t sum{0};
+    for (std::uint32_t p : where)
+      sum += vec[p];
+    bench::do_not_optimize(sum);
+  });
+}
+} // namespace
+
+int main(void) {
+  const std::size_t sizes[]{256, 1'024, 4'096, 16'384, 65'536, 262'144,
+                            1'048'576, 10'000'000};
+  std::vector<bench::Result> results;
+  std::vector<double> speedup;
+  for (std::size_t n : sizes) {
+    results.push_back(edits<sc::tiered_vector<int>>("insert+erase / sc::tiered_vector", n));
+    results.push_back(edits<sc::vector<int>>("insert+erase / sc::vector", n));
+    speedup.push_back(results[results.size() - 1].ns_per_op /
+                      results[results.size() - 2].ns_per_op);
+  }
+  for (std::size_t n : sizes) {
+    results.push_back(reads<sc::tiered_vector<int>>("random read / sc::tiered_vector", n));
+    results.push_back(reads<sc::vector<int>>("random read / sc::vector", n));
+  }
+  bench::print_table(std::cout, results);
+
+  std::cout << "\nsc::tiered_vector edit speedup over sc::vector:\n";
+  for (std::size_t i{0}; i < speedup.size(); ++i) {
+    std::cout << std::setw(12) << sizes[i] << "  " << std::fixed
+              << std::setprecision(2) << speedup[i] << "x"
+              << (speedup[i] > 1 ? "" : "  (sc::vector wins)") << "\n";
+  }
+  return 0;
+}
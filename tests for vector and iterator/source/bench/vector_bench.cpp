@@ -0,0 +1,253 @@
+/*!
+ * @file vector_bench.cpp
+ * @brief Core vector operations, for sc::vector or std::vector.
+ *
+ * Like the tests, the suite picks the container through `which_lib`: it
+ * is built twice, as `vector_bench` (sc) and `vector_bench_std` (std), so
+ * the two tables can be put side by side.
+ *
+ * Every operation runs for `int`, `double`, `std::string` and a 64-byte
+ * POD, at sizes from 16 up to `--max-n`.
+ *
+ * Usage: vector_bench [--max-n N] [--filter TEXT] [--json FILE]
+ *  --max-n   largest size, up to 10^8 (default 10^6);
+ *  --filter  only run benchmarks whose name contains TEXT;
+ *  --json    also write the results as JSON to FILE ("-" for stdout).
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "vector.h"
+
+#ifndef which_lib
+#define which_lib sc
+// To run the suite with the STL's vector, build with -Dwhich_lib=std.
+#endif
+
+#define BENCH_STR_(x) #x
+#define BENCH_STR(x) BENCH_STR_(x)
+
+namespace {
+/// A plain 64-byte record.
+struct Pod64 {
+  std::uint64_t words[8]; //!< Payload.
+  bool operator==(const Pod64 &other) const {
+    return std::memcmp(words, other.words, sizeof(words)) == 0;
+  }
+  bool operator!=(const Pod64 &other) const { return !(*this == other); }
+};
+
+/// The `i_`-th value of a benchmark input.
+template <typename T> T value(std::size_t i_);
+template <> int value<int>(std::size_t i_) { return int(i_ * 2654435761u); }
+template <> double value<double>(std::size_t i_) { return double(i_) * 0.5; }
+template <> std::string value<std::string>(std::size_t i_) {
+  // Long enough to live on the heap, past the small string buffer.
+  return std::string(24, char('a' + i_ % 26));
+}
+template <> Pod64 value<Pod64>(std::size_t i_) {
+  Pod64 pod{};
+  pod.words[0] = i_;
+  return pod;
+}
+
+/// Something cheap to accumulate from an element.
+inline std::size_t weight(int v_) { return std::size_t(v_); }
+inline std::size_t weight(double v_) { return std::size_t(v_); }
+inline std::size_t weight(const std::string &v_) { return v_.size(); }
+inline std::size_t weight(const Pod64 &v_) { return v_.words[0]; }
+
+template <typename T> using vec_t = which_lib::vector<T>;
+
+/// A vector with `n_` elements and room for `extra_` more.
+template <typename T> vec_t<T> make(std::size_t n_, std::size_t extra_ = 0) {
+  vec_t<T> vec;
+  vec.reserve(n_ + extra_);
+  for (std::size_t i{0}; i < n_; ++i)
+    vec.push_back(value<T>(i));
+  return vec;
+}
+
+/// Number of single-element edits timed per run; each costs O(n).
+std::size_t edit_reps(std::size_t n_) { return n_ >= 10'000'000 ? 4 : 64; }
+
+/// Command line settings.
+struct Options {
+  std::size_t max_n{1'000'000}; //!< Largest size.
+  std::string filter;           //!< Substring benchmarks must contain.
+  std::string json;             //!< Where to write the JSON, if anywhere.
+};
+
+/// Runs every benchmark for one element type.
+class Suite {
+public:
+  Suite(const Options &options_, std::vector<bench::Result> &out_)
+      : m_options{options_}, m_out{out_} {}
+
+  template <typename T> void run(const std::string &type_) {
+    for (std::size_t n : {16ul, 64ul, 256ul, 1'024ul, 10'000ul, 100'000ul,
+                          1'000'000ul, 10'000'000ul, 100'000'000ul}) {
+      // Keep the inputs (a few copies at most) within a few GiB.
+      if (n > m_options.max_n || n * sizeof(T) > (std::size_t{1} << 30))
+        break;
+      run_size<T>(type_, n);
+    }
+  }
+
+private:
+  template <typename T> void run_size(const std::string &type_, std::size_t n_) {
+    const std::size_t reps = edit_reps(n_);
+
+    add("push_back/" + type_, n_, n_, [n_] {
+      vec_t<T> vec;
+      for (std::size_t i{0}; i < n_; ++i)
+        vec.push_back(value<T>(i));
+      bench::do_not_optimize(vec.data());
+    });
+    add("push_back_reserved/" + type_, n_, n_, [n_] {
+      vec_t<T> vec;
+      vec.reserve(n_);
+      for (std::size_t i{0}; i < n_; ++i)
+        vec.push_back(value<T>(i));
+      bench::do_not_optimize(vec.data());
+    });
+
+    // Single inserts and erases, on a vector with enough spare room.
+    const T item = value<T>(7);
+    add_edit<T>("insert_front/" + type_, n_, reps, [reps, &item](vec_t<T> &vec) {
+      for (std::size_t r{0}; r < reps; ++r)
+        vec.insert(vec.begin(), item);
+    });
+    add_edit<T>("insert_middle/" + type_, n_, reps, [reps, &item](vec_t<T> &vec) {
+      for (std::size_t r{0}; r < reps; ++r)
+        vec.insert(vec.begin() + vec.size() / 2, item);
+    });
+    add_edit<T>("insert_back/" + type_, n_, reps, [reps, &item](vec_t<T> &vec) {
+      for (std::size_t r{0}; r < reps; ++r)
+        vec.insert(vec.end(), item);
+    });
+    // Erase at most half, so small vectors never run dry.
+    const std::size_t erases = std::min(reps, n_ / 2);
+    add_edit<T>("erase_front/" + type_, n_, erases, [erases](vec_t<T> &vec) {
+      for (std::size_t r{0}; r < erases; ++r)
+        vec.erase(vec.begin());
+    });
+    add_edit<T>("erase_middle/" + type_, n_, erases, [erases](vec_t<T> &vec) {
+      for (std::size_t r{0}; r < erases; ++r)
+        vec.erase(vec.begin() + vec.size() / 2);
+    });
+
+    // The rest share their inputs; skip building them if nothing runs.
+    bool any{false};
+    for (const char *op : {"copy_construct/", "copy_assign/", "assign/",
+                           "iterate_index/", "iterate_iterator/", "equal/"})
+      any = any || wanted(op + type_);
+    if (!any)
+      return;
+    const vec_t<T> src = make<T>(n_);
+    add("copy_construct/" + type_, n_, n_, [&src] {
+      vec_t<T> copy{src};
+      bench::do_not_optimize(copy.data());
+    });
+    vec_t<T> dst = make<T>(n_);
+    add("copy_assign/" + type_, n_, n_, [&src, &dst] {
+      dst = src;
+      bench::do_not_optimize(dst.data());
+    });
+    add("assign/" + type_, n_, n_, [n_, &dst, &item] {
+      dst.assign(n_, item);
+      bench::do_not_optimize(dst.data());
+    });
+    add("iterate_index/" + type_, n_, n_, [n_, &src] {
+      std::size_t sum{0};
+      for (std::size_t i{0}; i < n_; ++i)
+        sum += weight(src[i]);
+      bench::do_not_optimize(sum);
+    });
+    add("iterate_iterator/" + type_, n_, n_, [&src] {
+      std::size_t sum{0};
+      for (auto it = src.cbegin(); it != src.cend(); ++it)
+        sum += weight(*it);
+      bench::do_not_optimize(sum);
+    });
+    const vec_t<T> same = make<T>(n_);
+    add("equal/" + type_, n_, n_, [&src, &same] {
+      bool equal = (src == same);
+      bench::do_not_optimize(equal);
+    });
+  }
+
+  bool wanted(const std::string &name_) const {
+    return name_.find(m_options.filter) != std::string::npos;
+  }
+
+  /// Times `fn_`, if its name passes the filter.
+  template <typename Fn>
+  void add(const std::string &name_, std::size_t n_, std::size_t ops_, Fn &&fn_) {
+    if (wanted(name_))
+      m_out.push_back(bench::run(name_, n_, ops_, fn_));
+  }
+
+  /// Times `fn_` over a fresh `n_`-element vector with spare room.
+  template <typename T, typename Fn>
+  void add_edit(const std::string &name_, std::size_t n_, std::size_t reps_, Fn &&fn_) {
+    if (wanted(name_)) {
+      m_out.push_back(bench::run(
+          name_, n_, reps_, [n_, reps_] { return make<T>(n_, reps_); },
+          [&fn_](vec_t<T> &vec) {
+            fn_(vec);
+            bench::do_not_optimize(vec.data());
+          }));
+    }
+  }
+
+  const Options &m_options;         //!< Command line settings.
+  std::vector<bench::Result> &m_out; //!< Where the results go.
+};
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  for (int i{1}; i + 1 < argc; i += 2) {
+    std::string flag{argv[i]};
+    if (flag == "--max-n") {
+      options.max_n = std::size_t(std::strtod(argv[i + 1], nullptr));
+    } else if (flag == "--filter") {
+      options.filter = argv[i + 1];
+    } else if (flag == "--json") {
+      options.json = argv[i + 1];
+    } else {
+      std::cerr << "unknown option " << flag << "\n";
+      return 1;
+    }
+  }
+
+  std::vector<bench::Result> results;
+  Suite suite{options, results};
+  suite.run<int>("int");
+  suite.run<double>("double");
+  suite.run<std::string>("std::string");
+  suite.run<Pod64>("pod64");
+
+  const std::string lib{BENCH_STR(which_lib)};
+  std::cout << "container: " << lib << "::vector\n";
+  bench::print_table(std::cout, results);
+
+  const std::vector<std::pair<std::string, std::string>> context{
+      {"library", lib}, {"max_n", std::to_string(options.max_n)}};
+  if (options.json == "-") {
+    bench::print_json(std::cout, results, context);
+  } else if (!options.json.empty()) {
+    std::ofstream file{options.json};
+    bench::print_json(file, results, context);
+  }
+  return 0;
+}
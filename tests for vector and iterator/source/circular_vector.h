@@ -0,0 +1,493 @@
+#ifndef _CIRCULAR_VECTOR_H_
+#define _CIRCULAR_VECTOR_H_
+
+#include <algorithm>        // std::copy, std::equal, std::min
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <cstring>          // std::memcpy
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <iterator>         // std::distance, std::random_access_iterator_tag
+#include <limits>           // std::numeric_limits
+#include <memory>           // std::allocator_traits
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <type_traits>      // std::is_trivially_copyable
+#include <utility>          // std::move, std::forward, std::pair
+
+#include "span.h"   // sc::span
+#include "vector.h" // sc::vector, sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+/// Random access iterator over a ring buffer.
+/*!
+ * The iterator keeps the position of its element counted from the start
+ * of the buffer without wrapping, so positions order like indices; only
+ * dereferencing masks it back into the buffer. `T` may be const.
+ */
+template <class T> class CircularIterator {
+public:
+  using iterator = CircularIterator; //!< Alias to iterator.
+  typedef std::ptrdiff_t difference_type; //!< Distance between iterators.
+  typedef std::remove_cv_t<T> value_type; //!< Value type the iterator points to.
+  typedef T *pointer;                     //!< Pointer to the value type.
+  typedef T &reference;                   //!< Reference to the value type.
+  typedef std::random_access_iterator_tag
+      iterator_category; //!< Iterator category.
+
+  constexpr CircularIterator(void) = default;
+  /*! Iterator to position `pos_` of the buffer at `base_`.
+   * \param mask_ capacity - 1; the capacity is a power of two.
+   */
+  constexpr CircularIterator(pointer base_, std::size_t mask_, std::size_t pos_)
+      : m_base{base_}, m_mask{mask_}, m_pos{pos_} {}
+
+  /// Converts an iterator into a const iterator, never the other way.
+  template <class U, typename = std::enable_if_t<
+                         std::is_convertible<U *, T *>::value &&
+                         !std::is_same<U, T>::value>>
+  constexpr CircularIterator(const CircularIterator<U> &other)
+      : m_base{other.m_base}, m_mask{other.m_mask}, m_pos{other.m_pos} {}
+
+  constexpr reference operator*(void) const { return m_base[m_pos & m_mask]; }
+  constexpr pointer operator->(void) const { return m_base + (m_pos & m_mask); }
+  constexpr reference operator[](difference_type offset) const {
+    return m_base[(m_pos + offset) & m_mask];
+  }
+
+  constexpr iterator &operator++(void) {
+    ++m_pos;
+    return *this;
+  }
+  constexpr iterator operator++(int) {
+    iterator dummy{*this};
+    ++m_pos;
+    return dummy;
+  }
+  constexpr iterator &operator--(void) {
+    --m_pos;
+    return *this;
+  }
+  constexpr iterator operator--(int) {
+    iterator dummy{*this};
+    --m_pos;
+    return dummy;
+  }
+  constexpr iterator &operator+=(difference_type offset) {
+    m_pos += offset;
+    return *this;
+  }
+  constexpr iterator &operator-=(difference_type offset) {
+    m_pos -= offset;
+    return *this;
+  }
+
+  friend constexpr iterator operator+(difference_type offset, iterator it) {
+    return it += offset;
+  }
+  friend constexpr iterator operator+(iterator it, difference_type offset) {
+    return it += offset;
+  }
+  friend constexpr iterator operator-(iterator it, difference_type offset) {
+    return it -= offset;
+  }
+  friend constexpr difference_type operator-(const iterator &lhs_,
+                                             const iterator &rhs_) {
+    return difference_type(lhs_.m_pos - rhs_.m_pos);
+  }
+
+  // Iterators into the same buffer compare by position.
+  friend constexpr bool operator==(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_pos == rhs_.m_pos;
+  }
+  friend constexpr bool operator!=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_pos != rhs_.m_pos;
+  }
+  friend constexpr bool operator<(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_pos < rhs_.m_pos;
+  }
+  friend constexpr bool operator>(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_pos > rhs_.m_pos;
+  }
+  friend constexpr bool operator<=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_pos <= rhs_.m_pos;
+  }
+  friend constexpr bool operator>=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_pos >= rhs_.m_pos;
+  }
+
+private:
+  pointer m_base{nullptr}; //!< Start of the buffer.
+  std::size_t m_mask{0};   //!< Capacity - 1.
+  std::size_t m_pos{0};    //!< Unwrapped position in the buffer.
+
+  template <class U> friend class CircularIterator;
+};
+
+/// A ring buffer of at most `capacity()` elements.
+/*!
+ * push_back() on a full ring overwrites the oldest element, and
+ * pop_front() drops it, both in O(1). The capacity is rounded up to a
+ * power of two, so a position wraps with a mask instead of a modulo.
+ *
+ * The buffer is the spare capacity of an empty `sc::vector`, which
+ * allocates it, honours the allocator's propagation rules and releases
+ * it; the ring only builds and destroys the elements in it. The elements
+ * start at slot `m_head` and may wrap past the end of the buffer, so they
+ * come as at most two contiguous segments (see `as_spans()`).
+ */
+template <typename T, typename Alloc = std::allocator<T>> class circular_vector {
+  using alloc_traits = std::allocator_traits<Alloc>;
+
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using allocator_type = Alloc;    //!< The allocator type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+  using iterator = CircularIterator<value_type>; //!< The iterator.
+  using const_iterator =
+      CircularIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  circular_vector(void) = default;
+  /// An empty ring, with no buffer yet, that will use `alloc_`.
+  explicit circular_vector(const Alloc &alloc_) noexcept : m_slots{alloc_} {}
+  /// An empty ring with room for at least `capacity_` elements.
+  explicit circular_vector(size_type capacity_,
+                           const Alloc &alloc_ = Alloc())
+      : m_slots{alloc_} {
+    reserve(capacity_);
+  }
+  circular_vector(const std::initializer_list<T> &il,
+                  const Alloc &alloc_ = Alloc())
+      : m_slots{alloc_} {
+    reserve(il.size());
+    push_back(il.begin(), il.end());
+  }
+  circular_vector(const circular_vector &other)
+      : m_slots{alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())} {
+    reserve(other.capacity());
+    push_back(other.begin(), other.end());
+  }
+  circular_vector(circular_vector &&other) noexcept
+      : m_slots{std::move(other.m_slots)}, m_head{other.m_head},
+        m_size{other.m_size} {
+    other.m_head = 0;
+    other.m_size = 0;
+  }
+  /// Copy assignment: the allocator follows `other` only if it asks to
+  /// propagate on copy, and our buffer is reused when it is as large as
+  /// `other`'s; otherwise a new one comes from our (possibly new) allocator.
+  circular_vector &operator=(const circular_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    // `m_slots` holds no elements: this only settles the allocator, giving
+    // the buffer back first if it changes.
+    m_slots = other.m_slots;
+    if (capacity() != other.capacity()) {
+      m_slots = vector<T, Alloc>{get_allocator()};
+      reserve(other.capacity());
+    }
+    push_back(other.begin(), other.end());
+    return *this;
+  }
+  circular_vector &operator=(circular_vector &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        get_allocator() == other.get_allocator()) {
+      // The buffer changes hands.
+      m_slots = std::move(other.m_slots);
+      m_head = other.m_head;
+      m_size = other.m_size;
+      other.m_head = 0;
+      other.m_size = 0;
+    } else {
+      reserve(other.capacity());
+      for (auto &value : other) {
+        emplace_back(std::move(value));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+  virtual ~circular_vector(void) { clear(); }
+
+  allocator_type get_allocator(void) const { return m_slots.get_allocator(); }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator{slots(), mask(), m_head}; }
+  iterator end(void) { return iterator{slots(), mask(), m_head + m_size}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const {
+    return const_iterator{slots(), mask(), m_head};
+  }
+  const_iterator cend(void) const {
+    return const_iterator{slots(), mask(), m_head + m_size};
+  }
+
+  // [III] Capacity
+  size_type size(void) const { return m_size; }
+  size_type capacity(void) const { return m_slots.capacity(); }
+  bool empty(void) const { return m_size == 0; }
+  bool full(void) const { return m_size == capacity(); }
+  /// Makes room for at least `capacity_` elements, as a power of two.
+  void reserve(size_type capacity_) {
+    if (capacity_ <= capacity()) {
+      return;
+    }
+    size_type rounded{1};
+    while (rounded < capacity_) {
+      if (rounded > std::numeric_limits<size_type>::max() / 2) {
+        throw std::length_error("Capacidade grande demais!");
+      }
+      rounded *= 2;
+    }
+    // Move the elements, oldest first, into the new buffer.
+    vector<T, Alloc> slots{get_allocator()};
+    slots.reserve(rounded);
+    size_type moved{0};
+    try {
+      for (auto &value : *this) {
+        construct(slots.data() + moved, std::move_if_noexcept(value));
+        ++moved;
+      }
+    } catch (...) {
+      destroy_range(slots.data(), moved);
+      throw;
+    }
+    size_type count{m_size};
+    clear();
+    m_slots = std::move(slots);
+    m_size = count;
+  }
+
+  // [IV] Modifiers
+  void clear(void) {
+    auto halves = as_spans();
+    destroy_range(halves.first.data(), halves.first.size());
+    destroy_range(halves.second.data(), halves.second.size());
+    m_head = 0;
+    m_size = 0;
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  /// Appends `[first_, last_)`; past the capacity, the oldest ones go.
+  /*!
+   * Trivially copyable elements from a contiguous range are copied with
+   * at most two memcpy() calls, one per segment of free slots.
+   */
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  void push_back(InputItr first_, InputItr last_) {
+    using category = typename std::iterator_traits<InputItr>::iterator_category;
+    if constexpr (std::is_trivially_copyable<T>::value &&
+                  std::is_base_of<std::random_access_iterator_tag,
+                                  category>::value) {
+      size_type count = size_type(std::distance(first_, last_));
+      if (count == 0) {
+        return;
+      }
+      if (capacity() == 0) {
+        throw std::length_error("circular_vector sem capacidade!");
+      }
+      if (count >= capacity()) {
+        // Only the newest capacity() elements survive.
+        first_ += typename std::iterator_traits<InputItr>::difference_type(
+            count - capacity());
+        count = capacity();
+        m_head = 0;
+        m_size = 0;
+      }
+      size_type tail{(m_head + m_size) & mask()};
+      size_type head_part{std::min(count, capacity() - tail)};
+      copy_segment(first_, slots() + tail, head_part);
+      copy_segment(first_ + head_part, slots(), count - head_part);
+      m_size += count;
+      if (m_size > capacity()) {
+        m_head = (m_head + m_size - capacity()) & mask();
+        m_size = capacity();
+      }
+    } else {
+      for (; first_ != last_; ++first_) {
+        emplace_back(*first_);
+      }
+    }
+  }
+  /// Constructs a new element after the newest one.
+  /*!
+   * On a full ring the new element takes the place of the oldest one.
+   */
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (capacity() == 0) {
+      throw std::length_error("circular_vector sem capacidade!");
+    }
+    if (full()) {
+      reference oldest = slots()[m_head];
+      oldest = T(std::forward<Args>(args)...);
+      m_head = (m_head + 1) & mask();
+      return oldest;
+    }
+    pointer slot = slots() + ((m_head + m_size) & mask());
+    construct(slot, std::forward<Args>(args)...);
+    ++m_size;
+    return *slot;
+  }
+  void pop_front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    destroy_range(slots() + m_head, 1);
+    m_head = (m_head + 1) & mask();
+    if (--m_size == 0) {
+      m_head = 0;
+    }
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    --m_size;
+    destroy_range(slots() + ((m_head + m_size) & mask()), 1);
+  }
+
+  // [V] Element access
+  reference operator[](size_type idx_) {
+    return slots()[(m_head + idx_) & mask()];
+  }
+  const_reference operator[](size_type idx_) const {
+    return slots()[(m_head + idx_) & mask()];
+  }
+  reference at(size_type idx_) {
+    if (idx_ >= m_size) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  const_reference at(size_type idx_) const {
+    if (idx_ >= m_size) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  /// The oldest element.
+  reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[0];
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[0];
+  }
+  /// The newest element.
+  reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[m_size - 1];
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[m_size - 1];
+  }
+
+  /// The elements, oldest first, as two contiguous runs.
+  /*!
+   * The second run is empty unless the elements wrap past the end of the
+   * buffer; nothing is copied.
+   */
+  std::pair<span<T>, span<T>> as_spans(void) {
+    size_type first_part{std::min(m_size, capacity() - m_head)};
+    return {span<T>{slots() + m_head, first_part},
+            span<T>{slots(), m_size - first_part}};
+  }
+  std::pair<span<const T>, span<const T>> as_spans(void) const {
+    size_type first_part{std::min(m_size, capacity() - m_head)};
+    return {span<const T>{slots() + m_head, first_part},
+            span<const T>{slots(), m_size - first_part}};
+  }
+
+  // [VI] Operators
+  friend bool operator==(const circular_vector &lhs_,
+                         const circular_vector &rhs_) {
+    return lhs_.size() == rhs_.size() &&
+           std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+  }
+  friend bool operator!=(const circular_vector &lhs_,
+                         const circular_vector &rhs_) {
+    return !(lhs_ == rhs_);
+  }
+  friend std::ostream &operator<<(std::ostream &os_,
+                                  const circular_vector &v_) {
+    os_ << "[ ";
+    for (const auto &value : v_) {
+      os_ << value << " ";
+    }
+    os_ << "]";
+    return os_;
+  }
+  friend void swap(circular_vector &first_, circular_vector &second_) {
+    using std::swap;
+    swap(first_.m_slots, second_.m_slots);
+    swap(first_.m_head, second_.m_head);
+    swap(first_.m_size, second_.m_size);
+  }
+
+private:
+  pointer slots(void) { return m_slots.data(); }
+  const T *slots(void) const { return m_slots.data(); }
+  /// Capacity - 1: the capacity is a power of two (or zero).
+  size_type mask(void) const { return capacity() - 1; }
+
+  template <typename... Args> void construct(pointer ptr_, Args &&...args) {
+    allocator_type alloc{get_allocator()};
+    alloc_traits::construct(alloc, ptr_, std::forward<Args>(args)...);
+  }
+  void destroy_range(pointer first_, size_type count_) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      allocator_type alloc{get_allocator()};
+      for (size_type i{0}; i < count_; ++i) {
+        alloc_traits::destroy(alloc, first_ + i);
+      }
+    }
+  }
+  /// Copies `count_` trivially copyable elements from `src_` to `dst_`.
+  template <typename InputItr>
+  static void copy_segment(InputItr src_, pointer dst_, size_type count_) {
+    if constexpr (std::is_pointer<InputItr>::value) {
+      if (count_ > 0) {
+        std::memcpy(dst_, src_, count_ * sizeof(T));
+      }
+    } else if constexpr (std::is_same<InputItr, MyForwardIterator<T>>::value ||
+                         std::is_same<InputItr,
+                                      MyForwardIterator<const T>>::value) {
+      if (count_ > 0) {
+        std::memcpy(dst_, src_.operator->(), count_ * sizeof(T));
+      }
+    } else {
+      std::copy(src_, src_ + count_, dst_);
+    }
+  }
+
+  vector<T, Alloc> m_slots; //!< Owns the buffer; it never holds elements.
+  size_type m_head{0};      //!< Slot of the oldest element.
+  size_type m_size{0};      //!< Number of elements.
+};
+} // namespace sc
+
+#endif
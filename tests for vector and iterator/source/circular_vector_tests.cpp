@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "circular_vector.h"
+#include "test_helpers.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Eighth batch of tests, focused on sc::circular_vector
+// =============================================================
+
+// push_back() on a full ring overwrites the oldest element.
+#define RING_OVERWRITE YES
+// The iterator wraps around the end of the buffer.
+#define WRAPPING_ITERATOR YES
+// Bulk push_back() and the two segments from as_spans().
+#define BULK_PUSH YES
+// Non-trivial elements are built and destroyed exactly once.
+#define RING_LIFETIME YES
+// Copy assignment keeps each ring's memory resource.
+#define PMR_COPY_ASSIGN YES
+
+namespace {
+using test_helpers::Counted;
+using test_helpers::CountingResource;
+} // namespace
+
+void run_circular_vector_tests(void) {
+  TestManager tm{"Circular vector testing"};
+
+#if RING_OVERWRITE
+  {
+    BEGIN_TEST(tm, "RingOverwrite", "a full ring drops its oldest element");
+
+    sc::circular_vector<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8); // Rounded up to a power of two.
+    EXPECT_TRUE(ring.empty());
+    for (int i{0}; i < 8; ++i)
+      ring.push_back(i);
+    EXPECT_TRUE(ring.full());
+    ring.push_back(8);
+    ring.push_back(9);
+    EXPECT_EQ(ring.size(), 8);
+    EXPECT_EQ(ring.front(), 2);
+    EXPECT_EQ(ring.back(), 9);
+    EXPECT_EQ(ring[7], 9);
+    EXPECT_EQ(ring.at(0), 2);
+
+    ring.pop_front();
+    ring.pop_back();
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_EQ(ring.back(), 8);
+    EXPECT_EQ(ring, (sc::circular_vector<int>{3, 4, 5, 6, 7, 8}));
+
+    bool thrown{false};
+    try {
+      ring.at(6);
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    thrown = false;
+    try {
+      sc::circular_vector<int> none;
+      none.push_back(1);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    // Growing keeps the order, oldest first.
+    ring.reserve(9);
+    EXPECT_EQ(ring.capacity(), 16);
+    EXPECT_EQ(ring, (sc::circular_vector<int>{3, 4, 5, 6, 7, 8}));
+  }
+#endif
+
+#if WRAPPING_ITERATOR
+  {
+    BEGIN_TEST(tm, "WrappingIterator", "random access across the wrap point");
+
+    using iterator = sc::circular_vector<int>::iterator;
+    static_assert(std::is_same<std::iterator_traits<iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "random access iterator");
+    static_assert(std::is_convertible<iterator,
+                                      sc::circular_vector<int>::const_iterator>::value,
+                  "iterator converts to const_iterator");
+
+    sc::circular_vector<int> ring(4);
+    for (int i{0}; i < 6; ++i)
+      ring.push_back(i); // Slots: 4 5 2 3, oldest at slot 2.
+    auto it = ring.begin();
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(it[2], 4);
+    EXPECT_EQ(*(it + 3), 5);
+    EXPECT_EQ(ring.end() - ring.begin(), 4);
+    EXPECT_TRUE(it < ring.end());
+    it += 4;
+    EXPECT_TRUE(it == ring.cend());
+    EXPECT_EQ(*--it, 5);
+
+    std::sort(ring.begin(), ring.end(), [](int a, int b) { return a > b; });
+    EXPECT_EQ(ring, (sc::circular_vector<int>{5, 4, 3, 2}));
+    EXPECT_EQ(*std::lower_bound(ring.cbegin(), ring.cend(), 3,
+                                [](int a, int b) { return a > b; }),
+              3);
+    EXPECT_EQ(std::distance(ring.begin(), ring.end()), 4);
+  }
+#endif
+
+#if BULK_PUSH
+  {
+    BEGIN_TEST(tm, "BulkPush", "push_back(first, last) and as_spans()");
+
+    sc::circular_vector<int> ring(8);
+    const int first[]{0, 1, 2, 3, 4, 5};
+    ring.push_back(std::begin(first), std::end(first));
+    auto halves = ring.as_spans();
+    EXPECT_EQ(halves.first.size(), 6);
+    EXPECT_TRUE(halves.second.empty());
+
+    // Wraps: two slots at the end, three at the start.
+    sc::vector<int> more{6, 7, 8, 9, 10};
+    ring.push_back(more.begin(), more.end());
+    EXPECT_EQ(ring.size(), 8);
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_EQ(ring.back(), 10);
+    halves = ring.as_spans();
+    EXPECT_EQ(halves.first.size(), 5);
+    EXPECT_EQ(halves.first[0], 3);
+    EXPECT_EQ(halves.second.size(), 3);
+    EXPECT_EQ(halves.second[2], 10);
+    EXPECT_EQ(halves.first.data() + 5, halves.second.data() + 8);
+
+    int sum{0};
+    for (int v : halves.first)
+      sum += v;
+    for (int v : halves.second)
+      sum += v;
+    EXPECT_EQ(sum, 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10);
+
+    // More than the capacity: only the newest ones stay.
+    sc::vector<int> lots;
+    for (int i{100}; i < 120; ++i)
+      lots.push_back(i);
+    ring.push_back(lots.begin(), lots.end());
+    EXPECT_EQ(ring.size(), 8);
+    EXPECT_EQ(ring.front(), 112);
+    EXPECT_EQ(ring.back(), 119);
+
+    // Other random access iterators copy each segment with std::copy().
+    sc::circular_vector<int> copy(8);
+    copy.push_back(ring.cbegin() + 4, ring.cend());
+    EXPECT_EQ(copy, (sc::circular_vector<int>{116, 117, 118, 119}));
+
+    const sc::circular_vector<int> &view = ring;
+    auto const_halves = view.as_spans();
+    EXPECT_EQ(const_halves.first.size() + const_halves.second.size(), 8);
+  }
+#endif
+
+#if RING_LIFETIME
+  {
+    BEGIN_TEST(tm, "RingLifetime", "ctor/dtor calls are balanced");
+
+    {
+      sc::circular_vector<Counted> ring(4);
+      for (int i{0}; i < 10; ++i)
+        ring.emplace_back(std::string(20, char('a' + i)));
+      EXPECT_EQ(Counted::alive, 4);
+      EXPECT_EQ(ring.front().value, std::string(20, 'g'));
+
+      sc::circular_vector<Counted> copy{ring};
+      EXPECT_EQ(Counted::alive, 8);
+      EXPECT_EQ(copy, ring);
+      sc::circular_vector<Counted> moved{std::move(copy)};
+      EXPECT_EQ(Counted::alive, 8);
+      EXPECT_TRUE(copy.empty());
+
+      ring.pop_front();
+      ring.reserve(16);
+      EXPECT_EQ(Counted::alive, 7);
+      copy = ring;
+      EXPECT_EQ(Counted::alive, 10);
+      moved = std::move(ring);
+      EXPECT_EQ(Counted::alive, 6);
+      swap(moved, copy);
+      EXPECT_EQ(moved.size(), 3);
+
+      const std::string items[]{"x", "y"};
+      moved.push_back(std::begin(items), std::end(items));
+      EXPECT_EQ(moved.back().value, "y");
+      moved.clear();
+      EXPECT_EQ(Counted::alive, 3);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+  }
+#endif
+
+#if PMR_COPY_ASSIGN
+  {
+    BEGIN_TEST(tm, "PmrCopyAssign", "a = b keeps a's memory resource");
+
+    using ring = sc::circular_vector<int, std::pmr::polymorphic_allocator<int>>;
+    CountingResource left, right;
+    {
+      ring a{&left};
+      EXPECT_EQ(a.capacity(), 0);
+      EXPECT_EQ(left.live, 0);
+      ring b(8, &right);
+      for (int i{0}; i < 10; ++i)
+        b.push_back(i);
+      a = b;
+      EXPECT_TRUE(a.get_allocator().resource() == &left);
+      EXPECT_EQ(a.capacity(), b.capacity());
+      EXPECT_EQ(a, b);
+      EXPECT_EQ(left.live, long(a.capacity() * sizeof(int)));
+      EXPECT_EQ(right.live, long(b.capacity() * sizeof(int)));
+
+      // Same capacity: the buffer is reused.
+      const int *buffer = &a.front();
+      b.push_back(99);
+      a = b;
+      EXPECT_EQ(a.back(), 99);
+      EXPECT_TRUE(&a.front() == buffer);
+      EXPECT_EQ(left.live, long(a.capacity() * sizeof(int)));
+    }
+    EXPECT_EQ(left.live, 0);
+    EXPECT_EQ(right.live, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
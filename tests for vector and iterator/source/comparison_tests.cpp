@@ -0,0 +1,126 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Sixteenth batch of tests, focused on comparing sc::vector
+// =============================================================
+
+// Equality checks the sizes first, and compares every element.
+#define EQUALITY YES
+// Vectors are ordered lexicographically, like std::vector.
+#define LEXICOGRAPHIC_ORDER YES
+// The memcmp path and the element path agree.
+#define FAST_PATH_AGREES YES
+
+namespace {
+/// Compares two sc::vectors and the matching std::vectors with every
+/// operator, and tells whether they all agree.
+template <typename T>
+bool same_as_std(const sc::vector<T> &lhs_, const sc::vector<T> &rhs_) {
+  std::vector<T> l(lhs_.begin(), lhs_.end());
+  std::vector<T> r(rhs_.begin(), rhs_.end());
+  bool same = (lhs_ == rhs_) == (l == r) && (lhs_ != rhs_) == (l != r) &&
+              (lhs_ < rhs_) == (l < r) && (lhs_ > rhs_) == (l > r) &&
+              (lhs_ <= rhs_) == (l <= r) && (lhs_ >= rhs_) == (l >= r);
+#if __cplusplus > 201703L
+  same = same && (lhs_ <=> rhs_) == (l <=> r);
+#endif
+  return same;
+}
+} // namespace
+
+void run_comparison_tests(void) {
+  TestManager tm{"Comparison testing"};
+
+#if EQUALITY
+  {
+    BEGIN_TEST(tm, "Equality", "sizes and elements must both match");
+
+    sc::vector<int> prefix{1, 2, 3};
+    sc::vector<int> longer{1, 2, 3, 4};
+    EXPECT_FALSE(prefix == longer);
+    EXPECT_FALSE(longer == prefix);
+    EXPECT_TRUE(prefix != longer);
+    EXPECT_TRUE(prefix == (sc::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(sc::vector<int>{} == sc::vector<int>{});
+    EXPECT_FALSE(sc::vector<int>{} == prefix);
+
+    sc::vector<std::string> words{"a", "b"};
+    sc::vector<std::string> more{"a", "b", "c"};
+    EXPECT_FALSE(words == more);
+    EXPECT_TRUE(words != more);
+    more.pop_back();
+    EXPECT_TRUE(words == more);
+
+    // Floats compare by value, not by bits.
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_TRUE((sc::vector<double>{0.0}) == (sc::vector<double>{-0.0}));
+    EXPECT_FALSE((sc::vector<double>{nan}) == (sc::vector<double>{nan}));
+  }
+#endif
+
+#if LEXICOGRAPHIC_ORDER
+  {
+    BEGIN_TEST(tm, "LexicographicOrder", "ordered like std::vector");
+
+    sc::vector<int> a{1, 2, 3};
+    sc::vector<int> b{1, 2, 4};
+    sc::vector<int> c{1, 2};
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(c < a);
+    EXPECT_TRUE(b > c);
+    EXPECT_TRUE(a <= a);
+    EXPECT_TRUE(a >= c);
+    EXPECT_FALSE(b < a);
+
+    // Signed and unsigned elements are ordered by value, not by bytes.
+    EXPECT_TRUE((sc::vector<int>{-1}) < (sc::vector<int>{1}));
+    EXPECT_TRUE((sc::vector<std::uint32_t>{0x100}) < (sc::vector<std::uint32_t>{0x1ff}));
+    EXPECT_TRUE((sc::vector<std::uint32_t>{0x01ff}) < (sc::vector<std::uint32_t>{0x0200}));
+
+    sc::vector<std::string> x{"apple", "pear"};
+    sc::vector<std::string> y{"apple", "plum"};
+    EXPECT_TRUE(same_as_std(x, y));
+    EXPECT_TRUE(same_as_std(y, x));
+    EXPECT_TRUE(same_as_std(x, x));
+  }
+#endif
+
+#if FAST_PATH_AGREES
+  {
+    BEGIN_TEST(tm, "FastPathAgrees", "memcmp path agrees with std::vector");
+
+    bool same{true};
+    // Differences at every position across page and cache line borders.
+    for (std::size_t n : {1ul, 15ul, 16ul, 17ul, 1023ul, 1024ul, 1025ul, 5000ul}) {
+      sc::vector<std::int32_t> base(n);
+      for (std::size_t i{0}; i < n; ++i)
+        base[i] = std::int32_t(i * 2654435761u);
+      for (std::size_t at : {std::size_t{0}, n / 3, n - 1}) {
+        sc::vector<std::int32_t> other{base};
+        other[at] ^= 1;
+        same = same && same_as_std(base, other) && same_as_std(other, base);
+        sc::vector<double> doubles(base.begin(), base.end());
+        sc::vector<double> other_doubles(other.begin(), other.end());
+        same = same && same_as_std(doubles, other_doubles);
+      }
+      sc::vector<std::int32_t> shorter(base.begin(), base.end() - 1);
+      same = same && same_as_std(base, base) && same_as_std(shorter, base);
+    }
+    EXPECT_TRUE(same);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
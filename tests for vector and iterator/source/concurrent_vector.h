@@ -0,0 +1,368 @@
+#ifndef _CONCURRENT_VECTOR_H_
+#define _CONCURRENT_VECTOR_H_
+
+#include <algorithm>        // std::equal, std::sort
+#include <atomic>           // std::atomic
+#include <cstddef>          // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <limits>           // std::numeric_limits
+#include <memory>           // std::allocator_traits
+#include <mutex>            // std::mutex, std::lock_guard
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <type_traits>      // std::enable_if_t
+#include <utility>          // std::move, std::forward, std::pair
+
+#include "segmented_vector.h" // detail::segment_position, SegmentedIterator
+#include "vector.h"           // sc::vector
+
+/// Sequence container namespace.
+namespace sc {
+/// A segmented vector that many threads can grow at the same time.
+/*!
+ * The layout is the one of `segmented_vector`: segments of
+ * `FirstSegment`, 2 * `FirstSegment`... slots that never move once
+ * allocated. On top of it:
+ *
+ * - push_back(), emplace_back() and grow_by() claim their slots with a
+ *   compare-and-swap on the atomic size, so threads never wait for each
+ *   other to append. The segments for the slots are published before the
+ *   claim, so an allocation that throws leaves size() as it was;
+ * - a thread that needs a segment nobody has published yet allocates it
+ *   and publishes it with a compare-and-swap; if another thread won the
+ *   race, it frees its own and uses the winner's. The allocator must then
+ *   be safe to call from several threads, as `std::allocator` is;
+ * - the segment directory is read with acquire loads, so an element that
+ *   a thread has finished constructing can be read by any thread that
+ *   learned its index from it, while the vector keeps growing.
+ *
+ * As with TBB's `concurrent_vector`, size() counts the slots claimed,
+ * some of which may still be under construction: knowing which elements
+ * are ready is up to the caller. A constructor that throws leaves its
+ * slot unconstructed but still counted; the slot is remembered, under a
+ * lock taken only on that path, and clear() and destruction skip it. It
+ * must not be read, so neither must the whole container be copied or
+ * compared while it has one. Copying, moving, assigning, clear() and
+ * destruction are not thread safe.
+ */
+template <typename T, typename Alloc = std::allocator<T>,
+          std::size_t FirstSegment = 16>
+class concurrent_vector {
+  static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0,
+                "FirstSegment must be a power of two");
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using entry = std::atomic<T *>;
+  /// log2 of `FirstSegment`.
+  static constexpr std::size_t first_log2 = detail::log2_of(FirstSegment);
+  /// Enough segments for any index.
+  static constexpr std::size_t max_segments = 8 * sizeof(std::size_t) - first_log2;
+
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using allocator_type = Alloc;    //!< The allocator type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+  using iterator = SegmentedIterator<value_type, entry>; //!< The iterator.
+  using const_iterator =
+      SegmentedIterator<const value_type, entry>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  concurrent_vector(void) = default;
+  explicit concurrent_vector(const Alloc &alloc_) : m_alloc{alloc_} {}
+  explicit concurrent_vector(size_type count_, const_reference value_ = T(),
+                             const Alloc &alloc_ = Alloc())
+      : m_alloc{alloc_} {
+    grow_by(count_, value_);
+  }
+  concurrent_vector(const std::initializer_list<T> &il,
+                    const Alloc &alloc_ = Alloc())
+      : m_alloc{alloc_} {
+    reserve(il.size());
+    for (const auto &value : il) {
+      push_back(value);
+    }
+  }
+  concurrent_vector(const concurrent_vector &other)
+      : m_alloc{alloc_traits::select_on_container_copy_construction(
+            other.m_alloc)} {
+    reserve(other.size());
+    for (const auto &value : other) {
+      push_back(value);
+    }
+  }
+  concurrent_vector(concurrent_vector &&other) noexcept
+      : m_alloc{std::move(other.m_alloc)} {
+    steal(other);
+  }
+  /// Copy assignment: the allocator follows `other` only if it asks to
+  /// propagate on copy, and our segments are reused if it stays the same.
+  concurrent_vector &operator=(const concurrent_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (m_alloc != other.m_alloc) {
+        // Our segments must go back to the allocator that gave them.
+        release();
+      }
+      m_alloc = other.m_alloc;
+    }
+    reserve(other.size());
+    for (const auto &value : other) {
+      push_back(value);
+    }
+    return *this;
+  }
+  concurrent_vector &operator=(concurrent_vector &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        m_alloc == other.m_alloc) {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        m_alloc = std::move(other.m_alloc);
+      }
+      steal(other);
+    } else {
+      clear();
+      for (auto &value : other) {
+        push_back(std::move(value));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+  virtual ~concurrent_vector(void) { release(); }
+
+  allocator_type get_allocator(void) const { return m_alloc; }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator{m_segments, first_log2, 0}; }
+  iterator end(void) { return iterator{m_segments, first_log2, size()}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const {
+    return const_iterator{m_segments, first_log2, 0};
+  }
+  const_iterator cend(void) const {
+    return const_iterator{m_segments, first_log2, size()};
+  }
+
+  // [III] Capacity
+  /// Slots claimed so far, including any still under construction.
+  size_type size(void) const { return m_size.load(std::memory_order_acquire); }
+  bool empty(void) const { return size() == 0; }
+  /// Publishes the segments needed for `capacity_` elements. Thread safe.
+  void reserve(size_type capacity_) {
+    if (capacity_ > 0) {
+      publish(0, capacity_);
+    }
+  }
+
+  // [IV] Modifiers
+  /// Destroys every element, skipping the slots whose constructor threw;
+  /// the segments stay. Not thread safe.
+  void clear(void) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      std::sort(m_broken.begin(), m_broken.end());
+      size_type idx{0};
+      for (const auto &gap : m_broken) {
+        for (; idx < gap.first; ++idx) {
+          alloc_traits::destroy(m_alloc, &(*this)[idx]);
+        }
+        idx = gap.second;
+      }
+      for (size_type last{size()}; idx < last; ++idx) {
+        alloc_traits::destroy(m_alloc, &(*this)[idx]);
+      }
+    }
+    m_broken.clear();
+    m_size.store(0, std::memory_order_relaxed);
+  }
+  /// Appends a copy of `value_`. Thread safe.
+  iterator push_back(const_reference value_) {
+    return emplace_at(claim(1), value_);
+  }
+  iterator push_back(value_type &&value_) {
+    return emplace_at(claim(1), std::move(value_));
+  }
+  /// Constructs a new element at the end. Thread safe.
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    return *emplace_at(claim(1), std::forward<Args>(args)...);
+  }
+  /// Appends `count_` copies of `value_` as one block, and returns an
+  /// iterator to the first of them. Thread safe.
+  iterator grow_by(size_type count_, const_reference value_ = T()) {
+    size_type first{claim(count_)};
+    size_type i{first};
+    try {
+      for (; i < first + count_; ++i) {
+        alloc_traits::construct(m_alloc, &(*this)[i], value_);
+      }
+    } catch (...) {
+      mark_broken(i, first + count_);
+      throw;
+    }
+    return iterator{m_segments, first_log2, first};
+  }
+
+  // [V] Element access
+  /// The `idx_`-th element, which must be constructed. Thread safe.
+  reference operator[](size_type idx_) {
+    auto pos = detail::segment_position::of(idx_, first_log2);
+    return m_segments[pos.segment].load(std::memory_order_acquire)[pos.offset];
+  }
+  const_reference operator[](size_type idx_) const {
+    auto pos = detail::segment_position::of(idx_, first_log2);
+    return m_segments[pos.segment].load(std::memory_order_acquire)[pos.offset];
+  }
+  reference at(size_type idx_) {
+    if (idx_ >= size()) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  const_reference at(size_type idx_) const {
+    if (idx_ >= size()) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+
+  // [VI] Operators
+  friend bool operator==(const concurrent_vector &lhs_,
+                         const concurrent_vector &rhs_) {
+    return lhs_.size() == rhs_.size() &&
+           std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+  }
+  friend bool operator!=(const concurrent_vector &lhs_,
+                         const concurrent_vector &rhs_) {
+    return !(lhs_ == rhs_);
+  }
+  friend std::ostream &operator<<(std::ostream &os_,
+                                  const concurrent_vector &v_) {
+    os_ << "[ ";
+    for (const auto &value : v_) {
+      os_ << value << " ";
+    }
+    os_ << "]";
+    return os_;
+  }
+  /// Not thread safe.
+  friend void swap(concurrent_vector &first_, concurrent_vector &second_) {
+    using std::swap;
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      swap(first_.m_alloc, second_.m_alloc);
+    }
+    for (size_type s{0}; s < max_segments; ++s) {
+      T *segment = first_.m_segments[s].load(std::memory_order_relaxed);
+      first_.m_segments[s].store(
+          second_.m_segments[s].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      second_.m_segments[s].store(segment, std::memory_order_relaxed);
+    }
+    size_type size = first_.m_size.load(std::memory_order_relaxed);
+    first_.m_size.store(second_.m_size.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    second_.m_size.store(size, std::memory_order_relaxed);
+    swap(first_.m_broken, second_.m_broken);
+  }
+
+private:
+  static size_type segment_size(size_type s_) { return FirstSegment << s_; }
+
+  /// Makes sure the segments for `count_` more slots exist, then claims
+  /// them at the end. If a segment cannot be allocated nothing is claimed,
+  /// so size() never counts a slot without storage.
+  size_type claim(size_type count_) {
+    size_type first = m_size.load(std::memory_order_acquire);
+    if (count_ == 0) {
+      return first;
+    }
+    for (;;) {
+      if (count_ > std::numeric_limits<size_type>::max() - first) {
+        throw std::length_error("Capacidade grande demais!");
+      }
+      publish(first, first + count_);
+      // On failure `first` is reloaded: another thread claimed it first.
+      if (m_size.compare_exchange_weak(first, first + count_,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+        return first;
+      }
+    }
+  }
+  /// Publishes every segment that holds an index in [first_, last_).
+  void publish(size_type first_, size_type last_) {
+    size_type top{detail::segment_position::of(last_ - 1, first_log2).segment};
+    if (top >= max_segments) {
+      throw std::length_error("Capacidade grande demais!");
+    }
+    for (size_type s{detail::segment_position::of(first_, first_log2).segment};
+         s <= top; ++s) {
+      if (m_segments[s].load(std::memory_order_acquire) != nullptr) {
+        continue;
+      }
+      T *fresh = alloc_traits::allocate(m_alloc, segment_size(s));
+      T *expected{nullptr};
+      if (!m_segments[s].compare_exchange_strong(expected, fresh,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+        // Another thread published this segment first.
+        alloc_traits::deallocate(m_alloc, fresh, segment_size(s));
+      }
+    }
+  }
+  template <typename... Args>
+  iterator emplace_at(size_type idx_, Args &&...args) {
+    try {
+      alloc_traits::construct(m_alloc, &(*this)[idx_],
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      mark_broken(idx_, idx_ + 1);
+      throw;
+    }
+    return iterator{m_segments, first_log2, idx_};
+  }
+  /// Remembers that the claimed slots [first_, last_) were never built.
+  void mark_broken(size_type first_, size_type last_) {
+    std::lock_guard<std::mutex> guard{m_broken_lock};
+    m_broken.push_back({first_, last_});
+  }
+
+  /// Destroys the elements and frees every segment.
+  void release(void) {
+    clear();
+    for (size_type s{0}; s < max_segments; ++s) {
+      if (T *segment = m_segments[s].exchange(nullptr)) {
+        alloc_traits::deallocate(m_alloc, segment, segment_size(s));
+      }
+    }
+  }
+  /// Takes the segments of `other`, leaving it empty.
+  void steal(concurrent_vector &other) {
+    for (size_type s{0}; s < max_segments; ++s) {
+      m_segments[s].store(other.m_segments[s].exchange(nullptr),
+                          std::memory_order_relaxed);
+    }
+    m_size.store(other.m_size.exchange(0), std::memory_order_relaxed);
+    m_broken = std::move(other.m_broken);
+    other.m_broken.clear();
+  }
+
+  Alloc m_alloc;                       //!< Allocates the segments.
+  entry m_segments[max_segments]{};    //!< Segment `s` has 2^(k+s) slots.
+  std::atomic<size_type> m_size{0};    //!< Slots claimed.
+  vector<std::pair<size_type, size_type>>
+      m_broken;             //!< Claimed slots whose constructor threw.
+  std::mutex m_broken_lock; //!< Guards `m_broken`.
+};
+} // namespace sc
+
+#endif
@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_vector.h"
+#include "test_helpers.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Twelfth batch of tests, focused on sc::concurrent_vector
+// =============================================================
+
+// Threads push_back() at the same time; nothing is lost or duplicated.
+#define CONCURRENT_PUSH YES
+// grow_by() hands each thread a block of its own.
+#define CONCURRENT_GROW_BY YES
+// Elements can be read while other threads keep appending.
+#define READ_WHILE_GROWING YES
+// Copy assignment keeps each side's memory resource.
+#define PMR_COPY_ASSIGN YES
+// An append whose segment cannot be allocated claims no slot.
+#define FAILED_CLAIM YES
+// A slot whose constructor threw is skipped by clear() and destruction.
+#define FAILED_CONSTRUCT YES
+
+namespace {
+constexpr int threads{8};           //!< Writer threads per test.
+constexpr int per_thread{20'000};   //!< Elements each writer appends.
+
+using test_helpers::Counted;
+using test_helpers::CountingResource;
+
+/// A Counted whose copy throws once `budget` copies have been made.
+struct Brittle : Counted {
+  inline static int budget{std::numeric_limits<int>::max()}; //!< Copies left.
+
+  Brittle(std::string v) : Counted{std::move(v)} {}
+  Brittle(const Brittle &other) : Counted{(spend(), other)} {}
+  static void spend(void) {
+    if (budget-- == 0)
+      throw std::runtime_error("out of copies");
+  }
+};
+} // namespace
+
+void run_concurrent_vector_tests(void) {
+  TestManager tm{"Concurrent vector testing"};
+
+#if CONCURRENT_PUSH
+  {
+    BEGIN_TEST(tm, "ConcurrentPush", "push_back from many threads");
+
+    sc::concurrent_vector<int> vec;
+    std::vector<std::thread> workers;
+    for (int t{0}; t < threads; ++t) {
+      workers.emplace_back([&vec, t] {
+        for (int i{0}; i < per_thread; ++i)
+          vec.push_back(t * per_thread + i);
+      });
+    }
+    for (auto &worker : workers)
+      worker.join();
+
+    EXPECT_EQ(vec.size(), threads * per_thread);
+    std::vector<int> seen(vec.begin(), vec.end());
+    std::sort(seen.begin(), seen.end());
+    bool each_once{true};
+    for (int i{0}; i < threads * per_thread; ++i)
+      each_once = each_once && seen[i] == i;
+    EXPECT_TRUE(each_once);
+
+    // Each thread's values keep their relative order.
+    std::vector<int> last(threads, -1);
+    bool ordered{true};
+    for (int v : vec) {
+      ordered = ordered && v > last[v / per_thread];
+      last[v / per_thread] = v;
+    }
+    EXPECT_TRUE(ordered);
+  }
+#endif
+
+#if CONCURRENT_GROW_BY
+  {
+    BEGIN_TEST(tm, "ConcurrentGrowBy", "grow_by returns a private block");
+
+    sc::concurrent_vector<std::string> vec;
+    std::vector<std::thread> workers;
+    for (int t{0}; t < threads; ++t) {
+      workers.emplace_back([&vec, t] {
+        for (int round{0}; round < 100; ++round) {
+          auto it = vec.grow_by(50, std::string(30, char('a' + t)));
+          for (int i{0}; i < 50; ++i)
+            it[i] += std::to_string(i); // Each block belongs to one thread.
+        }
+      });
+    }
+    for (auto &worker : workers)
+      worker.join();
+
+    EXPECT_EQ(vec.size(), threads * 100 * 50);
+    bool blocks{true};
+    for (std::size_t first{0}; first < vec.size(); first += 50) {
+      char owner = vec[first][0];
+      for (int i{0}; i < 50; ++i) {
+        const std::string &s = vec[first + i];
+        blocks = blocks && s[0] == owner && s.substr(30) == std::to_string(i);
+      }
+    }
+    EXPECT_TRUE(blocks);
+
+    sc::concurrent_vector<std::string> copy{vec};
+    EXPECT_EQ(copy, vec);
+    sc::concurrent_vector<std::string> moved{std::move(copy)};
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), vec.size());
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+  }
+#endif
+
+#if READ_WHILE_GROWING
+  {
+    BEGIN_TEST(tm, "ReadWhileGrowing", "stable reads during concurrent appends");
+
+    sc::concurrent_vector<long> vec;
+    std::atomic<long> published{-1};
+    std::atomic<bool> done{false};
+    // The reader checks elements the writer has announced as ready.
+    std::thread reader([&vec, &published, &done] {
+      long bad{0};
+      long earliest{-1};
+      const long *earliest_address{nullptr};
+      while (!done.load()) {
+        long idx = published.load(std::memory_order_acquire);
+        if (idx < 0)
+          continue;
+        if (earliest < 0) {
+          earliest = idx;
+          earliest_address = &vec[std::size_t(idx)];
+        }
+        bad += vec[std::size_t(idx)] != idx * 3;
+        // An older element neither moves nor changes.
+        bad += &vec[std::size_t(earliest)] != earliest_address;
+        bad += *earliest_address != earliest * 3;
+      }
+      published.store(bad);
+    });
+    std::vector<std::thread> writers;
+    for (int t{0}; t < threads; ++t) {
+      writers.emplace_back([&vec, t] {
+        for (int i{0}; i < per_thread; ++i)
+          vec.push_back(-1 - t); // Noise, never announced.
+      });
+    }
+    for (long i{0}; i < 100'000; ++i) {
+      // Only this thread announces; the noise lands in between.
+      auto it = vec.push_back(0);
+      *it = long(it - vec.begin()) * 3;
+      published.store(long(it - vec.begin()), std::memory_order_release);
+    }
+    for (auto &writer : writers)
+      writer.join();
+    done.store(true);
+    reader.join();
+    EXPECT_EQ(published.load(), 0);
+    EXPECT_EQ(vec.size(), 100'000 + threads * per_thread);
+  }
+#endif
+
+#if PMR_COPY_ASSIGN
+  {
+    BEGIN_TEST(tm, "PmrCopyAssign", "a = b keeps a's memory resource");
+
+    using concurrent =
+        sc::concurrent_vector<int, std::pmr::polymorphic_allocator<int>>;
+    EXPECT_TRUE(test_helpers::pmr_assign_and_swap<concurrent>());
+  }
+#endif
+
+#if FAILED_CLAIM
+  {
+    BEGIN_TEST(tm, "FailedClaim", "a failed allocation leaves size() alone");
+
+    using concurrent =
+        sc::concurrent_vector<Counted, std::pmr::polymorphic_allocator<Counted>>;
+    CountingResource memory;
+    {
+      concurrent vec{&memory};
+      vec.push_back(Counted{"0"});
+      // The first segment is in place; the second one cannot be allocated.
+      memory.budget = memory.live;
+      for (int i{1}; i < 16; ++i)
+        vec.push_back(Counted{std::to_string(i)});
+      bool threw{false};
+      try {
+        vec.push_back(Counted{"16"});
+      } catch (const std::bad_alloc &) {
+        threw = true;
+      }
+      EXPECT_TRUE(threw);
+      EXPECT_EQ(vec.size(), 16);
+      EXPECT_EQ(Counted::alive, 16);
+
+      threw = false;
+      try {
+        vec.grow_by(std::numeric_limits<concurrent::size_type>::max() - 8,
+                    Counted{"0"});
+      } catch (const std::length_error &) {
+        threw = true;
+      }
+      EXPECT_TRUE(threw);
+      EXPECT_EQ(vec.size(), 16);
+
+      memory.budget = std::numeric_limits<long>::max();
+      vec.push_back(Counted{"16"});
+      EXPECT_EQ(vec.size(), 17);
+      EXPECT_EQ(vec[16].value, "16");
+    }
+    // Only the slots that were built have been destroyed.
+    EXPECT_EQ(Counted::alive, 0);
+    EXPECT_EQ(memory.live, 0);
+  }
+#endif
+
+#if FAILED_CONSTRUCT
+  {
+    BEGIN_TEST(tm, "FailedConstruct", "a throwing constructor leaves a gap");
+
+    {
+      sc::concurrent_vector<Brittle> vec;
+      vec.push_back(Brittle{"0"});
+      Brittle::budget = 0;
+      bool threw{false};
+      try {
+        vec.push_back(vec[0]);
+      } catch (const std::runtime_error &) {
+        threw = true;
+      }
+      EXPECT_TRUE(threw);
+      EXPECT_EQ(vec.size(), 2);
+      EXPECT_EQ(Counted::alive, 1);
+
+      // The block keeps the copies made before the throw.
+      Brittle::budget = 2;
+      threw = false;
+      try {
+        vec.grow_by(5, Brittle{"x"});
+      } catch (const std::runtime_error &) {
+        threw = true;
+      }
+      EXPECT_TRUE(threw);
+      EXPECT_EQ(vec.size(), 7);
+      EXPECT_EQ(Counted::alive, 3);
+
+      Brittle::budget = std::numeric_limits<int>::max();
+      vec.push_back(Brittle{"7"});
+      EXPECT_EQ(vec[7].value, "7");
+      vec.clear();
+      EXPECT_EQ(Counted::alive, 0);
+
+      // The destructor skips the gaps too.
+      vec.push_back(Brittle{"0"});
+      Brittle::budget = 0;
+      try {
+        vec.emplace_back(vec[0]);
+      } catch (const std::runtime_error &) {
+      }
+      Brittle::budget = std::numeric_limits<int>::max();
+      vec.push_back(Brittle{"2"});
+      EXPECT_EQ(Counted::alive, 2);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,524 @@
+#ifndef _GAP_VECTOR_H_
+#define _GAP_VECTOR_H_
+
+#include <algorithm>        // std::equal, std::max
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <cstring>          // std::memcpy, std::memmove
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <iterator>         // std::distance, std::random_access_iterator_tag
+#include <memory>           // std::allocator_traits
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <type_traits>      // std::enable_if_t
+#include <utility>          // std::move, std::forward, std::move_if_noexcept
+
+#include "vector.h" // sc::vector, sc::is_trivially_relocatable, sc::growth
+
+/// Sequence container namespace.
+namespace sc {
+/// Random access iterator over a gap buffer, stepping over the gap.
+/*!
+ * The iterator holds a logical index; dereferencing adds the gap length
+ * to indices at or past the gap. `T` may be const.
+ */
+template <class T> class GapIterator {
+public:
+  using iterator = GapIterator; //!< Alias to iterator.
+  typedef std::ptrdiff_t difference_type; //!< Distance between iterators.
+  typedef std::remove_cv_t<T> value_type; //!< Value type the iterator points to.
+  typedef T *pointer;                     //!< Pointer to the value type.
+  typedef T &reference;                   //!< Reference to the value type.
+  typedef std::random_access_iterator_tag
+      iterator_category; //!< Iterator category.
+
+  constexpr GapIterator(void) = default;
+  /*! Iterator to the `idx_`-th element of a buffer at `base_`.
+   * \param gap_begin_ first slot of the gap.
+   * \param gap_size_ number of slots in the gap.
+   */
+  constexpr GapIterator(pointer base_, std::size_t gap_begin_,
+                        std::size_t gap_size_, std::size_t idx_)
+      : m_base{base_}, m_gap_begin{gap_begin_}, m_gap_size{gap_size_},
+        m_idx{idx_} {}
+
+  /// Converts an iterator into a const iterator, never the other way.
+  template <class U, typename = std::enable_if_t<
+                         std::is_convertible<U *, T *>::value &&
+                         !std::is_same<U, T>::value>>
+  constexpr GapIterator(const GapIterator<U> &other)
+      : m_base{other.m_base}, m_gap_begin{other.m_gap_begin},
+        m_gap_size{other.m_gap_size}, m_idx{other.m_idx} {}
+
+  constexpr reference operator*(void) const { return *slot(m_idx); }
+  constexpr pointer operator->(void) const { return slot(m_idx); }
+  constexpr reference operator[](difference_type offset) const {
+    return *slot(m_idx + offset);
+  }
+
+  constexpr iterator &operator++(void) {
+    ++m_idx;
+    return *this;
+  }
+  constexpr iterator operator++(int) {
+    iterator dummy{*this};
+    ++m_idx;
+    return dummy;
+  }
+  constexpr iterator &operator--(void) {
+    --m_idx;
+    return *this;
+  }
+  constexpr iterator operator--(int) {
+    iterator dummy{*this};
+    --m_idx;
+    return dummy;
+  }
+  constexpr iterator &operator+=(difference_type offset) {
+    m_idx += offset;
+    return *this;
+  }
+  constexpr iterator &operator-=(difference_type offset) {
+    m_idx -= offset;
+    return *this;
+  }
+
+  friend constexpr iterator operator+(difference_type offset, iterator it) {
+    return it += offset;
+  }
+  friend constexpr iterator operator+(iterator it, difference_type offset) {
+    return it += offset;
+  }
+  friend constexpr iterator operator-(iterator it, difference_type offset) {
+    return it -= offset;
+  }
+  friend constexpr difference_type operator-(const iterator &lhs_,
+                                             const iterator &rhs_) {
+    return difference_type(lhs_.m_idx - rhs_.m_idx);
+  }
+
+  // Iterators into the same buffer compare by index.
+  friend constexpr bool operator==(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx == rhs_.m_idx;
+  }
+  friend constexpr bool operator!=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx != rhs_.m_idx;
+  }
+  friend constexpr bool operator<(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx < rhs_.m_idx;
+  }
+  friend constexpr bool operator>(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx > rhs_.m_idx;
+  }
+  friend constexpr bool operator<=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx <= rhs_.m_idx;
+  }
+  friend constexpr bool operator>=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx >= rhs_.m_idx;
+  }
+
+  /// Index of the element the iterator points to.
+  constexpr std::size_t index(void) const { return m_idx; }
+
+private:
+  constexpr pointer slot(std::size_t idx_) const {
+    return m_base + idx_ + (idx_ < m_gap_begin ? 0 : m_gap_size);
+  }
+
+  pointer m_base{nullptr};    //!< Start of the buffer.
+  std::size_t m_gap_begin{0}; //!< First slot of the gap.
+  std::size_t m_gap_size{0};  //!< Number of slots in the gap.
+  std::size_t m_idx{0};       //!< Index of the element.
+
+  template <class U> friend class GapIterator;
+};
+
+/// A sequence with a movable hole in its buffer, for edits around a cursor.
+/*!
+ * The elements sit at both ends of the buffer, with the free slots (the
+ * gap) between them. An insert or erase first moves the gap to where the
+ * edit happens, shifting only the elements between the old and the new
+ * position with a single memmove() (one by one for types that are not
+ * trivially relocatable), and then costs O(1). A burst of edits around
+ * the same position therefore pays for one shift, not one per edit.
+ *
+ * The buffer is the spare capacity of an empty `sc::vector`, which owns
+ * it; when the gap runs out, the buffer grows by `GrowthPolicy`.
+ * Any edit invalidates the iterators, as with `sc::vector`.
+ */
+template <typename T, typename Alloc = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling>
+class gap_vector {
+  using alloc_traits = std::allocator_traits<Alloc>;
+  static constexpr bool relocatable = is_trivially_relocatable<T>::value;
+
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using allocator_type = Alloc;    //!< The allocator type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+  using iterator = GapIterator<value_type>;   //!< The iterator.
+  using const_iterator =
+      GapIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  gap_vector(void) = default;
+  explicit gap_vector(const Alloc &alloc_) : m_slots{alloc_} {}
+  explicit gap_vector(size_type count_, const_reference value_ = T(),
+                      const Alloc &alloc_ = Alloc())
+      : m_slots{alloc_} {
+    reserve(count_);
+    for (size_type i{0}; i < count_; ++i) {
+      emplace_back(value_);
+    }
+  }
+  gap_vector(const std::initializer_list<T> &il, const Alloc &alloc_ = Alloc())
+      : gap_vector(il.begin(), il.end(), alloc_) {}
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  gap_vector(InputItr first_, InputItr last_, const Alloc &alloc_ = Alloc())
+      : m_slots{alloc_} {
+    insert(end(), first_, last_);
+  }
+  gap_vector(const gap_vector &other)
+      : m_slots{alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())} {
+    reserve(other.size());
+    for (const auto &value : other) {
+      emplace_back(value);
+    }
+  }
+  gap_vector(gap_vector &&other) noexcept
+      : m_slots{std::move(other.m_slots)}, m_gap_begin{other.m_gap_begin},
+        m_gap_end{other.m_gap_end} {
+    other.m_gap_begin = 0;
+    other.m_gap_end = 0;
+  }
+  /// Copy assignment: the allocator follows `other` only if it asks to
+  /// propagate on copy, and our buffer is reused when it is large enough.
+  gap_vector &operator=(const gap_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    // `m_slots` holds no elements: this only settles the allocator, giving
+    // the buffer back first if it changes.
+    m_slots = other.m_slots;
+    m_gap_end = capacity();
+    reserve(other.size());
+    for (const auto &value : other) {
+      emplace_back(value);
+    }
+    return *this;
+  }
+  gap_vector &operator=(gap_vector &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        get_allocator() == other.get_allocator()) {
+      // The buffer changes hands.
+      m_slots = std::move(other.m_slots);
+      m_gap_begin = other.m_gap_begin;
+      m_gap_end = other.m_gap_end;
+      other.m_gap_begin = 0;
+      other.m_gap_end = 0;
+    } else {
+      reserve(other.size());
+      for (auto &value : other) {
+        emplace_back(std::move(value));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+  virtual ~gap_vector(void) { clear(); }
+
+  allocator_type get_allocator(void) const { return m_slots.get_allocator(); }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return make_iterator(0); }
+  iterator end(void) { return make_iterator(size()); }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const {
+    return const_iterator{slots(), m_gap_begin, gap_size(), 0};
+  }
+  const_iterator cend(void) const {
+    return const_iterator{slots(), m_gap_begin, gap_size(), size()};
+  }
+
+  // [III] Capacity
+  size_type size(void) const { return capacity() - gap_size(); }
+  size_type capacity(void) const { return m_slots.capacity(); }
+  bool empty(void) const { return size() == 0; }
+  /// Index the gap is at: where the last edit happened.
+  size_type cursor(void) const { return m_gap_begin; }
+  void reserve(size_type new_capacity_) {
+    if (new_capacity_ > capacity()) {
+      reallocate(new_capacity_);
+    }
+  }
+
+  // [IV] Modifiers
+  void clear(void) {
+    destroy(slots(), m_gap_begin);
+    destroy(slots() + m_gap_end, capacity() - m_gap_end);
+    m_gap_begin = 0;
+    m_gap_end = capacity();
+  }
+  void push_back(const_reference value_) { emplace_back(value_); }
+  void push_back(value_type &&value_) { emplace_back(std::move(value_)); }
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    return *emplace_at(size(), std::forward<Args>(args)...);
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    erase_at(size() - 1, 1);
+  }
+
+  iterator insert(const_iterator pos_, const_reference value_) {
+    return emplace_at(pos_.index(), value_);
+  }
+  iterator insert(const_iterator pos_, value_type &&value_) {
+    return emplace_at(pos_.index(), std::move(value_));
+  }
+  template <typename... Args>
+  iterator emplace(const_iterator pos_, Args &&...args) {
+    return emplace_at(pos_.index(), std::forward<Args>(args)...);
+  }
+  /// Inserts `[first_, last_)` before `pos_`, which must not point into it.
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  iterator insert(const_iterator pos_, InputItr first_, InputItr last_) {
+    size_type idx{pos_.index()};
+    check_index(idx);
+    using category = typename std::iterator_traits<InputItr>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+      make_room(size_type(std::distance(first_, last_)));
+    }
+    move_gap(idx);
+    for (; first_ != last_; ++first_) {
+      make_room(1);
+      construct(slots() + m_gap_begin, *first_);
+      ++m_gap_begin;
+    }
+    return make_iterator(idx);
+  }
+  iterator insert(const_iterator pos_, const std::initializer_list<T> &il) {
+    return insert(pos_, il.begin(), il.end());
+  }
+
+  iterator erase(const_iterator pos_) {
+    if (pos_.index() >= size()) {
+      throw std::out_of_range("Não existe essa posição no vector");
+    }
+    return erase_at(pos_.index(), 1);
+  }
+  iterator erase(const_iterator first_, const_iterator last_) {
+    if (first_ > last_ || last_.index() > size()) {
+      throw std::out_of_range("Não existe esse intervalo no vector");
+    }
+    return erase_at(first_.index(), size_type(last_ - first_));
+  }
+
+  // [V] Element access
+  reference operator[](size_type idx_) { return *slot(idx_); }
+  const_reference operator[](size_type idx_) const { return *slot(idx_); }
+  reference at(size_type idx_) {
+    if (idx_ >= size()) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return *slot(idx_);
+  }
+  const_reference at(size_type idx_) const {
+    if (idx_ >= size()) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return *slot(idx_);
+  }
+  reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return *slot(0);
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return *slot(0);
+  }
+  reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return *slot(size() - 1);
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return *slot(size() - 1);
+  }
+
+  // [VI] Operators
+  friend bool operator==(const gap_vector &lhs_, const gap_vector &rhs_) {
+    return lhs_.size() == rhs_.size() &&
+           std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+  }
+  friend bool operator!=(const gap_vector &lhs_, const gap_vector &rhs_) {
+    return !(lhs_ == rhs_);
+  }
+  friend std::ostream &operator<<(std::ostream &os_, const gap_vector &v_) {
+    os_ << "[ ";
+    for (const auto &value : v_) {
+      os_ << value << " ";
+    }
+    os_ << "]";
+    return os_;
+  }
+  friend void swap(gap_vector &first_, gap_vector &second_) {
+    using std::swap;
+    swap(first_.m_slots, second_.m_slots);
+    swap(first_.m_gap_begin, second_.m_gap_begin);
+    swap(first_.m_gap_end, second_.m_gap_end);
+  }
+
+private:
+  pointer slots(void) { return m_slots.data(); }
+  const T *slots(void) const { return m_slots.data(); }
+  size_type gap_size(void) const { return m_gap_end - m_gap_begin; }
+  pointer slot(size_type idx_) {
+    return slots() + idx_ + (idx_ < m_gap_begin ? 0 : gap_size());
+  }
+  const T *slot(size_type idx_) const {
+    return slots() + idx_ + (idx_ < m_gap_begin ? 0 : gap_size());
+  }
+  iterator make_iterator(size_type idx_) {
+    return iterator{slots(), m_gap_begin, gap_size(), idx_};
+  }
+  void check_index(size_type idx_) const {
+    if (idx_ > size()) {
+      throw std::length_error("Não existe essa posição no vector");
+    }
+  }
+
+  template <typename... Args>
+  iterator emplace_at(size_type idx_, Args &&...args) {
+    check_index(idx_);
+    if (gap_size() == 0 || idx_ != m_gap_begin) {
+      // Build the value first: `args` may refer to one of our own elements.
+      T value(std::forward<Args>(args)...);
+      make_room(1);
+      move_gap(idx_);
+      construct(slots() + m_gap_begin, std::move(value));
+    } else {
+      construct(slots() + m_gap_begin, std::forward<Args>(args)...);
+    }
+    ++m_gap_begin;
+    return make_iterator(idx_);
+  }
+  iterator erase_at(size_type idx_, size_type count_) {
+    move_gap(idx_);
+    destroy(slots() + m_gap_end, count_);
+    m_gap_end += count_;
+    return make_iterator(idx_);
+  }
+
+  /// Moves the gap so that it starts at index `idx_`.
+  void move_gap(size_type idx_) {
+    if (idx_ < m_gap_begin) {
+      // The elements in [idx_, gap begin) go to the end of the gap.
+      size_type count{m_gap_begin - idx_};
+      shift(slots() + idx_, count, slots() + m_gap_end - count);
+      m_gap_begin -= count;
+      m_gap_end -= count;
+    } else if (idx_ > m_gap_begin) {
+      // The first elements after the gap go to its start.
+      size_type count{idx_ - m_gap_begin};
+      shift(slots() + m_gap_end, count, slots() + m_gap_begin);
+      m_gap_begin += count;
+      m_gap_end += count;
+    }
+  }
+  /// Moves `count_` elements from `src_` to the possibly overlapping `dst_`.
+  void shift(pointer src_, size_type count_, pointer dst_) {
+    if constexpr (relocatable) {
+      std::memmove(static_cast<void *>(dst_), static_cast<const void *>(src_),
+                   count_ * sizeof(T));
+    } else if (dst_ > src_) {
+      // Back to front, so each target slot is free by the time we get there.
+      for (size_type i{count_}; i-- > 0;) {
+        construct(dst_ + i, std::move_if_noexcept(src_[i]));
+        destroy(src_ + i, 1);
+      }
+    } else {
+      for (size_type i{0}; i < count_; ++i) {
+        construct(dst_ + i, std::move_if_noexcept(src_[i]));
+        destroy(src_ + i, 1);
+      }
+    }
+  }
+
+  /// Grows the buffer, if needed, so that the gap holds `count_` slots.
+  void make_room(size_type count_) {
+    if (gap_size() < count_) {
+      reallocate(std::max<size_type>(
+          size() + count_, GrowthPolicy::next(capacity(), size() + count_,
+                                              sizeof(T))));
+    }
+  }
+  /// Moves the elements into a buffer of `new_capacity_` slots; the gap
+  /// stays at the same index.
+  void reallocate(size_type new_capacity_) {
+    vector<T, Alloc> buffer{get_allocator()};
+    buffer.reserve(new_capacity_);
+    size_type tail{capacity() - m_gap_end};
+    size_type new_gap_end{new_capacity_ - tail};
+    relocate(slots(), m_gap_begin, buffer.data());
+    relocate(slots() + m_gap_end, tail, buffer.data() + new_gap_end);
+    m_slots = std::move(buffer);
+    m_gap_end = new_gap_end;
+  }
+  /// Moves `count_` elements to a separate buffer at `dst_`.
+  void relocate(pointer src_, size_type count_, pointer dst_) {
+    if constexpr (relocatable) {
+      if (count_ > 0) {
+        std::memcpy(static_cast<void *>(dst_), static_cast<const void *>(src_),
+                    count_ * sizeof(T));
+      }
+    } else {
+      for (size_type i{0}; i < count_; ++i) {
+        construct(dst_ + i, std::move_if_noexcept(src_[i]));
+      }
+      destroy(src_, count_);
+    }
+  }
+
+  template <typename... Args> void construct(pointer ptr_, Args &&...args) {
+    allocator_type alloc{get_allocator()};
+    alloc_traits::construct(alloc, ptr_, std::forward<Args>(args)...);
+  }
+  void destroy(pointer first_, size_type count_) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      allocator_type alloc{get_allocator()};
+      for (size_type i{0}; i < count_; ++i) {
+        alloc_traits::destroy(alloc, first_ + i);
+      }
+    }
+  }
+
+  vector<T, Alloc> m_slots; //!< Owns the buffer; it never holds elements.
+  size_type m_gap_begin{0}; //!< First slot of the gap.
+  size_type m_gap_end{0};   //!< One past the last slot of the gap.
+};
+} // namespace sc
+
+#endif
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gap_vector.h"
+#include "test_helpers.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Ninth batch of tests, focused on sc::gap_vector
+// =============================================================
+
+// Same results as std::vector for a random mix of edits.
+#define GAP_EDITS YES
+// Edits at the cursor neither move the gap nor reallocate.
+#define CURSOR_EDITS YES
+// The iterator steps over the gap.
+#define GAP_ITERATOR YES
+// Non-trivial elements are built and destroyed exactly once.
+#define GAP_LIFETIME YES
+// Copy assignment keeps each side's memory resource.
+#define PMR_COPY_ASSIGN YES
+
+namespace {
+using test_helpers::Counted;
+using test_helpers::CountingResource;
+
+/// Whether `gap_` holds the same elements as `model_`.
+template <typename T>
+bool same(const sc::gap_vector<T> &gap_, const std::vector<T> &model_) {
+  return gap_.size() == model_.size() &&
+         std::equal(model_.begin(), model_.end(), gap_.begin());
+}
+} // namespace
+
+void run_gap_vector_tests(void) {
+  TestManager tm{"Gap vector testing"};
+
+#if GAP_EDITS
+  {
+    BEGIN_TEST(tm, "GapEdits", "insert/erase anywhere, checked against std::vector");
+
+    std::mt19937 gen{7};
+    sc::gap_vector<std::string> gap;
+    std::vector<std::string> model;
+    bool matched{true};
+    for (int step{0}; step < 2000; ++step) {
+      std::size_t pos = gen() % (model.size() + 1);
+      std::string item = std::to_string(step);
+      switch (gen() % 4) {
+      case 0:
+      case 1:
+        gap.insert(gap.begin() + pos, item);
+        model.insert(model.begin() + pos, item);
+        break;
+      case 2:
+        if (pos < model.size()) {
+          gap.erase(gap.begin() + pos);
+          model.erase(model.begin() + pos);
+        }
+        break;
+      default:
+        gap.push_back(item);
+        model.push_back(item);
+      }
+      matched = matched && same(gap, model);
+    }
+    EXPECT_TRUE(matched);
+
+    gap.erase(gap.begin() + 10, gap.begin() + 20);
+    model.erase(model.begin() + 10, model.begin() + 20);
+    gap.insert(gap.begin() + 5, {"a", "b", "c"});
+    model.insert(model.begin() + 5, {"a", "b", "c"});
+    const std::vector<std::string> head(model.begin(), model.begin() + 3);
+    gap.insert(gap.begin(), head.begin(), head.end());
+    model.insert(model.begin(), head.begin(), head.end());
+    EXPECT_TRUE(same(gap, model));
+    EXPECT_EQ(gap.front(), model.front());
+    EXPECT_EQ(gap.back(), model.back());
+    EXPECT_EQ(gap.at(7), model.at(7));
+
+    // An argument that refers to the container itself.
+    gap.insert(gap.begin() + 2, gap[gap.size() - 1]);
+    model.insert(model.begin() + 2, model[model.size() - 1]);
+    gap.pop_back();
+    model.pop_back();
+    EXPECT_TRUE(same(gap, model));
+
+    bool thrown{false};
+    try {
+      gap.at(gap.size());
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+#if CURSOR_EDITS
+  {
+    BEGIN_TEST(tm, "CursorEdits", "typing and deleting at the cursor");
+
+    sc::gap_vector<char> text;
+    for (char c : std::string{"hello world"})
+      text.push_back(c);
+    text.reserve(64);
+    const char *buffer = &text[0];
+
+    // Type in the middle: the gap moves once, then every char is O(1).
+    text.insert(text.begin() + 5, ',');
+    EXPECT_EQ(text.cursor(), 6);
+    for (char c : std::string{" dear"})
+      text.insert(text.begin() + text.cursor(), c);
+    EXPECT_EQ(text.cursor(), 11);
+    // Backspace twice, then delete forward once.
+    text.erase(text.begin() + text.cursor() - 1);
+    text.erase(text.begin() + text.cursor() - 1);
+    text.erase(text.begin() + text.cursor());
+    EXPECT_EQ(text.cursor(), 9);
+
+    std::string result(text.begin(), text.end());
+    EXPECT_EQ(result, "hello, deworld");
+    EXPECT_EQ(text.capacity(), 64);
+    EXPECT_EQ(&text[0], buffer);
+  }
+#endif
+
+#if GAP_ITERATOR
+  {
+    BEGIN_TEST(tm, "GapIterator", "random access over both sides of the gap");
+
+    using iterator = sc::gap_vector<int>::iterator;
+    static_assert(std::is_same<std::iterator_traits<iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "random access iterator");
+    static_assert(std::is_convertible<iterator,
+                                      sc::gap_vector<int>::const_iterator>::value,
+                  "iterator converts to const_iterator");
+
+    sc::gap_vector<int> vec{9, 3, 7, 1, 5, 8};
+    vec.insert(vec.begin() + 3, 4); // The gap is now after the 4.
+    EXPECT_EQ(vec.cursor(), 4);
+    auto it = vec.begin();
+    EXPECT_EQ(it[3], 4);
+    EXPECT_EQ(*(it + 4), 1);
+    EXPECT_EQ(vec.end() - vec.begin(), 7);
+    EXPECT_EQ(std::distance(vec.cbegin(), vec.cend()), 7);
+
+    std::sort(vec.begin(), vec.end());
+    EXPECT_EQ(vec, (sc::gap_vector<int>{1, 3, 4, 5, 7, 8, 9}));
+    EXPECT_TRUE(std::binary_search(vec.cbegin(), vec.cend(), 8));
+    EXPECT_EQ(*std::max_element(vec.begin(), vec.end()), 9);
+  }
+#endif
+
+#if GAP_LIFETIME
+  {
+    BEGIN_TEST(tm, "GapLifetime", "ctor/dtor calls are balanced");
+
+    {
+      sc::gap_vector<Counted> vec;
+      for (int i{0}; i < 20; ++i)
+        vec.emplace(vec.begin() + i / 2, std::string(20, char('a' + i)));
+      EXPECT_EQ(Counted::alive, 20);
+      vec.erase(vec.begin() + 3, vec.begin() + 8);
+      vec.erase(vec.begin() + 12);
+      EXPECT_EQ(Counted::alive, 14);
+
+      sc::gap_vector<Counted> copy{vec};
+      EXPECT_EQ(Counted::alive, 28);
+      EXPECT_EQ(copy, vec);
+      sc::gap_vector<Counted> moved{std::move(copy)};
+      EXPECT_TRUE(copy.empty());
+      copy = moved;
+      moved = std::move(vec);
+      EXPECT_EQ(Counted::alive, 28);
+      swap(moved, copy);
+      moved.clear();
+      EXPECT_EQ(Counted::alive, 14);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+  }
+#endif
+
+#if PMR_COPY_ASSIGN
+  {
+    BEGIN_TEST(tm, "PmrCopyAssign", "a = b keeps a's memory resource");
+
+    using gap = sc::gap_vector<int, std::pmr::polymorphic_allocator<int>>;
+    EXPECT_TRUE(test_helpers::pmr_assign_and_swap<gap>());
+
+    CountingResource left, right;
+    {
+      gap a{&left};
+      gap b({1, 2, 3, 4, 5}, &right);
+      a = b;
+      EXPECT_EQ(left.live, long(a.capacity() * sizeof(int)));
+      EXPECT_EQ(right.live, long(b.capacity() * sizeof(int)));
+
+      // A buffer that is large enough is reused.
+      long before{left.live};
+      b.erase(b.begin());
+      a = b;
+      EXPECT_EQ(a, b);
+      EXPECT_EQ(left.live, before);
+    }
+    EXPECT_EQ(left.live, 0);
+    EXPECT_EQ(right.live, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
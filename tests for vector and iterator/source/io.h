@@ -0,0 +1,97 @@
+#ifndef _IO_H_
+#define _IO_H_
+
+#include <algorithm>    // std::min
+#include <cerrno>       // errno, EINTR
+#include <climits>      // IOV_MAX
+#include <cstddef>      // std::size_t
+#include <system_error> // std::system_error
+#include <type_traits>  // std::is_trivially_copyable
+
+#include <sys/uio.h> // readv, iovec
+#include <unistd.h>  // read
+
+#include "vector.h" // sc::vector
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+/// Throws the `std::system_error` for the current `errno`.
+[[noreturn]] inline void throw_errno(const char *what_) {
+  throw std::system_error(errno, std::generic_category(), what_);
+}
+
+/// Types `read()` can fill a byte at a time: `char`, `std::byte` and such.
+template <typename T>
+constexpr bool is_byte_like_v = sizeof(T) == 1 &&
+                                std::is_trivially_copyable<T>::value &&
+                                std::is_trivially_default_constructible<T>::value;
+} // namespace detail
+
+/*! Reads at most `max_` bytes from `fd_` straight into the spare capacity
+ * of `vec_`, growing it first the way `push_back()` would, and keeps only
+ * the bytes actually read. Nothing is zeroed and nothing is copied, so a
+ * loop of these is the whole cost of ingesting a file or a socket.
+ * \return how many bytes were appended: 0 at end of file.
+ * \throw std::system_error if `read()` fails; interrupted calls are retried.
+ */
+template <typename T, typename Alloc, typename Growth, std::size_t InlineN>
+std::size_t read_append(int fd_, vector<T, Alloc, Growth, InlineN> &vec_,
+                        std::size_t max_) {
+  static_assert(detail::is_byte_like_v<T>, "read_append fills byte buffers");
+  std::size_t old_size = vec_.size();
+  T *dst = vec_.append_uninitialized(max_);
+  ssize_t got;
+  do {
+    got = ::read(fd_, dst, max_);
+  } while (got < 0 && errno == EINTR);
+  int error = errno;
+  vec_.resize_for_overwrite(old_size + (got > 0 ? std::size_t(got) : 0));
+  if (got < 0) {
+    errno = error;
+    detail::throw_errno("não foi possível ler do arquivo");
+  }
+  return std::size_t(got);
+}
+
+/*! Scatters one `readv()` from `fd_` into the spare capacity of the
+ * vectors in [`first_`, `last_`): the first one is filled up to its
+ * capacity, then the next, and so on. The vectors never grow; reserve
+ * first how much each one should take.
+ * \return how many bytes were appended, in all: 0 at end of file.
+ * \throw std::system_error if `readv()` fails; interrupted calls are retried.
+ */
+template <typename VecItr>
+std::size_t readv_into(int fd_, VecItr first_, VecItr last_) {
+  using value_type = typename std::decay_t<decltype(*first_)>::value_type;
+  static_assert(detail::is_byte_like_v<value_type>,
+                "readv_into fills byte buffers");
+  ::iovec iov[IOV_MAX];
+  int count{0};
+  for (VecItr it = first_; it != last_ && count < IOV_MAX; ++it) {
+    std::size_t spare = it->capacity() - it->size();
+    if (spare > 0) {
+      iov[count++] = {it->data() + it->size(), spare};
+    }
+  }
+  if (count == 0) {
+    return 0;
+  }
+  ssize_t got;
+  do {
+    got = ::readv(fd_, iov, count);
+  } while (got < 0 && errno == EINTR);
+  if (got < 0) {
+    detail::throw_errno("não foi possível ler do arquivo");
+  }
+  auto left = std::size_t(got);
+  for (; first_ != last_ && left > 0; ++first_) {
+    std::size_t take = std::min(left, first_->capacity() - first_->size());
+    first_->resize_for_overwrite(first_->size() + take);
+    left -= take;
+  }
+  return std::size_t(got);
+}
+} // namespace sc
+
+#endif
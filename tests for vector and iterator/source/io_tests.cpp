@@ -0,0 +1,157 @@
+#include <cstddef>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#include <unistd.h>
+
+#include "io.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Nineteenth batch of tests, focused on reading into spare capacity
+// =============================================================
+
+// resize_for_overwrite() and append_uninitialized() keep their contract.
+#define UNINITIALIZED_GROWTH YES
+// read_append() keeps exactly the bytes read.
+#define READ_APPEND YES
+// readv_into() fills one buffer after the other.
+#define READV_INTO YES
+
+namespace {
+/// A scratch file path holding `text_`, unique to this process.
+std::string scratch_file(const std::string &name_, const std::string &text_) {
+  std::string path =
+      "/tmp/sc_io_" + std::to_string(::getpid()) + "_" + name_;
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  std::fwrite(text_.data(), 1, text_.size(), file);
+  std::fclose(file);
+  return path;
+}
+
+std::string as_string(const sc::vector<char> &vec_) {
+  return std::string(vec_.data(), vec_.size());
+}
+} // namespace
+
+void run_io_tests(void) {
+  TestManager tm{"I/O into spare capacity testing"};
+
+#if UNINITIALIZED_GROWTH
+  {
+    BEGIN_TEST(tm, "UninitializedGrowth", "no value-initialization, same contents");
+
+    sc::vector<int> ints{1, 2, 3};
+    int *fresh = ints.append_uninitialized(4);
+    EXPECT_EQ(fresh, ints.data() + 3);
+    EXPECT_EQ(ints.size(), 7ul);
+    for (int i{0}; i < 4; ++i) {
+      fresh[i] = 10 + i;
+    }
+    EXPECT_TRUE(ints == (sc::vector<int>{1, 2, 3, 10, 11, 12, 13}));
+    ints.resize_for_overwrite(2);
+    EXPECT_TRUE(ints == (sc::vector<int>{1, 2}));
+    // Growing back within the capacity neither moves nor touches the
+    // elements; the new ones hold indeterminate values until written.
+    const int *storage = ints.data();
+    ints.resize_for_overwrite(4);
+    EXPECT_EQ(ints.size(), 4ul);
+    EXPECT_EQ(ints.data(), storage);
+    ints[2] = 20;
+    ints[3] = 21;
+    EXPECT_TRUE(ints == (sc::vector<int>{1, 2, 20, 21}));
+
+    // Appending a little at a time grows geometrically.
+    sc::vector<char> bytes;
+    std::size_t reallocations{0};
+    const char *last = nullptr;
+    for (int i{0}; i < 10'000; ++i) {
+      bytes.append_uninitialized(3);
+      if (bytes.data() != last) {
+        ++reallocations;
+        last = bytes.data();
+      }
+    }
+    EXPECT_TRUE(reallocations < 30);
+
+    // Other types are still default-constructed.
+    sc::vector<std::string> words{"a"};
+    words.resize_for_overwrite(3);
+    EXPECT_EQ(words.size(), 3ul);
+    EXPECT_TRUE(words[1].empty() && words[2].empty());
+    words.resize_for_overwrite(1);
+    EXPECT_EQ(words.back(), std::string{"a"});
+  }
+#endif
+
+#if READ_APPEND
+  {
+    BEGIN_TEST(tm, "ReadAppend", "appends what read() returned");
+
+    std::string text;
+    for (int i{0}; i < 5000; ++i) {
+      text += char('a' + i % 26);
+    }
+    std::string path = scratch_file("read_append", text);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    sc::vector<char> buffer{'>'};
+    std::size_t got{0};
+    std::size_t total{0};
+    while ((got = sc::read_append(fd, buffer, 777)) > 0) {
+      total += got;
+      EXPECT_EQ(buffer.size(), total + 1);
+    }
+    EXPECT_EQ(total, text.size());
+    EXPECT_EQ(as_string(buffer), ">" + text);
+    // At end of file nothing is appended.
+    EXPECT_EQ(sc::read_append(fd, buffer, 100), 0ul);
+    EXPECT_EQ(buffer.size(), text.size() + 1);
+    ::close(fd);
+    std::remove(path.c_str());
+
+    // A bad descriptor throws and leaves the vector as it was.
+    bool thrown{false};
+    try {
+      sc::read_append(-1, buffer, 100);
+    } catch (const std::system_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(buffer.size(), text.size() + 1);
+  }
+#endif
+
+#if READV_INTO
+  {
+    BEGIN_TEST(tm, "ReadvInto", "fills each buffer's spare capacity in turn");
+
+    std::string path = scratch_file("readv", "HEADERbody of the message");
+    int fd = ::open(path.c_str(), O_RDONLY);
+    sc::vector<sc::vector<char>> parts(3);
+    parts[0].reserve(6);
+    parts[2].reserve(100);
+    // The middle buffer has no room: it is skipped.
+    std::size_t got = sc::readv_into(fd, parts.begin(), parts.end());
+    EXPECT_EQ(got, 25ul);
+    EXPECT_EQ(as_string(parts[0]), std::string{"HEADER"});
+    EXPECT_TRUE(parts[1].empty());
+    EXPECT_EQ(as_string(parts[2]), std::string{"body of the message"});
+    // At end of file nothing is appended.
+    parts[0].clear();
+    EXPECT_EQ(sc::readv_into(fd, parts.begin(), parts.begin() + 1), 0ul);
+    EXPECT_TRUE(parts[0].empty());
+    ::close(fd);
+    std::remove(path.c_str());
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -1,10 +1,13 @@
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 #include "tm/test_manager.h"
 #include "vector.h"
 
-#define which_lib std
+#define which_lib sc
 // To run tests with the STL's vector, uncomment the line below.
 // #define which_lib std
 
@@ -61,6 +64,10 @@
 #define EQUAL YES
 // Different operator. it1 != it2
 #define DIFFERENT YES
+// Random access: category tag, it[n] and the standard algorithms.
+#define RANDOM_ACCESS YES
+// iterator -> const_iterator, and mixed comparisons/differences.
+#define CONST_CONVERSION YES
 void run_iterator_tests(void) {
   TestManager tm{"Iterator testing"};
 
@@ -432,5 +439,67 @@ void run_iterator_tests(void) {
   }
 #endif
 
+#if RANDOM_ACCESS
+  {
+    BEGIN_TEST(tm, "RandomAccess", "std::sort, std::lower_bound, it[n]");
+
+    using it_t = sc::vector<int>::iterator;
+    EXPECT_TRUE((std::is_same<std::iterator_traits<it_t>::iterator_category,
+                              std::random_access_iterator_tag>::value));
+    EXPECT_TRUE((std::is_same<
+                 std::iterator_traits<sc::vector<int>::const_iterator>::value_type,
+                 int>::value));
+#if __cplusplus > 201703L
+    EXPECT_TRUE(std::contiguous_iterator<it_t>);
+#endif
+
+    sc::vector<int> vec{5, 3, 9, 1, 7, 2, 8};
+    auto it = vec.begin();
+    EXPECT_EQ(it[2], 9);
+    it[2] = 4;
+    EXPECT_EQ(vec[2], 4);
+    EXPECT_EQ(std::distance(vec.begin(), vec.end()), 7);
+
+    std::sort(vec.begin(), vec.end());
+    EXPECT_EQ(vec, (sc::vector<int>{1, 2, 3, 4, 5, 7, 8}));
+    EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+    auto found = std::lower_bound(vec.begin(), vec.end(), 6);
+    EXPECT_EQ(*found, 7);
+    EXPECT_EQ(found - vec.begin(), 5);
+
+    std::vector<int> out(vec.size());
+    std::copy(vec.cbegin(), vec.cend(), out.begin());
+    EXPECT_EQ(out.back(), 8);
+    EXPECT_TRUE(&*vec.begin() + 3 == (vec.begin() + 3).operator->());
+  }
+#endif
+
+#if CONST_CONVERSION
+  {
+    BEGIN_TEST(tm, "ConstConversion", "iterator to const_iterator");
+
+    sc::vector<int> vec{1, 2, 4, 5, 6};
+    sc::vector<int>::const_iterator cit = vec.begin();
+    EXPECT_EQ(*cit, 1);
+    EXPECT_FALSE((std::is_convertible<sc::vector<int>::const_iterator,
+                                      sc::vector<int>::iterator>::value));
+
+    auto it = vec.begin() + 3;
+    EXPECT_EQ(it - cit, 3);
+    EXPECT_EQ(cit - it, -3);
+    EXPECT_TRUE(cit < it);
+    EXPECT_TRUE(it > cit);
+    EXPECT_TRUE(cit != it);
+    EXPECT_TRUE(vec.cbegin() == vec.begin());
+
+    // A const vector hands out const iterators.
+    const sc::vector<int> &cvec = vec;
+    int sum{0};
+    for (const int &value : cvec)
+      sum += value;
+    EXPECT_EQ(sum, 18);
+  }
+#endif
+
   tm.summary();
 }
\ No newline at end of file
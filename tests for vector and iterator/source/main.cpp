@@ -15,6 +15,25 @@
 
 
 void run_iterator_tests(void);
+void run_move_semantics_tests(void);
+void run_storage_tests(void);
+void run_allocator_tests(void);
+void run_small_vector_tests(void);
+void run_static_vector_tests(void);
+void run_circular_vector_tests(void);
+void run_gap_vector_tests(void);
+void run_tiered_vector_tests(void);
+void run_segmented_vector_tests(void);
+void run_concurrent_vector_tests(void);
+void run_parallel_tests(void);
+void run_sort_tests(void);
+void run_simd_tests(void);
+void run_comparison_tests(void);
+void run_mmap_vector_tests(void);
+void run_serialize_tests(void);
+void run_io_tests(void);
+void run_shm_vector_tests(void);
+void run_aligned_allocator_tests(void);
 
 // ============================================================================
 // TESTING VECTOR AS A CONTAINER OF INTEGERS
@@ -36,5 +55,62 @@ int main( void )
     std::cout << ">>> Testing out iterator operations on vector.\n";
     run_iterator_tests();
 
+    std::cout << ">>> Testing out move operations on vector.\n";
+    run_move_semantics_tests();
+
+    std::cout << ">>> Testing out storage management on vector.\n";
+    run_storage_tests();
+
+    std::cout << ">>> Testing out allocator support on vector.\n";
+    run_allocator_tests();
+
+    std::cout << ">>> Testing out sc::small_vector.\n";
+    run_small_vector_tests();
+
+    std::cout << ">>> Testing out sc::static_vector.\n";
+    run_static_vector_tests();
+
+    std::cout << ">>> Testing out sc::circular_vector.\n";
+    run_circular_vector_tests();
+
+    std::cout << ">>> Testing out sc::gap_vector.\n";
+    run_gap_vector_tests();
+
+    std::cout << ">>> Testing out sc::tiered_vector.\n";
+    run_tiered_vector_tests();
+
+    std::cout << ">>> Testing out sc::segmented_vector.\n";
+    run_segmented_vector_tests();
+
+    std::cout << ">>> Testing out sc::concurrent_vector.\n";
+    run_concurrent_vector_tests();
+
+    std::cout << ">>> Testing out sc::parallel algorithms.\n";
+    run_parallel_tests();
+
+    std::cout << ">>> Testing out sc::sort.\n";
+    run_sort_tests();
+
+    std::cout << ">>> Testing out sc::simd kernels.\n";
+    run_simd_tests();
+
+    std::cout << ">>> Testing out comparisons between vectors.\n";
+    run_comparison_tests();
+
+    std::cout << ">>> Testing out sc::mmap_vector.\n";
+    run_mmap_vector_tests();
+
+    std::cout << ">>> Testing out the binary file format.\n";
+    run_serialize_tests();
+
+    std::cout << ">>> Testing out reads into spare capacity.\n";
+    run_io_tests();
+
+    std::cout << ">>> Testing out sc::shm_vector.\n";
+    run_shm_vector_tests();
+
+    std::cout << ">>> Testing out aligned and huge-page allocation.\n";
+    run_aligned_allocator_tests();
+
     return 1;
 }
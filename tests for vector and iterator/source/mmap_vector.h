@@ -0,0 +1,541 @@
+#ifndef _MMAP_VECTOR_H_
+#define _MMAP_VECTOR_H_
+
+#include <algorithm>        // std::max, std::min, std::copy
+#include <cerrno>           // errno
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uintptr_t
+#include <cstring>          // std::memmove
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <iterator>         // std::distance
+#include <limits>           // std::numeric_limits
+#include <new>              // placement new
+#include <stdexcept>        // std::length_error, std::logic_error
+#include <string>           // std::string
+#include <system_error>     // std::system_error
+#include <type_traits>      // std::is_trivially_copyable
+#include <utility>          // std::exchange, std::forward
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, mremap, msync, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // ftruncate, fdatasync, close, sysconf
+
+#include "io.h"     // sc::detail::throw_errno
+#include "vector.h" // sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+/// How an `mmap_vector` opens its file.
+enum class open_mode {
+  read_write, //!< Opens the file, creating it empty if it does not exist.
+  truncate,   //!< Creates the file, or empties the one that exists.
+  read_only,  //!< Opens an existing file; the modifiers throw.
+};
+
+/// How the elements are about to be read, passed on to `madvise`.
+enum class access_hint {
+  normal,     //!< No particular order.
+  sequential, //!< Front to back: read ahead aggressively.
+  random,     //!< No order at all: do not read ahead.
+  willneed,   //!< Soon: start reading the pages in now.
+  dontneed,   //!< Not for a while: the pages may be dropped.
+};
+
+namespace detail {
+/// Size of a memory page.
+inline std::size_t page_size(void) {
+  static const std::size_t size = std::size_t(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+} // namespace detail
+
+/// A vector whose elements live in a memory-mapped file.
+/*!
+ * The file holds the elements and nothing else, in their in-memory
+ * representation, so opening it maps the bytes that are already there:
+ * no reading, no parsing, and only the pages that are touched are ever
+ * brought into memory. That makes it fit for arrays larger than RAM; the
+ * kernel writes dirty pages back and drops clean ones as it needs.
+ *
+ * While open, the file is `capacity()` elements long; growing extends it
+ * with `ftruncate` and the mapping with `mremap`, which moves page table
+ * entries instead of copying elements. The length of the file is what the
+ * next open reads as the size, so sync() and close() (or the destructor)
+ * trim the file, and the mapping, back to `size()` elements. After a
+ * sync() the file holds exactly the elements, even if the process dies
+ * before closing it; if it dies with changes made since, the file may
+ * keep spare slots, zero-filled, as elements. Since sync() drops the
+ * spare capacity, the next append grows the file again.
+ *
+ * Only trivially copyable `T` can be stored: the elements are bytes in a
+ * file, and they have to mean the same thing to the next process. Like
+ * `sc::vector`, growth invalidates iterators and references.
+ *
+ * \tparam T The type of the elements.
+ */
+template <typename T> class mmap_vector {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "mmap_vector only stores trivially copyable types");
+
+  //=== Aliases
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator =
+      MyForwardIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  /// A vector that is not attached to any file yet.
+  mmap_vector(void) noexcept = default;
+  /*! Maps the file at `path_`.
+   * \param path_ the file holding the elements.
+   * \param mode_ whether the file is created, emptied or only read.
+   * \throw std::system_error if the file cannot be opened or mapped.
+   * \throw std::length_error if its length is not a whole number of elements.
+   */
+  explicit mmap_vector(const std::string &path_,
+                       open_mode mode_ = open_mode::read_write)
+      : m_path{path_}, m_writable{mode_ != open_mode::read_only} {
+    int flags = m_writable ? O_RDWR | O_CREAT : O_RDONLY;
+    if (mode_ == open_mode::truncate) {
+      flags |= O_TRUNC;
+    }
+    m_fd = ::open(path_.c_str(), flags | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+      detail::throw_errno("não foi possível abrir o arquivo");
+    }
+    try {
+      struct stat info;
+      if (::fstat(m_fd, &info) != 0) {
+        detail::throw_errno("não foi possível ler o tamanho do arquivo");
+      }
+      size_type bytes = size_type(info.st_size);
+      if (bytes % sizeof(T) != 0) {
+        throw std::length_error("O arquivo não tem um número inteiro de elementos!");
+      }
+      m_end = m_capacity = bytes / sizeof(T);
+      if (m_capacity > 0) {
+        m_storage = map(m_capacity);
+      }
+    } catch (...) {
+      ::close(m_fd);
+      throw;
+    }
+  }
+  /// Unmaps and closes the file, trimmed to `size()` elements.
+  ~mmap_vector(void) {
+    try {
+      close();
+    } catch (...) {
+      // A destructor cannot report it; call close() to find out.
+    }
+  }
+  mmap_vector(const mmap_vector &) = delete;
+  mmap_vector &operator=(const mmap_vector &) = delete;
+  mmap_vector(mmap_vector &&other) noexcept { steal(other); }
+  mmap_vector &operator=(mmap_vector &&other) {
+    if (this != &other) {
+      close();
+      steal(other);
+    }
+    return *this;
+  }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator{m_storage}; }
+  iterator end(void) { return iterator{m_storage + m_end}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator{m_storage}; }
+  const_iterator cend(void) const { return const_iterator{m_storage + m_end}; }
+
+  // [III] Capacity
+  size_type size(void) const { return m_end; }
+  size_type capacity(void) const { return m_capacity; }
+  bool empty(void) const { return m_end == 0; }
+  /// Whether a file is attached.
+  bool is_open(void) const { return m_fd >= 0; }
+  /// Whether the modifiers may be used.
+  bool writable(void) const { return m_writable; }
+  /// Path of the attached file.
+  const std::string &path(void) const { return m_path; }
+
+  // [IV] Modifiers
+  void clear(void) {
+    check_writable();
+    m_end = 0;
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  /// Constructs a new element at the end from `args`.
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    check_writable();
+    // Built before growing, since `args` may refer to our own elements.
+    T value(std::forward<Args>(args)...);
+    if (m_end == m_capacity) {
+      grow(m_end + 1);
+    }
+    return *::new (static_cast<void *>(m_storage + m_end++)) T(value);
+  }
+  void pop_back(void) {
+    check_writable();
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    --m_end;
+  }
+
+  iterator insert(const_iterator pos_, const_reference value_) {
+    check_writable();
+    size_type distance = index_of(pos_);
+    T value(value_);
+    open_gap(distance, 1);
+    m_storage[distance] = value;
+    return iterator{m_storage + distance};
+  }
+  /// Inserts [`first_`, `last_`), which must not come from this vector.
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  iterator insert(const_iterator pos_, InputItr first_, InputItr last_) {
+    check_writable();
+    size_type distance = index_of(pos_);
+    open_gap(distance, size_type(std::distance(first_, last_)));
+    std::copy(first_, last_, m_storage + distance);
+    return iterator{m_storage + distance};
+  }
+  iterator insert(const_iterator pos_,
+                  const std::initializer_list<value_type> &ilist_) {
+    return insert(pos_, ilist_.begin(), ilist_.end());
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    check_writable();
+    size_type lo = index_of(first);
+    size_type hi = index_of(last);
+    if (lo > hi) {
+      throw std::length_error("Não existe esse intervalo no vector");
+    }
+    std::memmove(static_cast<void *>(m_storage + lo), m_storage + hi,
+                 (m_end - hi) * sizeof(T));
+    m_end -= hi - lo;
+    return iterator{m_storage + lo};
+  }
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  void assign(size_type count_, const_reference value_) {
+    check_writable();
+    T value(value_);
+    reserve(count_);
+    std::fill(m_storage, m_storage + count_, value);
+    m_end = count_;
+  }
+  /// Replaces the elements with [`first`, `last`), which must not come
+  /// from this vector.
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  void assign(InputItr first, InputItr last) {
+    check_writable();
+    reserve(size_type(std::distance(first, last)));
+    m_end = size_type(std::copy(first, last, m_storage) - m_storage);
+  }
+  void assign(const std::initializer_list<T> &ilist) {
+    assign(ilist.begin(), ilist.end());
+  }
+
+  /// Extends the file to hold at least `new_capacity` elements.
+  void reserve(size_type new_capacity) {
+    check_writable();
+    if (new_capacity > m_capacity) {
+      remap(new_capacity);
+    }
+  }
+  /// Trims the file to the elements in use.
+  void shrink_to_fit(void) {
+    check_writable();
+    if (m_capacity != m_end) {
+      remap(m_end);
+    }
+  }
+  /// Keeps the first `count_` elements, appending value-initialized ones
+  /// if there are fewer.
+  void resize(size_type count_) { resize(count_, T{}); }
+  /// Keeps the first `count_` elements, appending copies of `value_` if
+  /// there are fewer.
+  void resize(size_type count_, const_reference value_) {
+    check_writable();
+    T value(value_);
+    if (count_ > m_capacity) {
+      grow(count_);
+    }
+    if (count_ > m_end) {
+      std::fill(m_storage + m_end, m_storage + count_, value);
+    }
+    m_end = count_;
+  }
+
+  // [V] Element access
+  reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return m_storage[0];
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return m_storage[0];
+  }
+  reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return m_storage[m_end - 1];
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return m_storage[m_end - 1];
+  }
+  /// Writing through the result of a read-only vector crashes.
+  reference operator[](size_type idx) { return m_storage[idx]; }
+  const_reference operator[](size_type idx) const { return m_storage[idx]; }
+  reference at(size_type idx) {
+    if (idx >= m_end) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return m_storage[idx];
+  }
+  const_reference at(size_type idx) const {
+    if (idx >= m_end) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return m_storage[idx];
+  }
+  pointer data(void) { return m_storage; }
+  const T *data(void) const { return m_storage; }
+
+  // [VI] File
+  /// Writes the modified elements back to the file, trims it to `size()`
+  /// elements and waits for it.
+  void sync(void) { sync(0, m_end); }
+  /*! Writes the modified elements among [`first_`, `last_`) back to the
+   * file, trims it to `size()` elements and waits for it. Only pages that
+   * were written to cost any I/O.
+   * \throw std::system_error if the file could not be trimmed or written.
+   */
+  void sync(size_type first_, size_type last_) {
+    if (!m_writable || m_fd < 0) {
+      return;
+    }
+    if (m_capacity != m_end) {
+      // The length of the file is the size the next open will read.
+      remap(m_end);
+      if (::fdatasync(m_fd) != 0) {
+        detail::throw_errno("não foi possível sincronizar o arquivo");
+      }
+    }
+    last_ = std::min(last_, m_end);
+    if (first_ >= last_) {
+      return;
+    }
+    auto span = page_span(first_, last_);
+    if (::msync(span.first, span.second, MS_SYNC) != 0) {
+      detail::throw_errno("não foi possível sincronizar o arquivo");
+    }
+  }
+  /// Tells the kernel how all the elements are about to be used.
+  void advise(access_hint hint_) { advise(hint_, 0, m_end); }
+  /// Tells the kernel how the elements in [`first_`, `last_`) are about to
+  /// be used. It is only a hint: the elements stay the same.
+  void advise(access_hint hint_, size_type first_, size_type last_) {
+    last_ = std::min(last_, m_end);
+    if (m_storage == nullptr || first_ >= last_) {
+      return;
+    }
+    static constexpr int advice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM,
+                                     MADV_WILLNEED, MADV_DONTNEED};
+    auto span = page_span(first_, last_);
+    // Dropping dirty pages of a shared mapping is not allowed to lose them,
+    // so even MADV_DONTNEED keeps the elements.
+    if (::madvise(span.first, span.second, advice[int(hint_)]) != 0) {
+      detail::throw_errno("madvise falhou");
+    }
+  }
+  /*! Unmaps the elements, trims the file to `size()` of them and closes
+   * it. The vector is left empty and detached.
+   * \throw std::system_error if the file could not be trimmed.
+   */
+  void close(void) {
+    if (m_fd < 0) {
+      return;
+    }
+    if (m_storage != nullptr) {
+      ::munmap(m_storage, m_capacity * sizeof(T));
+    }
+    int fd = std::exchange(m_fd, -1);
+    bool trimmed = !m_writable || m_end == m_capacity ||
+                   ::ftruncate(fd, off_t(m_end * sizeof(T))) == 0;
+    int error = errno;
+    ::close(fd);
+    m_storage = nullptr;
+    m_end = m_capacity = 0;
+    if (!trimmed) {
+      errno = error;
+      detail::throw_errno("não foi possível ajustar o tamanho do arquivo");
+    }
+  }
+
+  // [VII] Friend functions.
+  friend std::ostream &operator<<(std::ostream &os_, const mmap_vector &v_) {
+    os_ << "{ ";
+    for (size_type i{0}; i < v_.m_end; ++i) {
+      os_ << v_.m_storage[i] << " ";
+    }
+    os_ << "| }, m_end=" << v_.m_end << ", m_capacity=" << v_.m_capacity;
+    return os_;
+  }
+  friend void swap(mmap_vector &first_, mmap_vector &second_) noexcept {
+    using std::swap;
+    swap(first_.m_path, second_.m_path);
+    swap(first_.m_fd, second_.m_fd);
+    swap(first_.m_writable, second_.m_writable);
+    swap(first_.m_storage, second_.m_storage);
+    swap(first_.m_end, second_.m_end);
+    swap(first_.m_capacity, second_.m_capacity);
+  }
+
+private:
+  void check_writable(void) const {
+    if (!m_writable) {
+      throw std::logic_error("mmap_vector aberto só para leitura!");
+    }
+  }
+  /// Index of `pos_`, which must lie in [begin, end].
+  size_type index_of(const_iterator pos_) const {
+    auto distance = pos_ - cbegin();
+    if (distance < 0 || size_type(distance) > m_end) {
+      throw std::length_error("Não existe essa posição no vector");
+    }
+    return size_type(distance);
+  }
+  /// Makes room for `count_` elements at `distance`, shifting the tail up.
+  void open_gap(size_type distance, size_type count_) {
+    if (m_end + count_ > m_capacity) {
+      grow(m_end + count_);
+    }
+    std::memmove(static_cast<void *>(m_storage + distance + count_),
+                 m_storage + distance, (m_end - distance) * sizeof(T));
+    m_end += count_;
+  }
+
+  /// Grows to at least `min_capacity_`, doubling to keep appends amortized
+  /// O(1) and rounding up to whole pages, which are mapped anyway.
+  void grow(size_type min_capacity_) {
+    size_type wanted = std::max(min_capacity_, 2 * m_capacity);
+    size_type page = detail::page_size();
+    size_type bytes = (wanted * sizeof(T) + page - 1) / page * page;
+    remap(bytes / sizeof(T));
+  }
+  /// Resizes the file and the mapping to `new_capacity` elements.
+  void remap(size_type new_capacity) {
+    if (m_fd < 0) {
+      throw std::logic_error("mmap_vector não está associado a um arquivo!");
+    }
+    if (new_capacity > std::numeric_limits<off_t>::max() / sizeof(T)) {
+      throw std::length_error("Capacidade grande demais!");
+    }
+    std::size_t old_bytes = m_capacity * sizeof(T);
+    std::size_t new_bytes = new_capacity * sizeof(T);
+    // Shrinking unmaps first, so no page is left past the end of file.
+    if (new_bytes < old_bytes) {
+      if (new_bytes == 0) {
+        ::munmap(m_storage, old_bytes);
+        m_storage = nullptr;
+      } else {
+        m_storage = resize_mapping(new_bytes);
+      }
+      m_capacity = new_capacity;
+    }
+    if (::ftruncate(m_fd, off_t(new_bytes)) != 0) {
+      detail::throw_errno("não foi possível aumentar o arquivo");
+    }
+    if (new_bytes > old_bytes) {
+      m_storage = m_storage == nullptr ? map(new_capacity)
+                                       : resize_mapping(new_bytes);
+      m_capacity = new_capacity;
+    }
+  }
+  /// Maps the first `count_` elements of the file.
+  pointer map(size_type count_) const {
+    int prot = m_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *addr =
+        ::mmap(nullptr, count_ * sizeof(T), prot, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED) {
+      detail::throw_errno("não foi possível mapear o arquivo");
+    }
+    return static_cast<pointer>(addr);
+  }
+  /// Resizes the current mapping to `new_bytes_`, moving it if needed.
+  pointer resize_mapping(std::size_t new_bytes_) {
+#if defined(__linux__)
+    void *addr = ::mremap(m_storage, m_capacity * sizeof(T), new_bytes_,
+                          MREMAP_MAYMOVE);
+    if (addr == MAP_FAILED) {
+      detail::throw_errno("não foi possível remapear o arquivo");
+    }
+    return static_cast<pointer>(addr);
+#else
+    pointer addr = map(new_bytes_ / sizeof(T));
+    ::munmap(m_storage, m_capacity * sizeof(T));
+    return addr;
+#endif
+  }
+  /// The whole pages covering the elements [`first_`, `last_`).
+  std::pair<void *, std::size_t> page_span(size_type first_,
+                                           size_type last_) const {
+    auto lo = reinterpret_cast<std::uintptr_t>(m_storage + first_);
+    auto hi = reinterpret_cast<std::uintptr_t>(m_storage + last_);
+    lo -= lo % detail::page_size();
+    return {reinterpret_cast<void *>(lo), std::size_t(hi - lo)};
+  }
+  /// Takes over the file of `other`, leaving it detached.
+  void steal(mmap_vector &other) noexcept {
+    m_path = std::move(other.m_path);
+    m_fd = std::exchange(other.m_fd, -1);
+    m_writable = other.m_writable;
+    m_storage = std::exchange(other.m_storage, nullptr);
+    m_end = std::exchange(other.m_end, 0);
+    m_capacity = std::exchange(other.m_capacity, 0);
+  }
+
+  std::string m_path;          //!< Path of the attached file.
+  int m_fd{-1};                //!< The file, or -1 if none is attached.
+  bool m_writable{false};      //!< Whether the file was opened for writing.
+  pointer m_storage{nullptr};  //!< The mapping, or null when it is empty.
+  size_type m_end{0};          //!< How many elements there are.
+  size_type m_capacity{0};     //!< How many elements the file holds.
+};
+
+// [VI] Operators
+template <typename T>
+bool operator==(const mmap_vector<T> &vector1, const mmap_vector<T> &vector2) {
+  return vector1.size() == vector2.size() &&
+         std::equal(vector1.begin(), vector1.end(), vector2.begin());
+}
+template <typename T>
+bool operator!=(const mmap_vector<T> &vector1, const mmap_vector<T> &vector2) {
+  return !(vector1 == vector2);
+}
+} // namespace sc.
+
+#endif
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "mmap_vector.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Seventeenth batch of tests, focused on sc::mmap_vector
+// =============================================================
+
+// The modifiers behave like the ones of std::vector.
+#define MODIFIERS YES
+// What is written is there when the file is opened again.
+#define PERSISTENCE YES
+// Read-only files, broken files, hints and moves.
+#define FILE_HANDLING YES
+// What was synced survives a process that dies without closing the file.
+#define CRASH_AFTER_SYNC YES
+
+namespace {
+/// A fixed-size record, as stored in the data files.
+struct record {
+  std::uint64_t id;
+  double value;
+};
+
+/// A scratch file path, unique to this process.
+std::string scratch_path(const std::string &name_) {
+  return "/tmp/sc_mmap_vector_" + std::to_string(::getpid()) + "_" + name_;
+}
+
+/// Length of the file at `path_`, in bytes.
+long file_length(const std::string &path_) {
+  std::ifstream file{path_, std::ios::binary | std::ios::ate};
+  return long(file.tellg());
+}
+
+template <typename T>
+bool same(const sc::mmap_vector<T> &lhs_, const std::vector<T> &rhs_) {
+  return lhs_.size() == rhs_.size() &&
+         std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+}
+} // namespace
+
+void run_mmap_vector_tests(void) {
+  TestManager tm{"mmap_vector testing"};
+
+#if MODIFIERS
+  {
+    BEGIN_TEST(tm, "Modifiers", "same results as std::vector");
+
+    std::string path = scratch_path("modifiers");
+    {
+      sc::mmap_vector<int> vec{path, sc::open_mode::truncate};
+      std::vector<int> ref;
+      EXPECT_TRUE(vec.empty());
+      // Enough to grow across several pages.
+      for (int i{0}; i < 10'000; ++i) {
+        vec.push_back(i);
+        ref.push_back(i);
+      }
+      EXPECT_TRUE(same(vec, ref));
+      EXPECT_TRUE(vec.capacity() >= vec.size());
+
+      vec.insert(vec.begin() + 5, 42);
+      ref.insert(ref.begin() + 5, 42);
+      vec.insert(vec.end(), {7, 8, 9});
+      ref.insert(ref.end(), {7, 8, 9});
+      vec.erase(vec.begin(), vec.begin() + 100);
+      ref.erase(ref.begin(), ref.begin() + 100);
+      vec.erase(vec.begin() + 10);
+      ref.erase(ref.begin() + 10);
+      vec.pop_back();
+      ref.pop_back();
+      EXPECT_TRUE(same(vec, ref));
+
+      vec.resize(20'000, -1);
+      ref.resize(20'000, -1);
+      vec.resize(50);
+      ref.resize(50);
+      EXPECT_TRUE(same(vec, ref));
+      vec.shrink_to_fit();
+      EXPECT_EQ(vec.capacity(), 50ul);
+      EXPECT_EQ(vec.back(), ref.back());
+      vec.assign(3, 4);
+      EXPECT_TRUE(same(vec, std::vector<int>{4, 4, 4}));
+      vec.clear();
+      vec.shrink_to_fit();
+      EXPECT_TRUE(vec.empty());
+      vec.emplace_back(1);
+      EXPECT_EQ(vec.at(0), 1);
+    }
+    std::remove(path.c_str());
+  }
+#endif
+
+#if PERSISTENCE
+  {
+    BEGIN_TEST(tm, "Persistence", "reopened files hold the same elements");
+
+    std::string path = scratch_path("persistence");
+    std::vector<record> ref;
+    {
+      sc::mmap_vector<record> vec{path, sc::open_mode::truncate};
+      for (std::uint64_t i{0}; i < 5'000; ++i) {
+        vec.push_back(record{i, double(i) / 2});
+        ref.push_back(record{i, double(i) / 2});
+      }
+      vec.sync();
+      vec.sync(10, 20);
+    }
+    // The spare capacity is trimmed away on close.
+    EXPECT_EQ(file_length(path), long(ref.size() * sizeof(record)));
+    {
+      sc::mmap_vector<record> vec{path};
+      bool equal = vec.size() == ref.size();
+      for (std::size_t i{0}; equal && i < ref.size(); ++i) {
+        equal = vec[i].id == ref[i].id && vec[i].value == ref[i].value;
+      }
+      EXPECT_TRUE(equal);
+      // Appending to an existing file keeps what was there.
+      vec.push_back(record{99, 9.5});
+      vec[0].value = -1;
+    }
+    {
+      sc::mmap_vector<record> vec{path, sc::open_mode::read_only};
+      EXPECT_EQ(vec.size(), ref.size() + 1);
+      EXPECT_EQ(vec.back().id, 99u);
+      EXPECT_EQ(vec.front().value, -1.0);
+    }
+    {
+      sc::mmap_vector<record> vec{path, sc::open_mode::truncate};
+      EXPECT_TRUE(vec.empty());
+    }
+    EXPECT_EQ(file_length(path), 0l);
+    std::remove(path.c_str());
+  }
+#endif
+
+#if FILE_HANDLING
+  {
+    BEGIN_TEST(tm, "FileHandling", "errors, hints and moves");
+
+    std::string path = scratch_path("handling");
+    {
+      sc::mmap_vector<std::int32_t> vec{path, sc::open_mode::truncate};
+      vec.assign({1, 2, 3, 4});
+      vec.advise(sc::access_hint::sequential);
+      vec.advise(sc::access_hint::willneed, 1, 3);
+      vec.advise(sc::access_hint::random);
+
+      // Moving hands the file over.
+      sc::mmap_vector<std::int32_t> moved{std::move(vec)};
+      EXPECT_FALSE(vec.is_open());
+      EXPECT_EQ(moved.size(), 4ul);
+      EXPECT_EQ(moved.path(), path);
+      moved.close();
+      EXPECT_FALSE(moved.is_open());
+    }
+    {
+      sc::mmap_vector<std::int32_t> vec{path, sc::open_mode::read_only};
+      EXPECT_FALSE(vec.writable());
+      EXPECT_EQ(vec[3], 4);
+      bool thrown{false};
+      try {
+        vec.push_back(5);
+      } catch (const std::logic_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+    }
+    {
+      // 16 bytes are not a whole number of 12-byte elements.
+      struct triple {
+        std::int32_t a, b, c;
+      };
+      bool thrown{false};
+      try {
+        sc::mmap_vector<triple> vec{path};
+      } catch (const std::length_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+    }
+    std::remove(path.c_str());
+    {
+      bool thrown{false};
+      try {
+        sc::mmap_vector<int> vec{path, sc::open_mode::read_only};
+      } catch (const std::system_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+    }
+  }
+#endif
+
+#if CRASH_AFTER_SYNC
+  {
+    BEGIN_TEST(tm, "CrashAfterSync", "sync() persists the size, not the capacity");
+
+    std::string path = scratch_path("crash");
+    pid_t pid = ::fork();
+    EXPECT_TRUE(pid != -1);
+    if (pid == 0) {
+      sc::mmap_vector<record> vec{path, sc::open_mode::truncate};
+      for (std::uint64_t i{0}; i < 10; ++i) {
+        vec.push_back(record{i, double(i) / 2});
+      }
+      vec.sync();
+      // Dies without closing, so nothing but sync() trims the file.
+      ::_exit(0);
+    }
+    if (pid != -1) {
+      int status{-1};
+      EXPECT_EQ(::waitpid(pid, &status, 0), pid);
+      EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+      EXPECT_EQ(file_length(path), long(10 * sizeof(record)));
+      sc::mmap_vector<record> vec{path, sc::open_mode::read_only};
+      EXPECT_EQ(vec.size(), 10ul);
+      EXPECT_EQ(vec.back().id, 9u);
+      EXPECT_EQ(vec.back().value, 4.5);
+    }
+    // Appending after a sync grows the trimmed file again.
+    {
+      sc::mmap_vector<record> vec{path};
+      vec.push_back(record{10, 5.0});
+      vec.sync();
+      EXPECT_EQ(vec.capacity(), 11ul);
+      vec.push_back(record{11, 5.5});
+      EXPECT_TRUE(vec.capacity() > 11ul);
+      EXPECT_EQ(vec[10].id, 10u);
+    }
+    EXPECT_EQ(file_length(path), long(12 * sizeof(record)));
+    std::remove(path.c_str());
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -1,3 +1,4 @@
+#include <array>
 #include <cstddef>
 #include<iostream>
 #include<vector>
@@ -17,13 +18,13 @@
 // =============================================================
 
 // Move Ctro.
-#define MOVE_CTRO NO
+#define MOVE_CTRO YES
 // Move assignment operator.
-#define MOVE_ASSIGNMENT NO
+#define MOVE_ASSIGNMENT YES
 // Emplace back operator.
-#define EMPLACE_BACK_INT NO
+#define EMPLACE_BACK_INT YES
 // Emplace back operator.
-#define EMPLACE_BACK_STRING NO
+#define EMPLACE_BACK_STRING YES
 
 
 void run_move_semantics_tests( void )
@@ -0,0 +1,642 @@
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include <algorithm>          // std::min, std::find_if
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::int64_t
+#include <exception>          // std::exception_ptr
+#include <functional>         // std::plus, std::multiplies
+#include <iterator>           // std::iterator_traits
+#include <memory>             // std::unique_ptr
+#include <mutex>              // std::mutex, std::lock_guard
+#include <numeric>            // std::inclusive_scan
+#include <random>             // std::minstd_rand
+#include <thread>             // std::thread
+#include <type_traits>        // std::remove_reference_t
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+/// Parallel algorithms over random access ranges, run on a work-stealing
+/// thread pool.
+/*!
+ * Every algorithm cuts its range into chunks of `thread_pool::grain()`
+ * elements. The chunk boundaries only depend on the size of the range and
+ * on the grain, never on the number of threads or on who ran what, and
+ * partial results are always combined in chunk order. So `reduce()`,
+ * `transform_reduce()` and `inclusive_scan()` give the same result, bit
+ * for bit, on any pool with the same grain, even for floating point sums;
+ * their operations only need to be associative, not commutative.
+ *
+ * Each algorithm comes in three forms: on a given pool, on the default
+ * pool, and on a whole `sc::vector`.
+ */
+namespace parallel {
+namespace detail {
+/// A batch of chunks handed to the pool by one `thread_pool::run()`.
+class job {
+public:
+  explicit job(std::size_t chunks_) : m_remaining{chunks_} {}
+  virtual ~job(void) = default;
+
+  /// Runs chunk `chunk_`.
+  virtual void run(std::size_t chunk_) = 0;
+
+  /// Runs chunk `chunk_`, unless an earlier chunk has thrown.
+  void run_safely(std::size_t chunk_) {
+    if (m_failed.load(std::memory_order_relaxed)) {
+      return;
+    }
+    try {
+      run(chunk_);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock{m_error_lock};
+      if (!m_error) {
+        m_error = std::current_exception();
+      }
+      m_failed.store(true, std::memory_order_relaxed);
+    }
+  }
+  /// Marks `count_` chunks as done. The job must not be touched after the
+  /// last one.
+  void finish(std::size_t count_) {
+    m_remaining.fetch_sub(count_, std::memory_order_acq_rel);
+  }
+  bool done(void) const {
+    return m_remaining.load(std::memory_order_acquire) == 0;
+  }
+  /// Throws the first exception a chunk threw, if any.
+  void rethrow(void) {
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+private:
+  std::atomic<std::size_t> m_remaining; //!< Chunks not finished yet.
+  std::atomic<bool> m_failed{false};    //!< Set once a chunk throws.
+  std::mutex m_error_lock;              //!< Guards `m_error`.
+  std::exception_ptr m_error;           //!< First exception thrown.
+};
+
+/// A job whose chunks are calls to `body(chunk)`.
+template <typename Body> class body_job : public job {
+public:
+  body_job(std::size_t chunks_, Body &body_) : job{chunks_}, m_body{body_} {}
+  void run(std::size_t chunk_) override { m_body(chunk_); }
+
+private:
+  Body &m_body; //!< Lives in the frame of `thread_pool::run()`.
+};
+
+/// Chunks [first, last) of a job, waiting in a deque.
+struct task {
+  job *owner;        //!< The job the chunks belong to.
+  std::size_t first; //!< First chunk.
+  std::size_t last;  //!< One past the last chunk.
+};
+
+/// A Chase-Lev work-stealing deque of tasks.
+/*!
+ * The owning worker pushes and pops at the bottom, like a stack, so it
+ * keeps working on the most recently split (and cache-warm) ranges. Other
+ * threads steal from the top, where the biggest ranges are. Only the pop
+ * and steal of the very last task race with each other, and a
+ * compare-and-swap on `m_top` settles it.
+ *
+ * Tasks are split in halves, so a deque never holds more than one task
+ * per level of splitting: the fixed capacity is plenty, and a full deque
+ * just makes the owner run the range itself.
+ */
+class work_deque {
+  static constexpr std::int64_t capacity{256};
+
+public:
+  /// Pushes `task_` at the bottom. Owner only. False if the deque is full.
+  bool push(task *task_) {
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= capacity) {
+      return false;
+    }
+    m_slots[bottom % capacity].store(task_, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_seq_cst);
+    return true;
+  }
+  /// Pops the bottom task. Owner only. Null if there is none.
+  task *pop(void) {
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+    std::int64_t top = m_top.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      // Empty.
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    task *found = m_slots[bottom % capacity].load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // The last task: thieves may be after it too.
+      if (!m_top.compare_exchange_strong(top, top + 1,
+                                         std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        found = nullptr;
+      }
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return found;
+  }
+  /// Takes the top task. Any thread. Null if there is none, or if another
+  /// thread got it first.
+  task *steal(void) {
+    std::int64_t top = m_top.load(std::memory_order_seq_cst);
+    std::int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    task *found = m_slots[top % capacity].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return found;
+  }
+
+private:
+  alignas(64) std::atomic<std::int64_t> m_top{0}; //!< Next task to steal.
+  alignas(64) std::atomic<std::int64_t> m_bottom{0}; //!< Next free slot.
+  std::atomic<task *> m_slots[capacity]{};           //!< Circular buffer.
+};
+
+/// The pool whose job the calling thread is running, if any.
+inline const void *&current_pool(void) {
+  thread_local const void *pool{nullptr};
+  return pool;
+}
+} // namespace detail
+
+/// A fixed set of threads that share jobs by work stealing.
+/*!
+ * `run(chunks, body)` calls `body(c)` for every chunk `c` in [0, chunks).
+ * The whole range starts in the caller's deque; whoever picks a range up
+ * splits it in halves, keeps the left one and pushes the right one, until
+ * a single chunk is left to run. Idle threads steal the biggest pending
+ * ranges from random victims, so the work spreads out in O(log chunks)
+ * steals and then mostly stays local.
+ *
+ * The caller takes part in its own job, so a pool of `threads` threads
+ * starts `threads - 1` workers. Jobs from different threads are run one
+ * after the other. A `run()` from inside a chunk, on any pool, runs its
+ * chunks sequentially on the current thread, which keeps nested parallel
+ * algorithms from deadlocking. The first exception thrown by a chunk is
+ * rethrown by `run()`, once every chunk has finished or been skipped.
+ */
+class thread_pool {
+public:
+  static constexpr std::size_t default_grain{1 << 14}; //!< Elements per chunk.
+
+  /// A pool of `threads_` threads, the caller included, that cuts ranges
+  /// into chunks of `grain_` elements.
+  explicit thread_pool(std::size_t threads_ = std::thread::hardware_concurrency(),
+                       std::size_t grain_ = default_grain)
+      : m_grain{grain_ > 0 ? grain_ : 1} {
+    std::size_t count = threads_ > 0 ? threads_ : 1;
+    for (std::size_t t{0}; t < count; ++t) {
+      m_deques.emplace_back(new detail::work_deque);
+    }
+    for (std::size_t t{1}; t < count; ++t) {
+      m_workers.emplace_back([this, t] { work(t); });
+    }
+  }
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  ~thread_pool(void) {
+    {
+      std::lock_guard<std::mutex> lock{m_sleep_lock};
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto &worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  /// Number of threads, the caller of run() included.
+  std::size_t size(void) const { return m_deques.size(); }
+  /// Elements per chunk.
+  std::size_t grain(void) const { return m_grain; }
+
+  /// Calls `body_(c)` for every `c` in [0, `chunks_`), in parallel, and
+  /// returns once all of them have.
+  template <typename Body> void run(std::size_t chunks_, Body &&body_) {
+    if (chunks_ == 0) {
+      return;
+    }
+    if (chunks_ == 1 || m_workers.empty() ||
+        detail::current_pool() != nullptr) {
+      for (std::size_t c{0}; c < chunks_; ++c) {
+        body_(c);
+      }
+      return;
+    }
+    std::lock_guard<std::mutex> submit{m_submit_lock};
+    detail::body_job<std::remove_reference_t<Body>> job{chunks_, body_};
+    m_deques[0]->push(new detail::task{&job, 0, chunks_});
+    {
+      std::lock_guard<std::mutex> lock{m_sleep_lock};
+      m_busy.store(true, std::memory_order_release);
+    }
+    m_wake.notify_all();
+
+    detail::current_pool() = this;
+    std::minstd_rand random{0};
+    while (!job.done()) {
+      if (!run_one(0, random)) {
+        std::this_thread::yield();
+      }
+    }
+    detail::current_pool() = nullptr;
+    m_busy.store(false, std::memory_order_release);
+    job.rethrow();
+  }
+
+private:
+  /// Worker `self_`: runs tasks while a job is on, sleeps otherwise.
+  void work(std::size_t self_) {
+    detail::current_pool() = this;
+    std::minstd_rand random{static_cast<unsigned>(self_)};
+    while (true) {
+      if (run_one(self_, random)) {
+        continue;
+      }
+      if (m_busy.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock{m_sleep_lock};
+      m_wake.wait(lock, [this] {
+        return m_stop || m_busy.load(std::memory_order_acquire);
+      });
+      if (m_stop) {
+        return;
+      }
+    }
+  }
+  /// Runs one task of thread `self_`, popped from its own deque or stolen
+  /// from a random one. False if there was nothing to run.
+  bool run_one(std::size_t self_, std::minstd_rand &random_) {
+    detail::task *next = m_deques[self_]->pop();
+    for (std::size_t attempt{0}; next == nullptr && attempt < size();
+         ++attempt) {
+      std::size_t victim = random_() % size();
+      if (victim != self_) {
+        next = m_deques[victim]->steal();
+      }
+    }
+    if (next == nullptr) {
+      return false;
+    }
+    execute(next, *m_deques[self_]);
+    return true;
+  }
+  /// Splits `task_` down to one chunk, leaving the right halves in `own_`
+  /// for later or for thieves, then runs what is left.
+  static void execute(detail::task *task_, detail::work_deque &own_) {
+    detail::job *owner = task_->owner;
+    std::size_t first = task_->first;
+    std::size_t last = task_->last;
+    delete task_;
+    while (last - first > 1) {
+      std::size_t middle = first + (last - first) / 2;
+      auto *right = new detail::task{owner, middle, last};
+      if (!own_.push(right)) {
+        delete right;
+        break;
+      }
+      last = middle;
+    }
+    for (std::size_t c{first}; c < last; ++c) {
+      owner->run_safely(c);
+    }
+    owner->finish(last - first);
+  }
+
+  std::size_t m_grain; //!< Elements per chunk.
+  std::vector<std::unique_ptr<detail::work_deque>> m_deques; //!< One per
+                                                             //!< thread; 0 is
+                                                             //!< the caller's.
+  std::vector<std::thread> m_workers;   //!< Threads 1 and up.
+  std::mutex m_submit_lock;             //!< One job at a time.
+  std::mutex m_sleep_lock;              //!< Guards sleeping and `m_stop`.
+  std::condition_variable m_wake;       //!< Signals a new job or the end.
+  std::atomic<bool> m_busy{false};      //!< A job is running.
+  bool m_stop{false};                   //!< The pool is shutting down.
+};
+
+/// The pool used when none is given: one thread per hardware thread.
+inline thread_pool &default_pool(void) {
+  static thread_pool pool;
+  return pool;
+}
+
+namespace detail {
+/// Number of `grain_`-element chunks covering `n_` elements.
+inline std::size_t chunk_count(std::size_t n_, std::size_t grain_) {
+  return (n_ + grain_ - 1) / grain_;
+}
+/// Calls `body_(c, first, last)` on the pool for every chunk `c`, which
+/// covers the indices [first, last) of a range of `n_` elements.
+template <typename Body>
+void for_chunks(thread_pool &pool_, std::size_t n_, Body body_) {
+  std::size_t grain = pool_.grain();
+  pool_.run(chunk_count(n_, grain), [&body_, grain, n_](std::size_t c) {
+    std::size_t first = c * grain;
+    body_(c, first, std::min(n_, first + grain));
+  });
+}
+} // namespace detail
+
+//=== for_each
+/// Calls `fn_` on every element of [first_, last_).
+template <typename It, typename Fn>
+void for_each(thread_pool &pool_, It first_, It last_, Fn fn_) {
+  detail::for_chunks(pool_, last_ - first_,
+                     [first_, &fn_](std::size_t, std::size_t lo, std::size_t hi) {
+                       std::for_each(first_ + lo, first_ + hi, fn_);
+                     });
+}
+template <typename It, typename Fn> void for_each(It first_, It last_, Fn fn_) {
+  for_each(default_pool(), first_, last_, std::move(fn_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename Fn>
+void for_each(vector<T, A, G, N> &vec_, Fn fn_) {
+  for_each(default_pool(), vec_.begin(), vec_.end(), std::move(fn_));
+}
+
+//=== transform
+/// Writes `op_(x)` for every `x` in [first_, last_) from `d_first_` on,
+/// and returns the end of the output.
+template <typename It, typename OutIt, typename Op>
+OutIt transform(thread_pool &pool_, It first_, It last_, OutIt d_first_,
+                Op op_) {
+  detail::for_chunks(
+      pool_, last_ - first_,
+      [first_, d_first_, &op_](std::size_t, std::size_t lo, std::size_t hi) {
+        std::transform(first_ + lo, first_ + hi, d_first_ + lo, op_);
+      });
+  return d_first_ + (last_ - first_);
+}
+/// Writes `op_(x, y)` for the pairs of [first1_, last1_) and the range
+/// starting at `first2_`.
+template <typename It1, typename It2, typename OutIt, typename Op>
+OutIt transform(thread_pool &pool_, It1 first1_, It1 last1_, It2 first2_,
+                OutIt d_first_, Op op_) {
+  detail::for_chunks(pool_, last1_ - first1_,
+                     [first1_, first2_, d_first_,
+                      &op_](std::size_t, std::size_t lo, std::size_t hi) {
+                       std::transform(first1_ + lo, first1_ + hi, first2_ + lo,
+                                      d_first_ + lo, op_);
+                     });
+  return d_first_ + (last1_ - first1_);
+}
+template <typename It, typename OutIt, typename Op>
+OutIt transform(It first_, It last_, OutIt d_first_, Op op_) {
+  return transform(default_pool(), first_, last_, d_first_, std::move(op_));
+}
+template <typename It1, typename It2, typename OutIt, typename Op>
+OutIt transform(It1 first1_, It1 last1_, It2 first2_, OutIt d_first_, Op op_) {
+  return transform(default_pool(), first1_, last1_, first2_, d_first_,
+                   std::move(op_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename OutIt,
+          typename Op>
+OutIt transform(const vector<T, A, G, N> &vec_, OutIt d_first_, Op op_) {
+  return transform(default_pool(), vec_.begin(), vec_.end(), d_first_,
+                   std::move(op_));
+}
+
+//=== transform_reduce
+/// Combines `init_` and `transform_(x)` for every `x` in [first_, last_)
+/// with `reduce_`, chunk by chunk, in order.
+template <typename It, typename T, typename ReduceOp, typename TransformOp>
+T transform_reduce(thread_pool &pool_, It first_, It last_, T init_,
+                   ReduceOp reduce_, TransformOp transform_) {
+  std::size_t n = last_ - first_;
+  std::vector<T> partials(detail::chunk_count(n, pool_.grain()), init_);
+  detail::for_chunks(pool_, n,
+                     [first_, &partials, &reduce_,
+                      &transform_](std::size_t c, std::size_t lo, std::size_t hi) {
+                       T sum = transform_(first_[lo]);
+                       for (std::size_t i{lo + 1}; i < hi; ++i) {
+                         sum = reduce_(std::move(sum), transform_(first_[i]));
+                       }
+                       partials[c] = std::move(sum);
+                     });
+  for (auto &partial : partials) {
+    init_ = reduce_(std::move(init_), std::move(partial));
+  }
+  return init_;
+}
+/// Combines `init_` and `transform_(x, y)` for the pairs of [first1_,
+/// last1_) and the range starting at `first2_`.
+template <typename It1, typename It2, typename T, typename ReduceOp,
+          typename TransformOp>
+T transform_reduce(thread_pool &pool_, It1 first1_, It1 last1_, It2 first2_,
+                   T init_, ReduceOp reduce_, TransformOp transform_) {
+  std::size_t n = last1_ - first1_;
+  std::vector<T> partials(detail::chunk_count(n, pool_.grain()), init_);
+  detail::for_chunks(pool_, n,
+                     [first1_, first2_, &partials, &reduce_,
+                      &transform_](std::size_t c, std::size_t lo, std::size_t hi) {
+                       T sum = transform_(first1_[lo], first2_[lo]);
+                       for (std::size_t i{lo + 1}; i < hi; ++i) {
+                         sum = reduce_(std::move(sum),
+                                       transform_(first1_[i], first2_[i]));
+                       }
+                       partials[c] = std::move(sum);
+                     });
+  for (auto &partial : partials) {
+    init_ = reduce_(std::move(init_), std::move(partial));
+  }
+  return init_;
+}
+/// The inner product of two ranges, plus `init_`.
+template <typename It1, typename It2, typename T>
+T transform_reduce(thread_pool &pool_, It1 first1_, It1 last1_, It2 first2_,
+                   T init_) {
+  return transform_reduce(pool_, first1_, last1_, first2_, std::move(init_),
+                          std::plus<>{}, std::multiplies<>{});
+}
+template <typename It, typename T, typename ReduceOp, typename TransformOp>
+T transform_reduce(It first_, It last_, T init_, ReduceOp reduce_,
+                   TransformOp transform_) {
+  return transform_reduce(default_pool(), first_, last_, std::move(init_),
+                          std::move(reduce_), std::move(transform_));
+}
+template <typename It1, typename It2, typename T>
+T transform_reduce(It1 first1_, It1 last1_, It2 first2_, T init_) {
+  return transform_reduce(default_pool(), first1_, last1_, first2_,
+                          std::move(init_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename U,
+          typename ReduceOp, typename TransformOp>
+U transform_reduce(const vector<T, A, G, N> &vec_, U init_, ReduceOp reduce_,
+                   TransformOp transform_) {
+  return transform_reduce(default_pool(), vec_.begin(), vec_.end(),
+                          std::move(init_), std::move(reduce_),
+                          std::move(transform_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename U>
+U transform_reduce(const vector<T, A, G, N> &vec1_,
+                   const vector<T, A, G, N> &vec2_, U init_) {
+  return transform_reduce(default_pool(), vec1_.begin(), vec1_.end(),
+                          vec2_.begin(), std::move(init_));
+}
+
+//=== reduce
+/// Combines `init_` and every element of [first_, last_) with `op_`.
+template <typename It, typename T, typename Op = std::plus<>>
+T reduce(thread_pool &pool_, It first_, It last_, T init_, Op op_ = Op{}) {
+  return transform_reduce(pool_, first_, last_, std::move(init_),
+                          std::move(op_), [](const auto &x) { return x; });
+}
+template <typename It, typename T, typename Op = std::plus<>>
+T reduce(It first_, It last_, T init_, Op op_ = Op{}) {
+  return reduce(default_pool(), first_, last_, std::move(init_),
+                std::move(op_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename U,
+          typename Op = std::plus<>>
+U reduce(const vector<T, A, G, N> &vec_, U init_, Op op_ = Op{}) {
+  return reduce(default_pool(), vec_.begin(), vec_.end(), std::move(init_),
+                std::move(op_));
+}
+
+//=== inclusive_scan
+/// Writes the running totals of [first_, last_) under `op_` from
+/// `d_first_` on, and returns the end of the output. The output may be
+/// the input itself.
+/*!
+ * Two passes over the chunks: the first sums each one, the caller turns
+ * those sums into chunk offsets, in order, and the second rescans each
+ * chunk starting from its offset.
+ */
+template <typename It, typename OutIt, typename Op = std::plus<>>
+OutIt inclusive_scan(thread_pool &pool_, It first_, It last_, OutIt d_first_,
+                     Op op_ = Op{}) {
+  using value_t = typename std::iterator_traits<It>::value_type;
+  std::size_t n = last_ - first_;
+  std::size_t chunks = detail::chunk_count(n, pool_.grain());
+  if (chunks <= 1) {
+    return std::inclusive_scan(first_, last_, d_first_, op_);
+  }
+  // offsets[c] ends up as the total of chunks 0..c.
+  std::vector<value_t> offsets(chunks - 1, first_[0]);
+  detail::for_chunks(pool_, (chunks - 1) * pool_.grain(),
+                     [first_, &offsets, &op_](std::size_t c, std::size_t lo,
+                                              std::size_t hi) {
+                       value_t sum = first_[lo];
+                       for (std::size_t i{lo + 1}; i < hi; ++i) {
+                         sum = op_(std::move(sum), first_[i]);
+                       }
+                       offsets[c] = std::move(sum);
+                     });
+  for (std::size_t c{1}; c < offsets.size(); ++c) {
+    offsets[c] = op_(offsets[c - 1], std::move(offsets[c]));
+  }
+  detail::for_chunks(pool_, n,
+                     [first_, d_first_, &offsets,
+                      &op_](std::size_t c, std::size_t lo, std::size_t hi) {
+                       if (c == 0) {
+                         std::inclusive_scan(first_, first_ + hi, d_first_, op_);
+                         return;
+                       }
+                       value_t sum = offsets[c - 1];
+                       for (std::size_t i{lo}; i < hi; ++i) {
+                         sum = op_(std::move(sum), first_[i]);
+                         d_first_[i] = sum;
+                       }
+                     });
+  return d_first_ + n;
+}
+template <typename It, typename OutIt, typename Op = std::plus<>>
+OutIt inclusive_scan(It first_, It last_, OutIt d_first_, Op op_ = Op{}) {
+  return inclusive_scan(default_pool(), first_, last_, d_first_,
+                        std::move(op_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename OutIt,
+          typename Op = std::plus<>>
+OutIt inclusive_scan(const vector<T, A, G, N> &vec_, OutIt d_first_,
+                     Op op_ = Op{}) {
+  return inclusive_scan(default_pool(), vec_.begin(), vec_.end(), d_first_,
+                        std::move(op_));
+}
+
+//=== count_if
+/// Number of elements of [first_, last_) for which `pred_` holds.
+template <typename It, typename Pred>
+typename std::iterator_traits<It>::difference_type
+count_if(thread_pool &pool_, It first_, It last_, Pred pred_) {
+  using difference_t = typename std::iterator_traits<It>::difference_type;
+  return transform_reduce(pool_, first_, last_, difference_t{0},
+                          std::plus<>{}, [&pred_](const auto &x) {
+                            return difference_t{pred_(x) ? 1 : 0};
+                          });
+}
+template <typename It, typename Pred>
+typename std::iterator_traits<It>::difference_type
+count_if(It first_, It last_, Pred pred_) {
+  return count_if(default_pool(), first_, last_, std::move(pred_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename Pred>
+typename vector<T, A, G, N>::const_iterator::difference_type
+count_if(const vector<T, A, G, N> &vec_, Pred pred_) {
+  return count_if(default_pool(), vec_.begin(), vec_.end(), std::move(pred_));
+}
+
+//=== find_if
+/// The first element of [first_, last_) for which `pred_` holds, or
+/// `last_`. Chunks past the best match found so far are skipped.
+template <typename It, typename Pred>
+It find_if(thread_pool &pool_, It first_, It last_, Pred pred_) {
+  std::size_t n = last_ - first_;
+  std::atomic<std::size_t> best{n};
+  detail::for_chunks(
+      pool_, n,
+      [first_, &best, &pred_](std::size_t, std::size_t lo, std::size_t hi) {
+        if (lo >= best.load(std::memory_order_relaxed)) {
+          return;
+        }
+        std::size_t found = std::find_if(first_ + lo, first_ + hi, pred_) - first_;
+        if (found == hi) {
+          return;
+        }
+        std::size_t current = best.load(std::memory_order_relaxed);
+        while (found < current &&
+               !best.compare_exchange_weak(current, found,
+                                           std::memory_order_relaxed)) {
+        }
+      });
+  return first_ + best.load();
+}
+template <typename It, typename Pred> It find_if(It first_, It last_, Pred pred_) {
+  return find_if(default_pool(), first_, last_, std::move(pred_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename Pred>
+typename vector<T, A, G, N>::iterator find_if(vector<T, A, G, N> &vec_,
+                                              Pred pred_) {
+  return find_if(default_pool(), vec_.begin(), vec_.end(), std::move(pred_));
+}
+template <typename T, typename A, typename G, std::size_t N, typename Pred>
+typename vector<T, A, G, N>::const_iterator
+find_if(const vector<T, A, G, N> &vec_, Pred pred_) {
+  return find_if(default_pool(), vec_.begin(), vec_.end(), std::move(pred_));
+}
+} // namespace parallel
+} // namespace sc
+
+#endif
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Thirteenth batch of tests, focused on sc::parallel
+// =============================================================
+
+// Every algorithm gives the same answer as its sequential std version.
+#define MATCHES_SEQUENTIAL YES
+// Floating point results do not depend on the number of threads.
+#define DETERMINISTIC_RESULTS YES
+// find_if returns the first match, whichever chunk finds one first.
+#define FIND_FIRST_MATCH YES
+// Exceptions reach the caller; nested calls run instead of deadlocking.
+#define EXCEPTIONS_AND_NESTING YES
+
+namespace {
+constexpr std::size_t n{100'003}; //!< Not a multiple of the grain.
+constexpr std::size_t grain{97};  //!< Small, so there are many chunks.
+
+/// `n` doubles of very different magnitudes, so the order of a sum shows.
+sc::vector<double> wild_doubles(void) {
+  sc::vector<double> vec;
+  vec.reserve(n);
+  for (std::size_t i{0}; i < n; ++i)
+    vec.push_back(std::pow(-1.7, double(i % 40)) / double(i + 1));
+  return vec;
+}
+} // namespace
+
+void run_parallel_tests(void) {
+  TestManager tm{"Parallel algorithms testing"};
+
+#if MATCHES_SEQUENTIAL
+  {
+    BEGIN_TEST(tm, "MatchesSequential", "parallel results equal std's");
+
+    sc::parallel::thread_pool pool{4, grain};
+    sc::vector<long> vec;
+    for (std::size_t i{0}; i < n; ++i)
+      vec.push_back(long(i * 7919 % 1000));
+
+    sc::vector<long> doubled(n);
+    sc::parallel::transform(pool, vec.begin(), vec.end(), doubled.begin(),
+                            [](long x) { return 2 * x; });
+    std::vector<long> expected(n);
+    std::transform(vec.begin(), vec.end(), expected.begin(),
+                   [](long x) { return 2 * x; });
+    EXPECT_TRUE(std::equal(doubled.begin(), doubled.end(), expected.begin()));
+
+    sc::vector<long> sums(n);
+    sc::parallel::transform(pool, vec.begin(), vec.end(), doubled.begin(),
+                            sums.begin(), std::plus<>{});
+    EXPECT_EQ(sums[n - 1], 3 * vec[n - 1]);
+
+    sc::parallel::for_each(pool, sums.begin(), sums.end(), [](long &x) { ++x; });
+    EXPECT_EQ(sums[0], 3 * vec[0] + 1);
+    EXPECT_EQ(sums[n / 2], 3 * vec[n / 2] + 1);
+
+    EXPECT_EQ(sc::parallel::reduce(pool, vec.begin(), vec.end(), 5L),
+              std::accumulate(vec.begin(), vec.end(), 5L));
+    EXPECT_EQ(sc::parallel::transform_reduce(pool, vec.begin(), vec.end(),
+                                             doubled.begin(), 0L),
+              std::inner_product(vec.begin(), vec.end(), doubled.begin(), 0L));
+    EXPECT_EQ(sc::parallel::count_if(pool, vec.begin(), vec.end(),
+                                     [](long x) { return x % 3 == 0; }),
+              std::count_if(vec.begin(), vec.end(),
+                            [](long x) { return x % 3 == 0; }));
+
+    sc::vector<long> scan(n);
+    sc::parallel::inclusive_scan(pool, vec.begin(), vec.end(), scan.begin());
+    std::inclusive_scan(vec.begin(), vec.end(), expected.begin());
+    EXPECT_TRUE(std::equal(scan.begin(), scan.end(), expected.begin()));
+    // In place, too.
+    sc::parallel::inclusive_scan(pool, vec.begin(), vec.end(), vec.begin());
+    EXPECT_EQ(vec, scan);
+
+    // The default pool and the whole-vector forms.
+    EXPECT_EQ(sc::parallel::reduce(vec, 0L), std::accumulate(vec.begin(), vec.end(), 0L));
+    EXPECT_EQ(sc::parallel::count_if(vec, [](long x) { return x > 0; }),
+              long(n) - (vec[0] == 0 ? 1 : 0));
+    sc::vector<long> empty;
+    EXPECT_EQ(sc::parallel::reduce(pool, empty.begin(), empty.end(), 3L), 3L);
+    EXPECT_TRUE(sc::parallel::find_if(empty, [](long) { return true; }) == empty.end());
+  }
+#endif
+
+#if DETERMINISTIC_RESULTS
+  {
+    BEGIN_TEST(tm, "DeterministicResults", "same bits on any number of threads");
+
+    sc::vector<double> vec = wild_doubles();
+    sc::parallel::thread_pool one{1, grain};
+    double sum = sc::parallel::reduce(one, vec.begin(), vec.end(), 0.0);
+    double dot = sc::parallel::transform_reduce(one, vec.begin(), vec.end(),
+                                                vec.begin(), 0.0);
+    sc::vector<double> scan(n);
+    sc::parallel::inclusive_scan(one, vec.begin(), vec.end(), scan.begin());
+
+    bool same{true};
+    for (std::size_t threads : {2, 3, 8}) {
+      sc::parallel::thread_pool pool{threads, grain};
+      for (int round{0}; round < 5; ++round) {
+        same = same && sc::parallel::reduce(pool, vec.begin(), vec.end(), 0.0) == sum;
+        same = same && sc::parallel::transform_reduce(pool, vec.begin(), vec.end(),
+                                                      vec.begin(), 0.0) == dot;
+        sc::vector<double> other(n);
+        sc::parallel::inclusive_scan(pool, vec.begin(), vec.end(), other.begin());
+        same = same && other == scan;
+      }
+    }
+    EXPECT_TRUE(same);
+    // Close to the sequential sum, if not equal to it.
+    double serial = std::accumulate(vec.begin(), vec.end(), 0.0);
+    EXPECT_TRUE(std::abs(sum - serial) <= 1e-9 * std::abs(serial));
+  }
+#endif
+
+#if FIND_FIRST_MATCH
+  {
+    BEGIN_TEST(tm, "FindFirstMatch", "find_if returns the earliest match");
+
+    sc::parallel::thread_pool pool{4, grain};
+    sc::vector<int> vec(n);
+    for (std::size_t i{0}; i < n; ++i)
+      vec[i] = int(i % 5000);
+    bool first{true};
+    for (int key : {0, 1, 4321, 4999}) {
+      auto it = sc::parallel::find_if(pool, vec.begin(), vec.end(),
+                                      [key](int x) { return x == key; });
+      first = first && it == std::find(vec.begin(), vec.end(), key);
+    }
+    EXPECT_TRUE(first);
+    EXPECT_TRUE(sc::parallel::find_if(pool, vec.begin(), vec.end(),
+                                      [](int x) { return x < 0; }) == vec.end());
+  }
+#endif
+
+#if EXCEPTIONS_AND_NESTING
+  {
+    BEGIN_TEST(tm, "ExceptionsAndNesting", "errors propagate, nesting works");
+
+    sc::parallel::thread_pool pool{4, grain};
+    sc::vector<int> vec(n);
+    bool thrown{false};
+    try {
+      sc::parallel::for_each(pool, vec.begin(), vec.end(), [&vec](int &x) {
+        if (&x == &vec[n / 3])
+          throw std::runtime_error("bad element");
+      });
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    // A parallel call inside a parallel call.
+    std::atomic<long> visited{0};
+    sc::vector<int> outer(64);
+    sc::parallel::thread_pool coarse{4, 1};
+    sc::parallel::for_each(coarse, outer.begin(), outer.end(), [&](int &) {
+      visited += sc::parallel::count_if(pool, vec.begin(), vec.end(),
+                                        [](int x) { return x == 0; });
+    });
+    EXPECT_EQ(visited.load(), 64L * long(n));
+
+    // The pool still works after all that.
+    EXPECT_EQ(sc::parallel::count_if(pool, vec.begin(), vec.end(),
+                                     [](int x) { return x == 0; }),
+              long(n));
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,540 @@
+#ifndef _SEGMENTED_VECTOR_H_
+#define _SEGMENTED_VECTOR_H_
+
+#include <algorithm>        // std::equal, std::min
+#include <atomic>           // std::atomic
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <iterator>         // std::random_access_iterator_tag
+#include <memory>           // std::allocator_traits
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <type_traits>      // std::enable_if_t
+#include <utility>          // std::move, std::forward
+
+#include "span.h" // sc::span
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+/// Index of the highest set bit of `x_`, which must not be zero.
+inline std::size_t highest_bit(std::size_t x_) {
+#if defined(__GNUC__)
+  return std::size_t(8 * sizeof(unsigned long long) - 1 -
+                     __builtin_clzll(x_));
+#else
+  std::size_t bit{0};
+  while (x_ >>= 1) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+/// log2 of the power of two `x_`.
+constexpr std::size_t log2_of(std::size_t x_) {
+  std::size_t bit{0};
+  while ((x_ >> bit) > 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+/// Where an index lives in a segmented layout whose first segment has
+/// 2^`first_log2_` slots and each next segment twice as many.
+struct segment_position {
+  std::size_t segment; //!< Segment number.
+  std::size_t offset;  //!< Slot inside the segment.
+
+  /*! Shifting the index by the first segment's size makes segment `s`
+   * hold the shifted indices [2^(k+s), 2^(k+s+1)): the highest bit gives
+   * the segment and the remaining bits the offset.
+   */
+  static segment_position of(std::size_t idx_, std::size_t first_log2_) {
+    std::size_t shifted = idx_ + (std::size_t{1} << first_log2_);
+    std::size_t top = highest_bit(shifted);
+    return {top - first_log2_, shifted ^ (std::size_t{1} << top)};
+  }
+};
+
+/// Reads one entry of a segment directory.
+template <typename P> P load_segment(P const &entry_) { return entry_; }
+/// Reads one entry of a directory that other threads may be publishing to.
+template <typename P> P load_segment(std::atomic<P> const &entry_) {
+  return entry_.load(std::memory_order_acquire);
+}
+} // namespace detail
+
+/// Random access iterator over a `segmented_vector`.
+/*!
+ * Besides its index, the iterator caches a pointer to its element and to
+ * the end of that segment, so stepping forward is an increment and a
+ * compare; only crossing into the next segment reads the directory.
+ * `T` may be const. `Entry` is the type of a directory entry: a plain
+ * pointer, or an atomic one for `concurrent_vector`.
+ */
+template <class T, class Entry = std::remove_cv_t<T> *>
+class SegmentedIterator {
+  using value_pointer = std::remove_cv_t<T> *;
+
+public:
+  using iterator = SegmentedIterator; //!< Alias to iterator.
+  typedef std::ptrdiff_t difference_type; //!< Distance between iterators.
+  typedef std::remove_cv_t<T> value_type; //!< Value type the iterator points to.
+  typedef T *pointer;                     //!< Pointer to the value type.
+  typedef T &reference;                   //!< Reference to the value type.
+  typedef std::random_access_iterator_tag
+      iterator_category; //!< Iterator category.
+
+  constexpr SegmentedIterator(void) = default;
+  /*! Iterator to the `idx_`-th element.
+   * \param segments_ the segment directory.
+   * \param first_log2_ log2 of the first segment's size.
+   */
+  SegmentedIterator(const Entry *segments_, std::size_t first_log2_,
+                    std::size_t idx_)
+      : m_segments{segments_}, m_first_log2{first_log2_}, m_idx{idx_} {
+    seat();
+  }
+
+  /// Converts an iterator into a const iterator, never the other way.
+  template <class U, typename = std::enable_if_t<
+                         std::is_convertible<U *, T *>::value &&
+                         !std::is_same<U, T>::value>>
+  constexpr SegmentedIterator(const SegmentedIterator<U, Entry> &other)
+      : m_segments{other.m_segments}, m_first_log2{other.m_first_log2},
+        m_idx{other.m_idx}, m_ptr{other.m_ptr}, m_segment_end{
+                                                     other.m_segment_end} {}
+
+  constexpr reference operator*(void) const { return *m_ptr; }
+  constexpr pointer operator->(void) const { return m_ptr; }
+  reference operator[](difference_type offset) const {
+    auto pos = detail::segment_position::of(m_idx + offset, m_first_log2);
+    return detail::load_segment(m_segments[pos.segment])[pos.offset];
+  }
+
+  iterator &operator++(void) {
+    ++m_idx;
+    if (++m_ptr == m_segment_end) {
+      seat();
+    }
+    return *this;
+  }
+  iterator operator++(int) {
+    iterator dummy{*this};
+    ++*this;
+    return dummy;
+  }
+  iterator &operator--(void) {
+    --m_idx;
+    seat();
+    return *this;
+  }
+  iterator operator--(int) {
+    iterator dummy{*this};
+    --*this;
+    return dummy;
+  }
+  iterator &operator+=(difference_type offset) {
+    m_idx += offset;
+    seat();
+    return *this;
+  }
+  iterator &operator-=(difference_type offset) {
+    m_idx -= offset;
+    seat();
+    return *this;
+  }
+
+  friend iterator operator+(difference_type offset, iterator it) {
+    return it += offset;
+  }
+  friend iterator operator+(iterator it, difference_type offset) {
+    return it += offset;
+  }
+  friend iterator operator-(iterator it, difference_type offset) {
+    return it -= offset;
+  }
+  friend constexpr difference_type operator-(const iterator &lhs_,
+                                             const iterator &rhs_) {
+    return difference_type(lhs_.m_idx - rhs_.m_idx);
+  }
+
+  // Iterators into the same container compare by index.
+  friend constexpr bool operator==(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx == rhs_.m_idx;
+  }
+  friend constexpr bool operator!=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx != rhs_.m_idx;
+  }
+  friend constexpr bool operator<(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx < rhs_.m_idx;
+  }
+  friend constexpr bool operator>(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx > rhs_.m_idx;
+  }
+  friend constexpr bool operator<=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx <= rhs_.m_idx;
+  }
+  friend constexpr bool operator>=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx >= rhs_.m_idx;
+  }
+
+private:
+  /// Points `m_ptr` at element `m_idx`, if its segment exists.
+  void seat(void) {
+    auto pos = detail::segment_position::of(m_idx, m_first_log2);
+    value_pointer segment =
+        m_segments ? detail::load_segment(m_segments[pos.segment]) : nullptr;
+    if (segment == nullptr) {
+      // Past the last segment: only end() gets here.
+      m_ptr = m_segment_end = nullptr;
+      return;
+    }
+    m_ptr = segment + pos.offset;
+    m_segment_end = segment + (std::size_t{1} << (m_first_log2 + pos.segment));
+  }
+
+  const Entry *m_segments{nullptr};         //!< The segment directory.
+  std::size_t m_first_log2{0};              //!< log2 of the first segment.
+  std::size_t m_idx{0};                     //!< Index of the element.
+  pointer m_ptr{nullptr};                   //!< The element.
+  pointer m_segment_end{nullptr};           //!< End of its segment.
+
+  template <class U, class E> friend class SegmentedIterator;
+};
+
+/// A sequence whose elements never move once they are in.
+/*!
+ * The elements live in segments of 2^k, 2^(k+1), 2^(k+2)... slots, where
+ * 2^k is `FirstSegment`. Growing adds a segment and leaves the existing
+ * ones alone, so push_back() never copies an element, and pointers,
+ * references and iterators to elements stay valid until those elements
+ * are erased. Peak memory while growing is the data plus the new segment,
+ * not twice the data.
+ *
+ * The directory is a fixed array of one pointer per possible segment, so
+ * it never moves either, and `operator[]` finds the segment and offset
+ * of an index with one count-leading-zeros and an xor (see
+ * `detail::segment_position`). The elements are contiguous inside each
+ * segment: `segment(s)` hands them out as an `sc::span`, for loops that
+ * the compiler can vectorize.
+ *
+ * Iterators read the directory of the container they came from, so unlike
+ * pointers to the elements they do not survive moving the container.
+ */
+template <typename T, typename Alloc = std::allocator<T>,
+          std::size_t FirstSegment = 16>
+class segmented_vector {
+  static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0,
+                "FirstSegment must be a power of two");
+  using alloc_traits = std::allocator_traits<Alloc>;
+  /// log2 of `FirstSegment`.
+  static constexpr std::size_t first_log2 = detail::log2_of(FirstSegment);
+  /// Enough segments for any index.
+  static constexpr std::size_t max_segments = 8 * sizeof(std::size_t) - first_log2;
+
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using allocator_type = Alloc;    //!< The allocator type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+  using iterator = SegmentedIterator<value_type>; //!< The iterator.
+  using const_iterator =
+      SegmentedIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  segmented_vector(void) = default;
+  explicit segmented_vector(const Alloc &alloc_) : m_alloc{alloc_} {}
+  explicit segmented_vector(size_type count_, const_reference value_ = T(),
+                            const Alloc &alloc_ = Alloc())
+      : m_alloc{alloc_} {
+    reserve(count_);
+    for (size_type i{0}; i < count_; ++i) {
+      push_back(value_);
+    }
+  }
+  segmented_vector(const std::initializer_list<T> &il,
+                   const Alloc &alloc_ = Alloc())
+      : segmented_vector(il.begin(), il.end(), alloc_) {}
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  segmented_vector(InputItr first_, InputItr last_,
+                   const Alloc &alloc_ = Alloc())
+      : m_alloc{alloc_} {
+    for (; first_ != last_; ++first_) {
+      push_back(*first_);
+    }
+  }
+  segmented_vector(const segmented_vector &other)
+      : m_alloc{alloc_traits::select_on_container_copy_construction(
+            other.m_alloc)} {
+    reserve(other.size());
+    other.for_each_segment([this](span<const T> part_) {
+      for (const auto &value : part_) {
+        push_back(value);
+      }
+    });
+  }
+  segmented_vector(segmented_vector &&other) noexcept
+      : m_alloc{std::move(other.m_alloc)} {
+    steal(other);
+  }
+  /// Copy assignment: the allocator follows `other` only if it asks to
+  /// propagate on copy, and our segments are reused if it stays the same.
+  segmented_vector &operator=(const segmented_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (m_alloc != other.m_alloc) {
+        // Our segments must go back to the allocator that gave them.
+        release();
+      }
+      m_alloc = other.m_alloc;
+    }
+    reserve(other.size());
+    other.for_each_segment([this](span<const T> part_) {
+      for (const auto &value : part_) {
+        push_back(value);
+      }
+    });
+    return *this;
+  }
+  segmented_vector &operator=(segmented_vector &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        m_alloc == other.m_alloc) {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        m_alloc = std::move(other.m_alloc);
+      }
+      steal(other);
+    } else {
+      clear();
+      for (auto &value : other) {
+        push_back(std::move(value));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+  virtual ~segmented_vector(void) { release(); }
+
+  allocator_type get_allocator(void) const { return m_alloc; }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator{m_segments, first_log2, 0}; }
+  iterator end(void) { return iterator{m_segments, first_log2, m_size}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const {
+    return const_iterator{m_segments, first_log2, 0};
+  }
+  const_iterator cend(void) const {
+    return const_iterator{m_segments, first_log2, m_size};
+  }
+
+  // [III] Capacity
+  size_type size(void) const { return m_size; }
+  bool empty(void) const { return m_size == 0; }
+  size_type capacity(void) const {
+    return (FirstSegment << m_segment_count) - FirstSegment;
+  }
+  /// Number of segments allocated.
+  size_type segment_count(void) const { return m_segment_count; }
+  /// Allocates segments until `capacity_` elements fit; nothing moves.
+  void reserve(size_type capacity_) {
+    while (capacity() < capacity_) {
+      add_segment();
+    }
+  }
+  /// Frees the segments past the last element.
+  void shrink_to_fit(void) {
+    while (m_segment_count > 0 &&
+           capacity() - segment_size(m_segment_count - 1) >= m_size) {
+      --m_segment_count;
+      alloc_traits::deallocate(m_alloc, m_segments[m_segment_count],
+                               segment_size(m_segment_count));
+      m_segments[m_segment_count] = nullptr;
+    }
+  }
+
+  // [IV] Modifiers
+  void clear(void) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for_each_segment([this](span<T> part_) {
+        for (auto &value : part_) {
+          alloc_traits::destroy(m_alloc, &value);
+        }
+      });
+    }
+    m_size = 0;
+  }
+  void push_back(const_reference value_) { emplace_back(value_); }
+  void push_back(value_type &&value_) { emplace_back(std::move(value_)); }
+  /// Constructs a new element at the end; no other element moves.
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (m_size == capacity()) {
+      // The existing elements stay put, so `args` may refer to them.
+      add_segment();
+    }
+    pointer slot = &(*this)[m_size];
+    alloc_traits::construct(m_alloc, slot, std::forward<Args>(args)...);
+    ++m_size;
+    return *slot;
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    --m_size;
+    alloc_traits::destroy(m_alloc, &(*this)[m_size]);
+  }
+
+  // [V] Element access
+  reference operator[](size_type idx_) {
+    auto pos = detail::segment_position::of(idx_, first_log2);
+    return m_segments[pos.segment][pos.offset];
+  }
+  const_reference operator[](size_type idx_) const {
+    auto pos = detail::segment_position::of(idx_, first_log2);
+    return m_segments[pos.segment][pos.offset];
+  }
+  reference at(size_type idx_) {
+    if (idx_ >= m_size) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  const_reference at(size_type idx_) const {
+    if (idx_ >= m_size) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[0];
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[0];
+  }
+  reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[m_size - 1];
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[m_size - 1];
+  }
+
+  /// The elements of segment `s_`, which are contiguous.
+  span<T> segment(size_type s_) {
+    return {m_segments[s_], segment_used(s_)};
+  }
+  span<const T> segment(size_type s_) const {
+    return {m_segments[s_], segment_used(s_)};
+  }
+  /// Calls `fn_` with each non-empty segment, in order, as a span.
+  template <typename Fn> void for_each_segment(Fn &&fn_) {
+    for (size_type s{0}; s < m_segment_count && segment_used(s) > 0; ++s) {
+      fn_(segment(s));
+    }
+  }
+  template <typename Fn> void for_each_segment(Fn &&fn_) const {
+    for (size_type s{0}; s < m_segment_count && segment_used(s) > 0; ++s) {
+      fn_(segment(s));
+    }
+  }
+
+  // [VI] Operators
+  friend bool operator==(const segmented_vector &lhs_,
+                         const segmented_vector &rhs_) {
+    return lhs_.size() == rhs_.size() &&
+           std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+  }
+  friend bool operator!=(const segmented_vector &lhs_,
+                         const segmented_vector &rhs_) {
+    return !(lhs_ == rhs_);
+  }
+  friend std::ostream &operator<<(std::ostream &os_,
+                                  const segmented_vector &v_) {
+    os_ << "[ ";
+    for (const auto &value : v_) {
+      os_ << value << " ";
+    }
+    os_ << "]";
+    return os_;
+  }
+  friend void swap(segmented_vector &first_, segmented_vector &second_) {
+    using std::swap;
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      swap(first_.m_alloc, second_.m_alloc);
+    }
+    swap(first_.m_segments, second_.m_segments);
+    swap(first_.m_segment_count, second_.m_segment_count);
+    swap(first_.m_size, second_.m_size);
+  }
+
+private:
+  static size_type segment_size(size_type s_) { return FirstSegment << s_; }
+  /// How many elements segment `s_` holds.
+  size_type segment_used(size_type s_) const {
+    size_type first = (FirstSegment << s_) - FirstSegment;
+    return m_size <= first ? 0 : std::min(m_size - first, segment_size(s_));
+  }
+
+  void add_segment(void) {
+    if (m_segment_count == max_segments) {
+      throw std::length_error("Capacidade grande demais!");
+    }
+    m_segments[m_segment_count] =
+        alloc_traits::allocate(m_alloc, segment_size(m_segment_count));
+    ++m_segment_count;
+  }
+  /// Destroys the elements and frees every segment.
+  void release(void) {
+    clear();
+    for (size_type s{0}; s < m_segment_count; ++s) {
+      alloc_traits::deallocate(m_alloc, m_segments[s], segment_size(s));
+      m_segments[s] = nullptr;
+    }
+    m_segment_count = 0;
+  }
+  /// Takes the segments of `other`, leaving it empty.
+  void steal(segmented_vector &other) {
+    for (size_type s{0}; s < max_segments; ++s) {
+      m_segments[s] = other.m_segments[s];
+      other.m_segments[s] = nullptr;
+    }
+    m_segment_count = other.m_segment_count;
+    m_size = other.m_size;
+    other.m_segment_count = 0;
+    other.m_size = 0;
+  }
+
+  Alloc m_alloc;                          //!< Allocates the segments.
+  pointer m_segments[max_segments]{};     //!< Segment `s` has 2^(k+s) slots.
+  size_type m_segment_count{0};           //!< Segments allocated.
+  size_type m_size{0};                    //!< Number of elements.
+};
+} // namespace sc
+
+#endif
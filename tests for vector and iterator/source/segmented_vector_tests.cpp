@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "segmented_vector.h"
+#include "test_helpers.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Eleventh batch of tests, focused on sc::segmented_vector
+// =============================================================
+
+// Growing never moves, copies or re-addresses an element.
+#define STABLE_ADDRESSES YES
+// operator[], iterators and segments agree on where each element is.
+#define SEGMENT_INDEXING YES
+// Non-trivial elements are built and destroyed exactly once.
+#define SEGMENTED_LIFETIME YES
+// Copy assignment keeps each side's memory resource.
+#define PMR_COPY_ASSIGN YES
+
+namespace {
+using test_helpers::Counted;
+using test_helpers::CountingResource;
+} // namespace
+
+void run_segmented_vector_tests(void) {
+  TestManager tm{"Segmented vector testing"};
+
+#if STABLE_ADDRESSES
+  {
+    BEGIN_TEST(tm, "StableAddresses", "push_back never relocates");
+
+    sc::segmented_vector<Counted> vec;
+    Counted::transfers = 0;
+    vec.emplace_back("first");
+    const Counted *first = &vec[0];
+    const Counted *hundredth{nullptr};
+    for (int i{1}; i < 5000; ++i) {
+      vec.emplace_back(std::to_string(i));
+      if (i == 100)
+        hundredth = &vec[100];
+    }
+    EXPECT_EQ(Counted::transfers, 0);
+    EXPECT_EQ(&vec[0], first);
+    EXPECT_EQ(&vec[100], hundredth);
+    EXPECT_EQ(first->value, "first");
+    EXPECT_EQ(hundredth->value, "100");
+
+    // An argument that refers to the container itself.
+    vec.push_back(vec[100]);
+    EXPECT_EQ(vec.back().value, "100");
+
+    // Moving the container keeps the elements where they are.
+    sc::segmented_vector<Counted> moved{std::move(vec)};
+    EXPECT_EQ(&moved[0], first);
+    EXPECT_TRUE(vec.empty());
+  }
+#endif
+
+#if SEGMENT_INDEXING
+  {
+    BEGIN_TEST(tm, "SegmentIndexing", "2^k, 2^(k+1), ... slots per segment");
+
+    using iterator = sc::segmented_vector<int>::iterator;
+    static_assert(std::is_same<std::iterator_traits<iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "random access iterator");
+
+    sc::segmented_vector<int, std::allocator<int>, 4> vec;
+    for (int i{0}; i < 100; ++i)
+      vec.push_back(i);
+    // Segments of 4, 8, 16, 32, 64 slots.
+    EXPECT_EQ(vec.segment_count(), 5);
+    EXPECT_EQ(vec.capacity(), 124);
+    EXPECT_EQ(vec.segment(0).size(), 4);
+    EXPECT_EQ(vec.segment(2)[0], 12);
+    EXPECT_EQ(vec.segment(4).size(), 40);
+    EXPECT_EQ(&vec.segment(2)[0], &vec[12]);
+
+    bool matched{true};
+    for (int i{0}; i < 100; ++i)
+      matched = matched && vec[i] == i && vec.at(i) == i;
+    EXPECT_TRUE(matched);
+
+    int expected{0};
+    for (int v : vec)
+      matched = matched && v == expected++;
+    EXPECT_TRUE(matched);
+    EXPECT_EQ(expected, 100);
+
+    long sum{0};
+    vec.for_each_segment([&sum](sc::span<int> part) {
+      for (int v : part)
+        sum += v;
+    });
+    EXPECT_EQ(sum, 4950);
+
+    auto it = vec.begin() + 50;
+    EXPECT_EQ(*it, 50);
+    EXPECT_EQ(it[-40], 10);
+    EXPECT_EQ(*--it, 49);
+    EXPECT_EQ(vec.end() - vec.begin(), 100);
+    std::reverse(vec.begin(), vec.end());
+    EXPECT_EQ(vec.front(), 99);
+    EXPECT_EQ(vec[88], 11);
+    std::sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+    EXPECT_EQ(*std::lower_bound(vec.cbegin(), vec.cend(), 60), 60);
+
+    while (vec.size() > 20)
+      vec.pop_back();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.segment_count(), 3); // 4 + 8 < 20 <= 4 + 8 + 16
+    vec.reserve(1000);
+    EXPECT_TRUE(vec.capacity() >= 1000);
+    EXPECT_EQ(vec.back(), 19);
+  }
+#endif
+
+#if SEGMENTED_LIFETIME
+  {
+    BEGIN_TEST(tm, "SegmentedLifetime", "ctor/dtor calls are balanced");
+
+    Counted::alive = 0;
+    {
+      sc::segmented_vector<Counted> vec;
+      for (int i{0}; i < 300; ++i)
+        vec.emplace_back(std::string(20, char('a' + i % 26)));
+      vec.pop_back();
+      EXPECT_EQ(Counted::alive, 299);
+
+      sc::segmented_vector<Counted> copy{vec};
+      EXPECT_EQ(Counted::alive, 598);
+      EXPECT_EQ(copy, vec);
+      sc::segmented_vector<Counted> moved{std::move(copy)};
+      copy = moved;
+      moved = std::move(vec);
+      EXPECT_EQ(Counted::alive, 598);
+      swap(moved, copy);
+      moved.clear();
+      EXPECT_EQ(Counted::alive, 299);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+  }
+#endif
+
+#if PMR_COPY_ASSIGN
+  {
+    BEGIN_TEST(tm, "PmrCopyAssign", "a = b keeps a's memory resource");
+
+    using segmented =
+        sc::segmented_vector<int, std::pmr::polymorphic_allocator<int>>;
+    EXPECT_TRUE(test_helpers::pmr_assign_and_swap<segmented>());
+
+    // The segments are reused when the resource stays the same.
+    CountingResource left, right;
+    {
+      segmented a{&left};
+      segmented b{&right};
+      for (int i{0}; i < 1000; ++i)
+        b.push_back(i);
+      a = b;
+      const int *first = &a[0];
+      long before{left.live};
+      a = b;
+      EXPECT_TRUE(&a[0] == first);
+      EXPECT_EQ(left.live, before);
+    }
+    EXPECT_EQ(left.live, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,579 @@
+#ifndef _SERIALIZE_H_
+#define _SERIALIZE_H_
+
+#include <algorithm>   // std::min, std::max
+#include <cerrno>      // errno, EINTR
+#include <climits>     // IOV_MAX
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <cstring>     // std::memcpy, std::memcmp
+#include <stdexcept>   // std::runtime_error, std::out_of_range
+#include <string>      // std::string
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::exchange
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <sys/uio.h>  // writev, iovec
+#include <unistd.h>   // close
+
+#include "io.h"     // sc::detail::throw_errno
+#include "span.h"   // sc::span
+#include "vector.h" // sc::vector, sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+/// The binary file format written by `sc::save`.
+/*!
+ * A file starts with a 64-byte `header`. For a flat vector the elements
+ * follow, in their in-memory representation, from `payload_offset`. For
+ * a vector of vectors there is first a table of `count + 1` 64-bit
+ * offsets, in elements, where each row starts and the last one ends; then
+ * the rows, back to back.
+ *
+ * The payload starts at a multiple of `alignment`, which is at least a
+ * cache line, so a mapping of the whole file (mappings start on a page)
+ * hands out correctly aligned elements and SIMD code can rely on it.
+ *
+ * Numbers are in the byte order of the machine that wrote the file. A
+ * file from the other byte order fails the version check.
+ */
+namespace format {
+/// First bytes of every file.
+constexpr char magic[8] = {'S', 'C', 'V', 'E', 'C', 'T', 'O', 'R'};
+/// Bumped whenever the layout changes.
+constexpr std::uint32_t version = 2;
+/// The least alignment of the payload.
+constexpr std::uint64_t min_alignment = 64;
+
+/// What the payload holds.
+enum class kind : std::uint32_t {
+  flat = 1,   //!< The elements of one vector.
+  nested = 2, //!< The offset table, then the rows of a vector of vectors.
+};
+
+/// The start of every file.
+struct header {
+  char magic[8];               //!< `format::magic`.
+  std::uint32_t version;       //!< `format::version`.
+  std::uint32_t kind;          //!< A `format::kind`.
+  std::uint64_t element_size;  //!< `sizeof` an element.
+  std::uint64_t count;         //!< Number of elements, or of rows.
+  std::uint64_t alignment;     //!< The payload offset is a multiple of it.
+  std::uint64_t payload_offset; //!< Where the elements start.
+  std::uint64_t payload_bytes; //!< How many bytes of elements there are.
+  std::uint64_t checksum;      //!< `format::checksum` of the header, with
+                               //!< this field zeroed, and what follows.
+};
+static_assert(sizeof(header) == 64, "the header must stay 64 bytes long");
+
+/// A 64-bit checksum in the style of xxHash64, fed incrementally.
+/*!
+ * Four independent lanes take 8 bytes each per 32-byte block, so the
+ * multiplies overlap and it runs at several bytes per cycle. The result
+ * only depends on the bytes fed in, not on how they were split.
+ */
+class checksum {
+public:
+  /// Feeds `bytes_` bytes from `data_`.
+  void update(const void *data_, std::size_t bytes_) {
+    if (bytes_ == 0) {
+      return; // `data_` may be null.
+    }
+    auto *in = static_cast<const unsigned char *>(data_);
+    m_total += bytes_;
+    if (m_pending > 0) {
+      std::size_t take = std::min(bytes_, block - m_pending);
+      std::memcpy(m_block + m_pending, in, take);
+      m_pending += take;
+      in += take;
+      bytes_ -= take;
+      if (m_pending < block) {
+        return;
+      }
+      consume(m_block);
+      m_pending = 0;
+    }
+    for (; bytes_ >= block; in += block, bytes_ -= block) {
+      consume(in);
+    }
+    std::memcpy(m_block, in, bytes_);
+    m_pending = bytes_;
+  }
+  /// The checksum of everything fed so far.
+  std::uint64_t digest(void) const {
+    std::uint64_t h = rotl(m_lanes[0], 1) + rotl(m_lanes[1], 7) +
+                      rotl(m_lanes[2], 12) + rotl(m_lanes[3], 18);
+    h ^= m_total * prime1;
+    std::size_t i{0};
+    for (; i + 8 <= m_pending; i += 8) {
+      h = rotl(h ^ round(0, load(m_block + i)), 27) * prime1 + prime4;
+    }
+    for (; i < m_pending; ++i) {
+      h = rotl(h ^ (m_block[i] * prime5), 11) * prime1;
+    }
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    return h ^ (h >> 32);
+  }
+
+private:
+  static constexpr std::size_t block = 32;
+  static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+  static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+  static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ull;
+  static constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+  static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+  static std::uint64_t rotl(std::uint64_t x_, int r_) {
+    return (x_ << r_) | (x_ >> (64 - r_));
+  }
+  static std::uint64_t load(const unsigned char *in_) {
+    std::uint64_t word;
+    std::memcpy(&word, in_, sizeof(word));
+    return word;
+  }
+  static std::uint64_t round(std::uint64_t lane_, std::uint64_t word_) {
+    return rotl(lane_ + word_ * prime2, 31) * prime1;
+  }
+  void consume(const unsigned char *in_) {
+    for (int lane{0}; lane < 4; ++lane) {
+      m_lanes[lane] = round(m_lanes[lane], load(in_ + 8 * lane));
+    }
+  }
+
+  std::uint64_t m_lanes[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+  unsigned char m_block[block];   //!< Bytes waiting for a full block.
+  std::size_t m_pending{0};       //!< How many bytes are waiting.
+  std::uint64_t m_total{0};       //!< How many bytes were fed.
+};
+} // namespace format
+
+namespace detail {
+/// Writes every buffer in `iov_`, going on after partial writes.
+inline void write_all(int fd_, ::iovec *iov_, std::size_t count_) {
+  while (count_ > 0) {
+    int batch = int(std::min<std::size_t>(count_, IOV_MAX));
+    ssize_t written = ::writev(fd_, iov_, batch);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("não foi possível escrever o arquivo");
+    }
+    auto left = std::size_t(written);
+    for (; count_ > 0 && left >= iov_->iov_len; ++iov_, --count_) {
+      left -= iov_->iov_len;
+    }
+    if (left > 0) {
+      iov_->iov_base = static_cast<char *>(iov_->iov_base) + left;
+      iov_->iov_len -= left;
+    }
+  }
+}
+
+/// Where the payload starts, after `prefix_` bytes, for elements of `T`.
+template <typename T> std::uint64_t payload_offset(std::uint64_t prefix_) {
+  std::uint64_t alignment = std::max<std::uint64_t>(format::min_alignment,
+                                                    alignof(T));
+  return (prefix_ + alignment - 1) / alignment * alignment;
+}
+
+/// A header for elements of type `T`, without the checksum.
+template <typename T>
+format::header make_header(format::kind kind_, std::uint64_t count_,
+                           std::uint64_t prefix_, std::uint64_t bytes_) {
+  static_assert(alignof(T) <= 4096, "the padding is at most a page long");
+  format::header head{};
+  std::memcpy(head.magic, format::magic, sizeof(head.magic));
+  head.version = format::version;
+  head.kind = std::uint32_t(kind_);
+  head.element_size = sizeof(T);
+  head.count = count_;
+  head.alignment = std::max<std::uint64_t>(format::min_alignment, alignof(T));
+  head.payload_offset = payload_offset<T>(prefix_);
+  head.payload_bytes = bytes_;
+  return head;
+}
+
+/// Writes `iov_` to a new file at `path_`, replacing the one there.
+inline void write_file(const std::string &path_, ::iovec *iov_,
+                       std::size_t count_) {
+  int fd = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw_errno("não foi possível criar o arquivo");
+  }
+  try {
+    write_all(fd, iov_, count_);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  if (::close(fd) != 0) {
+    throw_errno("não foi possível escrever o arquivo");
+  }
+}
+
+/// Zeros written between the header and the payload.
+inline const unsigned char *padding(void) {
+  static const unsigned char zeros[4096] = {};
+  return zeros;
+}
+
+/// A whole file, mapped read-only, whose header was checked.
+/*!
+ * The descriptor is closed as soon as the file is mapped: the mapping
+ * keeps the file alive on its own.
+ */
+class mapped_file {
+public:
+  mapped_file(void) noexcept = default;
+  /// Maps `path_` and checks it holds a `kind_` payload of `T`s.
+  template <typename T>
+  static mapped_file open(const std::string &path_, format::kind kind_) {
+    mapped_file file;
+    int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw_errno("não foi possível abrir o arquivo");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw_errno("não foi possível ler o tamanho do arquivo");
+    }
+    file.m_bytes = std::size_t(info.st_size);
+    if (file.m_bytes >= sizeof(format::header)) {
+      void *addr = ::mmap(nullptr, file.m_bytes, PROT_READ, MAP_SHARED, fd, 0);
+      if (addr == MAP_FAILED) {
+        ::close(fd);
+        throw_errno("não foi possível mapear o arquivo");
+      }
+      file.m_base = static_cast<const unsigned char *>(addr);
+    }
+    ::close(fd);
+    file.check<T>(kind_);
+    return file;
+  }
+  ~mapped_file(void) {
+    if (m_base != nullptr) {
+      ::munmap(const_cast<unsigned char *>(m_base), m_bytes);
+    }
+  }
+  mapped_file(mapped_file &&other) noexcept
+      : m_base{std::exchange(other.m_base, nullptr)},
+        m_bytes{std::exchange(other.m_bytes, 0)} {}
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    std::swap(m_base, other.m_base);
+    std::swap(m_bytes, other.m_bytes);
+    return *this;
+  }
+
+  /// Whether a file is mapped.
+  bool mapped(void) const { return m_base != nullptr; }
+  const format::header &header(void) const {
+    return *reinterpret_cast<const format::header *>(m_base);
+  }
+  /// The byte at `offset_` from the start of the file.
+  const unsigned char *at(std::uint64_t offset_) const {
+    return m_base + offset_;
+  }
+  /// Whether the checksum matches the contents.
+  bool verify(void) const {
+    const format::header &head = header();
+    format::header blank = head;
+    blank.checksum = 0;
+    format::checksum sum;
+    sum.update(&blank, sizeof(blank));
+    if (head.kind == std::uint32_t(format::kind::nested)) {
+      sum.update(at(sizeof(format::header)),
+                 (head.count + 1) * sizeof(std::uint64_t));
+    }
+    sum.update(at(head.payload_offset), head.payload_bytes);
+    return sum.digest() == head.checksum;
+  }
+
+private:
+  /// Throws `std::runtime_error` unless the file is a well formed `kind_`
+  /// file of `T`s.
+  template <typename T> void check(format::kind kind_) const {
+    if (m_base == nullptr ||
+        std::memcmp(header().magic, format::magic, sizeof(format::magic)) != 0) {
+      throw std::runtime_error("O arquivo não guarda um sc::vector!");
+    }
+    const format::header &head = header();
+    if (head.version != format::version) {
+      throw std::runtime_error("Versão do formato não suportada!");
+    }
+    if (head.kind != std::uint32_t(kind_)) {
+      throw std::runtime_error("O arquivo guarda outro tipo de vector!");
+    }
+    if (head.element_size != sizeof(T) || head.payload_offset % alignof(T) != 0) {
+      throw std::runtime_error("Os elementos do arquivo são de outro tipo!");
+    }
+    std::uint64_t prefix = sizeof(format::header);
+    if (kind_ == format::kind::nested) {
+      // The `count` + 1 offsets must fit in the file; a larger count would
+      // also wrap the product below.
+      if (head.count >=
+          (m_bytes - sizeof(format::header)) / sizeof(std::uint64_t)) {
+        throw std::runtime_error("O arquivo está truncado!");
+      }
+      prefix += (head.count + 1) * sizeof(std::uint64_t);
+    }
+    if (head.payload_offset < prefix || head.payload_offset > m_bytes ||
+        head.payload_bytes > m_bytes - head.payload_offset ||
+        head.payload_bytes % sizeof(T) != 0) {
+      throw std::runtime_error("O arquivo está truncado!");
+    }
+    // Divided rather than multiplied, so a forged count cannot wrap.
+    if (kind_ == format::kind::flat &&
+        head.count != head.payload_bytes / sizeof(T)) {
+      throw std::runtime_error("O arquivo está truncado!");
+    }
+  }
+
+  const unsigned char *m_base{nullptr}; //!< The mapping.
+  std::size_t m_bytes{0};               //!< Length of the file.
+};
+} // namespace detail
+
+/// A read-only vector over a file written by `sc::save`.
+/*!
+ * Opening maps the file and checks its header; the elements are then
+ * used where they lie, without being read or copied. Only the pages that
+ * are touched are brought into memory.
+ *
+ * The checksum is only checked when asked for, since that reads the
+ * whole file: pass `verify_ = true`, or call `verify()`.
+ */
+template <typename T> class vector_view {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be loaded from a file");
+
+public:
+  using size_type = unsigned long;  //!< The size type.
+  using value_type = T;             //!< The value type.
+  using const_reference = const T &; //!< Reference to an element.
+  using const_iterator =
+      MyForwardIterator<const value_type>; //!< The const_iterator.
+  using iterator = const_iterator;          //!< The elements are read-only.
+
+  vector_view(void) noexcept = default;
+  /*! Maps the file at `path_`.
+   * \throw std::system_error if it cannot be opened or mapped.
+   * \throw std::runtime_error if it does not hold a vector of `T`, or if
+   * `verify_` is set and the checksum does not match.
+   */
+  explicit vector_view(const std::string &path_, bool verify_ = false)
+      : m_file{detail::mapped_file::open<T>(path_, format::kind::flat)} {
+    if (verify_ && !verify()) {
+      throw std::runtime_error("O checksum do arquivo não confere!");
+    }
+  }
+
+  const_iterator begin(void) const { return const_iterator{data()}; }
+  const_iterator end(void) const { return const_iterator{data() + size()}; }
+  const_iterator cbegin(void) const { return begin(); }
+  const_iterator cend(void) const { return end(); }
+
+  size_type size(void) const {
+    return m_file.mapped() ? size_type(m_file.header().count) : 0;
+  }
+  bool empty(void) const { return size() == 0; }
+
+  const_reference operator[](size_type idx) const { return data()[idx]; }
+  const_reference at(size_type idx) const {
+    if (idx >= size()) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return data()[idx];
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return data()[0];
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return data()[size() - 1];
+  }
+  const T *data(void) const {
+    if (!m_file.mapped()) {
+      return nullptr;
+    }
+    return reinterpret_cast<const T *>(
+        m_file.at(m_file.header().payload_offset));
+  }
+  /// Whether the checksum matches the elements. Reads the whole file.
+  bool verify(void) const { return !m_file.mapped() || m_file.verify(); }
+
+private:
+  detail::mapped_file m_file; //!< The mapped file.
+};
+
+/// A read-only vector of vectors over a file written by `sc::save`.
+/*!
+ * Each row is handed out as a `sc::span` into the mapping; see
+ * `vector_view` for the rest.
+ */
+template <typename T> class nested_view {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be loaded from a file");
+
+public:
+  using size_type = unsigned long;     //!< The size type.
+  using value_type = span<const T>;    //!< A row.
+
+  nested_view(void) noexcept = default;
+  /// Maps the file at `path_`, like `vector_view`.
+  explicit nested_view(const std::string &path_, bool verify_ = false)
+      : m_file{detail::mapped_file::open<T>(path_, format::kind::nested)} {
+    const std::uint64_t *table = offsets();
+    std::uint64_t total = m_file.header().payload_bytes / sizeof(T);
+    // A row past the payload would read outside the file.
+    for (size_type i{0}; i < size(); ++i) {
+      if (table[i] > table[i + 1] || table[i + 1] > total) {
+        throw std::runtime_error("O arquivo está corrompido!");
+      }
+    }
+    if (verify_ && !verify()) {
+      throw std::runtime_error("O checksum do arquivo não confere!");
+    }
+  }
+
+  /// Number of rows.
+  size_type size(void) const {
+    return m_file.mapped() ? size_type(m_file.header().count) : 0;
+  }
+  bool empty(void) const { return size() == 0; }
+  /// Number of elements in all the rows.
+  size_type elements(void) const {
+    return m_file.mapped() ? size_type(m_file.header().payload_bytes / sizeof(T))
+                        : 0;
+  }
+
+  value_type operator[](size_type idx) const {
+    const std::uint64_t *table = offsets();
+    return value_type{payload() + table[idx],
+                      std::size_t(table[idx + 1] - table[idx])};
+  }
+  value_type at(size_type idx) const {
+    if (idx >= size()) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx];
+  }
+  /// Whether the checksum matches the rows. Reads the whole file.
+  bool verify(void) const { return !m_file.mapped() || m_file.verify(); }
+
+private:
+  const std::uint64_t *offsets(void) const {
+    return reinterpret_cast<const std::uint64_t *>(
+        m_file.at(sizeof(format::header)));
+  }
+  const T *payload(void) const {
+    return reinterpret_cast<const T *>(
+        m_file.at(m_file.header().payload_offset));
+  }
+
+  detail::mapped_file m_file; //!< The mapped file.
+};
+
+/*! Writes `vec_` to a new file at `path_`, in `sc::format`, with a
+ * single `writev` for the header and the elements.
+ * \throw std::system_error if the file cannot be written.
+ */
+template <typename T, typename Alloc, typename Growth, std::size_t InlineN>
+void save(const std::string &path_,
+          const vector<T, Alloc, Growth, InlineN> &vec_) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be saved to a file");
+  std::uint64_t bytes = vec_.size() * sizeof(T);
+  format::header head = detail::make_header<T>(
+      format::kind::flat, vec_.size(), sizeof(format::header), bytes);
+  format::checksum sum;
+  sum.update(&head, sizeof(head));
+  sum.update(vec_.data(), bytes);
+  head.checksum = sum.digest();
+
+  ::iovec iov[] = {
+      {&head, sizeof(head)},
+      {const_cast<unsigned char *>(detail::padding()),
+       head.payload_offset - sizeof(head)},
+      {const_cast<T *>(vec_.data()), bytes},
+  };
+  detail::write_file(path_, iov, 3);
+}
+
+/*! Writes the vector of vectors `rows_` to a new file at `path_`, in
+ * `sc::format`. The rows are gathered straight from where they lie, one
+ * `iovec` each, so none is copied into a staging buffer.
+ * \throw std::system_error if the file cannot be written.
+ */
+template <typename T, typename Alloc, typename Growth, std::size_t InlineN,
+          typename OuterAlloc, typename OuterGrowth, std::size_t OuterN>
+void save(const std::string &path_,
+          const vector<vector<T, Alloc, Growth, InlineN>, OuterAlloc,
+                       OuterGrowth, OuterN> &rows_) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be saved to a file");
+  vector<std::uint64_t> table;
+  table.reserve(rows_.size() + 1);
+  table.push_back(0);
+  for (const auto &row : rows_) {
+    table.push_back(table.back() + row.size());
+  }
+  std::uint64_t table_bytes = table.size() * sizeof(std::uint64_t);
+  std::uint64_t bytes = table.back() * sizeof(T);
+  format::header head =
+      detail::make_header<T>(format::kind::nested, rows_.size(),
+                             sizeof(format::header) + table_bytes, bytes);
+
+  vector<::iovec> iov;
+  iov.reserve(rows_.size() + 3);
+  iov.push_back({&head, sizeof(head)});
+  iov.push_back({table.data(), table_bytes});
+  iov.push_back({const_cast<unsigned char *>(detail::padding()),
+                 head.payload_offset - sizeof(head) - table_bytes});
+  format::checksum sum;
+  sum.update(&head, sizeof(head));
+  sum.update(table.data(), table_bytes);
+  for (const auto &row : rows_) {
+    sum.update(row.data(), row.size() * sizeof(T));
+    if (!row.empty()) {
+      iov.push_back({const_cast<T *>(row.data()), row.size() * sizeof(T)});
+    }
+  }
+  head.checksum = sum.digest();
+  detail::write_file(path_, iov.data(), iov.size());
+}
+
+/*! Reads a file written by `sc::save` into a new vector.
+ * \throw std::system_error if it cannot be read.
+ * \throw std::runtime_error if it does not hold a vector of `T`, or its
+ * checksum does not match.
+ */
+template <typename T> vector<T> load(const std::string &path_) {
+  vector_view<T> view{path_, true};
+  return vector<T>(view.begin(), view.end());
+}
+
+/// Reads a file of rows written by `sc::save` into a new vector of vectors.
+template <typename T> vector<vector<T>> load_nested(const std::string &path_) {
+  nested_view<T> view{path_, true};
+  vector<vector<T>> rows;
+  rows.reserve(view.size());
+  for (std::size_t i{0}; i < view.size(); ++i) {
+    rows.emplace_back(view[i].begin(), view[i].end());
+  }
+  return rows;
+}
+} // namespace sc
+
+#endif
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <unistd.h>
+
+#include "serialize.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Eighteenth batch of tests, focused on the binary file format
+// =============================================================
+
+// save() then load() gives back the same vector.
+#define ROUND_TRIP YES
+// vector_view maps the file without copying.
+#define VIEWS YES
+// Vectors of vectors, written with one iovec per row.
+#define NESTED YES
+// Broken, truncated or foreign files are refused.
+#define BAD_FILES YES
+
+namespace {
+/// A scratch file path, unique to this process.
+std::string scratch_path(const std::string &name_) {
+  return "/tmp/sc_serialize_" + std::to_string(::getpid()) + "_" + name_;
+}
+
+/// Overwrites the byte at `offset_` of the file at `path_`.
+void poke(const std::string &path_, long offset_, char byte_) {
+  std::fstream file{path_, std::ios::binary | std::ios::in | std::ios::out};
+  file.seekp(offset_);
+  file.put(byte_);
+}
+
+/// Whether opening `path_` as a view of `T` throws `std::runtime_error`.
+template <typename T> bool refused(const std::string &path_, bool verify_) {
+  try {
+    sc::vector_view<T> view{path_, verify_};
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+void run_serialize_tests(void) {
+  TestManager tm{"Serialization testing"};
+
+#if ROUND_TRIP
+  {
+    BEGIN_TEST(tm, "RoundTrip", "load(save(v)) == v");
+
+    std::string path = scratch_path("round_trip");
+    sc::vector<std::int64_t> longs;
+    for (std::int64_t i{0}; i < 100'000; ++i) {
+      longs.push_back(i * i - 7);
+    }
+    sc::save(path, longs);
+    EXPECT_TRUE(sc::load<std::int64_t>(path) == longs);
+
+    // Every length around the checksum's block size.
+    bool same{true};
+    for (std::size_t n{0}; n < 70; ++n) {
+      sc::vector<char> bytes;
+      for (std::size_t i{0}; i < n; ++i) {
+        bytes.push_back(char('a' + i % 26));
+      }
+      sc::save(path, bytes);
+      same = same && sc::load<char>(path) == bytes;
+    }
+    EXPECT_TRUE(same);
+
+    sc::save(path, sc::vector<double>{});
+    EXPECT_TRUE(sc::load<double>(path).empty());
+    std::remove(path.c_str());
+  }
+#endif
+
+#if VIEWS
+  {
+    BEGIN_TEST(tm, "Views", "the elements are used in place");
+
+    std::string path = scratch_path("views");
+    sc::vector<float> floats{1.5f, 2.5f, -3.0f, 4.0f};
+    sc::save(path, floats);
+    sc::vector_view<float> view{path, true};
+    EXPECT_EQ(view.size(), floats.size());
+    EXPECT_EQ(view.front(), 1.5f);
+    EXPECT_EQ(view.back(), 4.0f);
+    EXPECT_EQ(view.at(2), -3.0f);
+    EXPECT_TRUE(view.verify());
+    // The payload is aligned to a cache line.
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.data()) % 64, 0u);
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), floats.begin()));
+
+    // The view outlives the file name.
+    std::remove(path.c_str());
+    EXPECT_EQ(view[1], 2.5f);
+
+    sc::vector_view<float> moved{std::move(view)};
+    EXPECT_EQ(moved.size(), 4ul);
+    EXPECT_TRUE(sc::vector_view<float>{}.empty());
+    bool thrown{false};
+    try {
+      moved.at(4);
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+#if NESTED
+  {
+    BEGIN_TEST(tm, "Nested", "vectors of vectors keep their rows");
+
+    std::string path = scratch_path("nested");
+    sc::vector<sc::vector<std::int32_t>> rows;
+    for (int r{0}; r < 3000; ++r) {
+      sc::vector<std::int32_t> row;
+      // Some rows are empty.
+      for (int i{0}; i < r % 7; ++i) {
+        row.push_back(r * 10 + i);
+      }
+      rows.push_back(row);
+    }
+    sc::save(path, rows);
+    EXPECT_TRUE(sc::load_nested<std::int32_t>(path) == rows);
+
+    sc::nested_view<std::int32_t> view{path, true};
+    EXPECT_EQ(view.size(), rows.size());
+    EXPECT_EQ(view[13].size(), 6ul);
+    EXPECT_EQ(view[13][5], 135);
+    EXPECT_TRUE(view[14].empty());
+    std::size_t elements{0};
+    for (const auto &row : rows) {
+      elements += row.size();
+    }
+    EXPECT_EQ(view.elements(), elements);
+
+    // A nested file is not a flat one.
+    EXPECT_TRUE(refused<std::int32_t>(path, false));
+
+    // A row count whose offset table would wrap around 64 bits. With only
+    // empty rows every offset read is 0, so only the count check keeps the
+    // walk from running off the mapping.
+    sc::save(path, sc::vector<sc::vector<std::int32_t>>(1000));
+    poke(path, 31, 0x20);
+    bool thrown{false};
+    try {
+      sc::nested_view<std::int32_t> huge{path};
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    std::remove(path.c_str());
+  }
+#endif
+
+#if BAD_FILES
+  {
+    BEGIN_TEST(tm, "BadFiles", "broken files are refused");
+
+    std::string path = scratch_path("bad");
+    sc::vector<std::uint32_t> values{1, 2, 3, 4, 5, 6, 7, 8};
+    sc::save(path, values);
+    // Another element type.
+    EXPECT_TRUE(refused<std::uint64_t>(path, false));
+    EXPECT_TRUE(refused<std::uint16_t>(path, false));
+    // A flipped payload byte is only caught by the checksum.
+    poke(path, 64, 9);
+    EXPECT_FALSE(refused<std::uint32_t>(path, false));
+    EXPECT_TRUE(refused<std::uint32_t>(path, true));
+    bool thrown{false};
+    try {
+      sc::load<std::uint32_t>(path);
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    // A count whose byte size wraps around 64 bits back to the payload's:
+    // 2^61 + 2 eight-byte elements. The checksum covers the header too.
+    sc::save(path, sc::vector<std::uint64_t>{1, 2});
+    poke(path, 31, 0x20);
+    EXPECT_TRUE(refused<std::uint64_t>(path, false));
+    sc::save(path, sc::vector<std::uint64_t>{1, 2});
+    poke(path, 33, 1);
+    EXPECT_FALSE(refused<std::uint64_t>(path, false));
+    EXPECT_TRUE(refused<std::uint64_t>(path, true));
+    // A newer version, and no magic at all.
+    sc::save(path, values);
+    poke(path, 8, 9);
+    EXPECT_TRUE(refused<std::uint32_t>(path, false));
+    poke(path, 0, 'X');
+    EXPECT_TRUE(refused<std::uint32_t>(path, false));
+    // Cut short.
+    sc::save(path, values);
+    EXPECT_EQ(::truncate(path.c_str(), 80), 0);
+    EXPECT_TRUE(refused<std::uint32_t>(path, false));
+    EXPECT_EQ(::truncate(path.c_str(), 10), 0);
+    EXPECT_TRUE(refused<std::uint32_t>(path, false));
+    std::remove(path.c_str());
+
+    thrown = false;
+    try {
+      sc::vector_view<int> view{path};
+    } catch (const std::system_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
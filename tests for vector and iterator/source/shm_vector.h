@@ -0,0 +1,576 @@
+#ifndef _SHM_VECTOR_H_
+#define _SHM_VECTOR_H_
+
+#include <algorithm>   // std::max, std::copy, std::fill
+#include <atomic>      // std::atomic, std::atomic_thread_fence
+#include <chrono>      // std::chrono::steady_clock, std::chrono::milliseconds
+#include <cerrno>      // errno
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <cstring>     // std::memcpy, std::memcmp
+#include <iterator>    // std::distance
+#include <new>         // placement new
+#include <stdexcept>   // std::length_error, std::logic_error, std::runtime_error
+#include <string>      // std::string
+#include <thread>      // std::this_thread::yield
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::exchange, std::forward
+
+#include <fcntl.h>    // O_* flags
+#include <sys/mman.h> // shm_open, shm_unlink, mmap, mremap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // ftruncate, close
+
+#include "io.h"          // sc::detail::throw_errno
+#include "mmap_vector.h" // sc::open_mode, sc::detail::page_size
+#include "vector.h"      // sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+/// The first page of a shared-memory segment; the elements follow.
+/*!
+ * Nothing in the segment is a pointer: every process maps it at its own
+ * address, so the elements are found at `data_offset` from wherever the
+ * segment landed.
+ */
+struct shm_header {
+  static constexpr char expected_magic[8] = {'S', 'C', 'S', 'H',
+                                             'M', 'V', 'E', 'C'};
+  static constexpr std::uint32_t expected_version = 1;
+
+  char magic[8];              //!< `expected_magic`.
+  std::uint32_t version;      //!< `expected_version`.
+  std::uint32_t element_size; //!< `sizeof` an element.
+  std::uint64_t data_offset;  //!< Where the elements start.
+  /// Even while the elements are stable, odd while the writer changes
+  /// them. Kept on a cache line of its own, since every read polls it.
+  alignas(64) std::atomic<std::uint64_t> generation;
+  std::atomic<std::uint64_t> size;     //!< Published number of elements.
+  std::atomic<std::uint64_t> capacity; //!< Elements the segment holds.
+};
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared counters must not hide a process-local lock");
+} // namespace detail
+
+/// A vector in a POSIX shared-memory segment, shared across processes.
+/*!
+ * One process creates the segment and writes the elements; any number of
+ * processes on the same host attach to it read-only, and use the same
+ * physical pages: a multi-GB table costs its size once per host, not
+ * once per process, and attaching is a `shm_open` and an `mmap`.
+ *
+ * The segment holds no pointers: its header records where the elements
+ * start as an offset, so it works wherever each process maps it. The
+ * elements must be trivially copyable and must not hold pointers either.
+ *
+ * Readers and the writer synchronize with a seqlock. The writer's
+ * modifiers make the generation counter odd (or `begin_update()` does,
+ * before writing through `operator[]` or `data()`), and `publish()` makes
+ * it even again, one step further. A reader takes a snapshot with
+ * `refresh()` and then reads from it; `read()` runs a function on the
+ * elements and runs it again if the writer republished meanwhile, so what
+ * it returns always comes from one published version.
+ *
+ * A reader waits for the writer to publish for at most `timeout()`, and
+ * then throws `std::runtime_error`: a writer that died mid-update never
+ * will. `try_refresh()` does not wait at all.
+ *
+ * The segment only grows, so a reader's snapshot stays mapped whatever
+ * the writer does. There must be a single writer.
+ *
+ * \tparam T The type of the elements.
+ */
+template <typename T> class shm_vector {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "shm_vector only stores trivially copyable types");
+  using header_type = detail::shm_header;
+
+  //=== Aliases
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator =
+      MyForwardIterator<const value_type>; //!< The const_iterator.
+
+  /// How long a reader waits for the writer to publish, by default.
+  static constexpr std::chrono::milliseconds default_timeout{10'000};
+
+  //=== [I] SPECIAL MEMBERS
+  shm_vector(void) noexcept = default;
+  /*! Creates or attaches to the segment called `name_`, which starts with
+   * a slash, e.g. "/lookup".
+   * \param mode_ `truncate` creates an empty segment, replacing any old
+   * one; `read_write` attaches as the writer, creating it if needed;
+   * `read_only` attaches as a reader, and the segment must exist.
+   * \param timeout_ how long a reader waits for a published version.
+   * \throw std::system_error if the segment cannot be opened or mapped.
+   * \throw std::runtime_error if it holds something else, or if a reader
+   * finds no published version within `timeout_`.
+   */
+  shm_vector(const std::string &name_, open_mode mode_,
+             std::chrono::milliseconds timeout_ = default_timeout)
+      : m_name{name_}, m_writable{mode_ != open_mode::read_only},
+        m_timeout{timeout_} {
+    if (mode_ == open_mode::truncate) {
+      // A new segment: readers of the old one keep it until they detach.
+      ::shm_unlink(name_.c_str());
+    }
+    m_fd = ::shm_open(name_.c_str(), m_writable ? O_RDWR | O_CREAT : O_RDONLY,
+                      0644);
+    if (m_fd < 0) {
+      detail::throw_errno("não foi possível abrir a memória compartilhada");
+    }
+    try {
+      attach();
+    } catch (...) {
+      unmap();
+      ::close(m_fd);
+      throw;
+    }
+  }
+  /// Detaches, as `close()` does. The segment stays; see `remove()`.
+  ~shm_vector(void) { close(); }
+  shm_vector(const shm_vector &) = delete;
+  shm_vector &operator=(const shm_vector &) = delete;
+  shm_vector(shm_vector &&other) noexcept { steal(other); }
+  shm_vector &operator=(shm_vector &&other) noexcept {
+    if (this != &other) {
+      close();
+      steal(other);
+    }
+    return *this;
+  }
+
+  /// Removes the segment called `name_`. Attached processes keep it.
+  static void remove(const std::string &name_) {
+    ::shm_unlink(name_.c_str());
+  }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator{elements()}; }
+  iterator end(void) { return iterator{elements() + m_end}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const { return const_iterator{elements()}; }
+  const_iterator cend(void) const {
+    return const_iterator{elements() + m_end};
+  }
+
+  // [III] Capacity
+  /// The writer's size, or the size in the reader's last snapshot.
+  size_type size(void) const { return m_end; }
+  size_type capacity(void) const { return m_capacity; }
+  bool empty(void) const { return m_end == 0; }
+  bool is_open(void) const { return m_fd >= 0; }
+  bool writable(void) const { return m_writable; }
+  const std::string &name(void) const { return m_name; }
+
+  // [IV] Modifiers, for the writer.
+  /// Marks the elements as changing: readers retry until `publish()`.
+  void begin_update(void) {
+    check_writable();
+    if (!m_updating) {
+      auto &generation = header()->generation;
+      generation.store(generation.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+      // The odd generation must be visible before any element changes.
+      std::atomic_thread_fence(std::memory_order_release);
+      m_updating = true;
+    }
+  }
+  /*! Publishes the elements as they are now: readers see the new size
+   * and, from their next `refresh()` or `read()`, the new elements.
+   * \return the new generation.
+   */
+  std::uint64_t publish(void) {
+    begin_update();
+    header()->size.store(m_end, std::memory_order_relaxed);
+    auto &generation = header()->generation;
+    std::uint64_t next = generation.load(std::memory_order_relaxed) + 1;
+    generation.store(next, std::memory_order_release);
+    m_updating = false;
+    m_generation = next;
+    return next;
+  }
+
+  void clear(void) {
+    begin_update();
+    m_end = 0;
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  /// Constructs a new element at the end from `args`.
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    begin_update();
+    T value(std::forward<Args>(args)...);
+    if (m_end == m_capacity) {
+      grow(m_end + 1);
+    }
+    return *::new (static_cast<void *>(elements() + m_end++)) T(value);
+  }
+  void pop_back(void) {
+    begin_update();
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    --m_end;
+  }
+  void assign(size_type count_, const_reference value_) {
+    begin_update();
+    T value(value_);
+    reserve(count_);
+    std::fill(elements(), elements() + count_, value);
+    m_end = count_;
+  }
+  /// Replaces the elements with [`first`, `last`), which must not come
+  /// from this vector.
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  void assign(InputItr first, InputItr last) {
+    begin_update();
+    reserve(size_type(std::distance(first, last)));
+    m_end = size_type(std::copy(first, last, elements()) - elements());
+  }
+  /// Grows the segment to hold at least `new_capacity` elements.
+  void reserve(size_type new_capacity) {
+    check_writable();
+    if (new_capacity > m_capacity) {
+      remap(new_capacity);
+    }
+  }
+  /// Keeps the first `count_` elements, appending value-initialized ones
+  /// if there are fewer.
+  void resize(size_type count_) { resize(count_, T{}); }
+  void resize(size_type count_, const_reference value_) {
+    begin_update();
+    T value(value_);
+    if (count_ > m_capacity) {
+      grow(count_);
+    }
+    if (count_ > m_end) {
+      std::fill(elements() + m_end, elements() + count_, value);
+    }
+    m_end = count_;
+  }
+
+  // [V] Element access
+  /// Writing through it is only allowed to the writer, between
+  /// `begin_update()` and `publish()`.
+  reference operator[](size_type idx) { return elements()[idx]; }
+  const_reference operator[](size_type idx) const { return elements()[idx]; }
+  reference at(size_type idx) {
+    if (idx >= m_end) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return elements()[idx];
+  }
+  const_reference at(size_type idx) const {
+    if (idx >= m_end) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return elements()[idx];
+  }
+  reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return elements()[0];
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return elements()[0];
+  }
+  reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return elements()[m_end - 1];
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return elements()[m_end - 1];
+  }
+  pointer data(void) { return elements(); }
+  const T *data(void) const { return elements(); }
+
+  // [VI] Readers
+  /// The generation of the last snapshot; it is always even.
+  std::uint64_t generation(void) const { return m_generation; }
+  /// How long a reader waits for the writer to publish.
+  std::chrono::milliseconds timeout(void) const { return m_timeout; }
+  void set_timeout(std::chrono::milliseconds timeout_) { m_timeout = timeout_; }
+  /// Whether the writer published since the last snapshot.
+  bool stale(void) const {
+    return m_base != nullptr &&
+           header()->generation.load(std::memory_order_acquire) !=
+               m_generation;
+  }
+  /*! Takes a new snapshot: waits for a published version and maps the
+   * segment again if it grew. The elements may still change afterwards;
+   * `read()` checks they did not.
+   * \return whether the writer published since the last snapshot.
+   * \throw std::runtime_error if the writer does not publish within
+   * `timeout()`.
+   */
+  bool refresh(void) {
+    std::uint64_t before = m_generation;
+    snapshot();
+    return m_generation != before;
+  }
+  /*! Takes a new snapshot if a published version is there now, without
+   * waiting for the writer; otherwise keeps the last one.
+   * \return whether a snapshot was taken.
+   */
+  bool try_refresh(void) { return try_snapshot(std::chrono::milliseconds{0}); }
+  /*! Runs `fn_(*this)` on one published version of the elements and
+   * returns what it returns. If the writer changed them meanwhile it
+   * runs again, so `fn_` must only read, and must cope with elements
+   * that are being overwritten under it (its result is then dropped).
+   * \throw std::runtime_error if the writer does not publish within
+   * `timeout()`.
+   */
+  template <typename Fn> decltype(auto) read(Fn &&fn_) {
+    for (;;) {
+      snapshot();
+      if constexpr (std::is_void<decltype(fn_(std::as_const(*this)))>::value) {
+        fn_(std::as_const(*this));
+        if (confirm()) {
+          return;
+        }
+      } else {
+        auto result = fn_(std::as_const(*this));
+        if (confirm()) {
+          return result;
+        }
+      }
+    }
+  }
+
+  /// Detaches from the segment, which stays for other processes. A
+  /// writer publishes what it changed first.
+  void close(void) {
+    if (m_fd < 0) {
+      return;
+    }
+    if (m_updating) {
+      publish();
+    }
+    unmap();
+    ::close(std::exchange(m_fd, -1));
+    m_end = m_capacity = 0;
+    m_updating = false;
+  }
+
+private:
+  header_type *header(void) const {
+    return reinterpret_cast<header_type *>(m_base);
+  }
+  pointer elements(void) const {
+    return m_base == nullptr
+               ? nullptr
+               : reinterpret_cast<pointer>(m_base + header()->data_offset);
+  }
+  void check_writable(void) const {
+    if (!m_writable) {
+      throw std::logic_error("shm_vector aberto só para leitura!");
+    }
+  }
+
+  /// Maps the segment, initializing an empty one if we are the writer.
+  void attach(void) {
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0) {
+      detail::throw_errno("não foi possível ler o tamanho do segmento");
+    }
+    std::size_t data_offset = detail::page_size();
+    if (info.st_size == 0) {
+      if (!m_writable) {
+        throw std::runtime_error("O segmento ainda não foi criado!");
+      }
+      if (::ftruncate(m_fd, off_t(data_offset)) != 0) {
+        detail::throw_errno("não foi possível criar o segmento");
+      }
+      map(data_offset);
+      auto *head = ::new (static_cast<void *>(m_base)) header_type{};
+      std::memcpy(head->magic, header_type::expected_magic, sizeof(head->magic));
+      head->version = header_type::expected_version;
+      head->element_size = sizeof(T);
+      head->data_offset = data_offset;
+      return;
+    }
+    if (std::size_t(info.st_size) < sizeof(header_type)) {
+      throw std::runtime_error("O segmento não guarda um shm_vector!");
+    }
+    map(std::size_t(info.st_size));
+    const header_type *head = header();
+    if (std::memcmp(head->magic, header_type::expected_magic,
+                    sizeof(head->magic)) != 0 ||
+        head->version != header_type::expected_version) {
+      throw std::runtime_error("O segmento não guarda um shm_vector!");
+    }
+    if (head->element_size != sizeof(T) ||
+        head->data_offset % alignof(T) != 0) {
+      throw std::runtime_error("Os elementos do segmento são de outro tipo!");
+    }
+    if (m_writable) {
+      m_capacity = size_type(head->capacity.load(std::memory_order_relaxed));
+      m_end = size_type(head->size.load(std::memory_order_relaxed));
+      m_generation = head->generation.load(std::memory_order_relaxed);
+      if (m_generation % 2 != 0) {
+        // A writer died mid-update; what it left is ours to publish.
+        m_updating = true;
+      }
+    } else {
+      snapshot();
+    }
+  }
+  /// Maps the first `bytes_` bytes of the segment.
+  void map(std::size_t bytes_) {
+    int prot = m_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *addr = ::mmap(nullptr, bytes_, prot, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED) {
+      detail::throw_errno("não foi possível mapear o segmento");
+    }
+    m_base = static_cast<unsigned char *>(addr);
+    m_mapped = bytes_;
+  }
+  void unmap(void) {
+    if (m_base != nullptr) {
+      ::munmap(m_base, m_mapped);
+      m_base = nullptr;
+      m_mapped = 0;
+    }
+  }
+  /// Maps `bytes_` of the segment instead of what is mapped now.
+  void remap_to(std::size_t bytes_) {
+#if defined(__linux__)
+    void *addr = ::mremap(m_base, m_mapped, bytes_, MREMAP_MAYMOVE);
+    if (addr == MAP_FAILED) {
+      detail::throw_errno("não foi possível remapear o segmento");
+    }
+    m_base = static_cast<unsigned char *>(addr);
+    m_mapped = bytes_;
+#else
+    unmap();
+    map(bytes_);
+#endif
+  }
+
+  /// Grows to at least `min_capacity_`, doubling, in whole pages.
+  void grow(size_type min_capacity_) {
+    size_type wanted = std::max(min_capacity_, 2 * m_capacity);
+    size_type page = detail::page_size();
+    size_type bytes = (wanted * sizeof(T) + page - 1) / page * page;
+    remap(bytes / sizeof(T));
+  }
+  /// Grows the segment to `new_capacity` elements. Readers see the new
+  /// capacity only once the segment is long enough for it.
+  void remap(size_type new_capacity) {
+    std::size_t bytes = header()->data_offset + new_capacity * sizeof(T);
+    if (::ftruncate(m_fd, off_t(bytes)) != 0) {
+      detail::throw_errno("não foi possível aumentar o segmento");
+    }
+    remap_to(bytes);
+    m_capacity = new_capacity;
+    header()->capacity.store(new_capacity, std::memory_order_release);
+  }
+
+  /// Waits for a published version as `try_snapshot()` does, for at most
+  /// `m_timeout`, and throws if there is none.
+  void snapshot(void) {
+    if (!try_snapshot(m_timeout)) {
+      throw std::runtime_error("O escritor não publicou a tempo!");
+    }
+  }
+  /// Waits up to `timeout_` for a published version and records its size
+  /// and generation, mapping the segment again if it grew past our
+  /// mapping. Returns false, keeping the old snapshot, if none came.
+  bool try_snapshot(std::chrono::milliseconds timeout_) {
+    if (m_writable || m_base == nullptr) {
+      return true;
+    }
+    const header_type *head = header();
+    // Only read the clock once the writer makes us wait.
+    std::chrono::steady_clock::time_point deadline{};
+    bool waiting{false};
+    for (;;) {
+      std::uint64_t generation = head->generation.load(std::memory_order_acquire);
+      if (generation % 2 != 0) {
+        auto now = std::chrono::steady_clock::now();
+        if (!waiting) {
+          deadline = now + timeout_;
+          waiting = true;
+        } else if (now >= deadline) {
+          return false;
+        }
+        std::this_thread::yield();
+        continue;
+      }
+      std::uint64_t capacity = head->capacity.load(std::memory_order_acquire);
+      std::uint64_t size = head->size.load(std::memory_order_relaxed);
+      std::size_t needed = head->data_offset + capacity * sizeof(T);
+      if (needed > m_mapped) {
+        remap_to(needed);
+        head = header();
+      }
+      // As in confirm(): the size and capacity reads must not move past
+      // the generation check.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (head->generation.load(std::memory_order_relaxed) == generation) {
+        m_generation = generation;
+        m_capacity = size_type(capacity);
+        m_end = size_type(size);
+        return true;
+      }
+    }
+  }
+  /// Whether the snapshot is still the published version.
+  bool confirm(void) const {
+    if (m_writable) {
+      return true;
+    }
+    // The element reads must not move past the generation check.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header()->generation.load(std::memory_order_relaxed) ==
+           m_generation;
+  }
+
+  /// Takes over the attachment of `other`, leaving it detached.
+  void steal(shm_vector &other) noexcept {
+    m_name = std::move(other.m_name);
+    m_fd = std::exchange(other.m_fd, -1);
+    m_writable = other.m_writable;
+    m_updating = std::exchange(other.m_updating, false);
+    m_base = std::exchange(other.m_base, nullptr);
+    m_mapped = std::exchange(other.m_mapped, 0);
+    m_end = std::exchange(other.m_end, 0);
+    m_capacity = std::exchange(other.m_capacity, 0);
+    m_generation = std::exchange(other.m_generation, 0);
+    m_timeout = other.m_timeout;
+  }
+
+  std::string m_name;              //!< Name of the segment.
+  int m_fd{-1};                    //!< The segment, or -1 if detached.
+  bool m_writable{false};          //!< Whether we are the writer.
+  bool m_updating{false};          //!< Whether the generation is odd.
+  unsigned char *m_base{nullptr};  //!< Start of our mapping.
+  std::size_t m_mapped{0};         //!< How many bytes are mapped.
+  size_type m_end{0};              //!< Writer's size, or snapshot's.
+  size_type m_capacity{0};         //!< Elements the segment holds.
+  std::uint64_t m_generation{0};   //!< Generation of the snapshot.
+  std::chrono::milliseconds m_timeout{default_timeout}; //!< Reader's wait.
+};
+} // namespace sc.
+
+#endif
@@ -0,0 +1,263 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "shm_vector.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Twentieth batch of tests, focused on sc::shm_vector
+// =============================================================
+
+// Readers see what the writer published, and only that.
+#define PUBLISH YES
+// Readers follow the segment when it grows.
+#define GROWTH YES
+// A reader in another process never sees a half-written version.
+#define ACROSS_PROCESSES YES
+// Missing segments, other element types and read-only misuse.
+#define ERRORS YES
+// Readers give up on a writer that died mid-update.
+#define DEAD_WRITER YES
+
+namespace {
+/// A segment name, unique to this process.
+std::string segment_name(const std::string &name_) {
+  return "/sc_shm_vector_" + std::to_string(::getpid()) + "_" + name_;
+}
+
+template <typename T> std::uint64_t sum(const sc::shm_vector<T> &vec_) {
+  return std::accumulate(vec_.begin(), vec_.end(), std::uint64_t{0});
+}
+} // namespace
+
+void run_shm_vector_tests(void) {
+  TestManager tm{"shm_vector testing"};
+
+#if PUBLISH
+  {
+    BEGIN_TEST(tm, "Publish", "readers see published versions");
+
+    std::string name = segment_name("publish");
+    sc::shm_vector<std::uint32_t> writer{name, sc::open_mode::truncate};
+    for (std::uint32_t i{1}; i <= 100; ++i) {
+      writer.push_back(i);
+    }
+    std::uint64_t first = writer.publish();
+    EXPECT_EQ(first % 2, 0u);
+
+    sc::shm_vector<std::uint32_t> reader{name, sc::open_mode::read_only};
+    EXPECT_EQ(reader.size(), 100ul);
+    EXPECT_EQ(reader.generation(), first);
+    EXPECT_EQ(sum(reader), 5050u);
+    EXPECT_FALSE(reader.stale());
+
+    // Unpublished pushes are not part of the reader's snapshot.
+    writer.push_back(1000);
+    writer[0] = 0;
+    EXPECT_EQ(reader.size(), 100ul);
+    writer.publish();
+    EXPECT_TRUE(reader.stale());
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_FALSE(reader.refresh());
+    EXPECT_EQ(reader.size(), 101ul);
+    EXPECT_EQ(reader.front(), 0u);
+    std::uint64_t total = reader.read(
+        [](const sc::shm_vector<std::uint32_t> &vec_) { return sum(vec_); });
+    EXPECT_EQ(total, 5050u - 1 + 1000);
+
+    // A writer that goes away publishes what it left.
+    writer.clear();
+    writer.close();
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_TRUE(reader.empty());
+    sc::shm_vector<std::uint32_t>::remove(name);
+  }
+#endif
+
+#if GROWTH
+  {
+    BEGIN_TEST(tm, "Growth", "readers remap a grown segment");
+
+    std::string name = segment_name("growth");
+    sc::shm_vector<std::uint64_t> writer{name, sc::open_mode::truncate};
+    writer.push_back(7);
+    writer.publish();
+    sc::shm_vector<std::uint64_t> reader{name, sc::open_mode::read_only};
+    EXPECT_EQ(reader.size(), 1ul);
+
+    for (std::uint64_t i{0}; i < 200'000; ++i) {
+      writer.push_back(i);
+    }
+    writer.publish();
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_EQ(reader.size(), 200'001ul);
+    EXPECT_TRUE(reader.capacity() >= reader.size());
+    EXPECT_EQ(reader.back(), 199'999u);
+    EXPECT_EQ(sum(reader), 7 + std::uint64_t(199'999) * 200'000 / 2);
+
+    // The writer attaches again, and goes on from there.
+    writer.close();
+    sc::shm_vector<std::uint64_t> again{name, sc::open_mode::read_write};
+    EXPECT_EQ(again.size(), 200'001ul);
+    again.resize(10);
+    again.publish();
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_EQ(reader.size(), 10ul);
+    sc::shm_vector<std::uint64_t>::remove(name);
+  }
+#endif
+
+#if ACROSS_PROCESSES
+  {
+    BEGIN_TEST(tm, "AcrossProcesses", "reads are never torn");
+
+    std::string name = segment_name("processes");
+    sc::shm_vector<std::uint64_t> writer{name, sc::open_mode::truncate};
+    writer.assign(1 << 14, 0);
+    writer.publish();
+
+    pid_t pid = ::fork();
+    EXPECT_TRUE(pid != -1);
+    if (pid == 0) {
+      // Every published version holds one value everywhere.
+      sc::shm_vector<std::uint64_t> reader{name, sc::open_mode::read_only};
+      bool uniform{true};
+      for (int round{0}; round < 500 && uniform; ++round) {
+        uniform = reader.read([](const sc::shm_vector<std::uint64_t> &vec_) {
+          std::uint64_t first = vec_[0];
+          for (auto value : vec_) {
+            if (value != first) {
+              return false;
+            }
+          }
+          return true;
+        });
+      }
+      ::_exit(uniform ? 0 : 1);
+    }
+    int status{-1};
+    for (std::uint64_t version{1};
+         pid != -1 && ::waitpid(pid, &status, WNOHANG) == 0; ++version) {
+      writer.begin_update();
+      for (auto &value : writer) {
+        value = version;
+      }
+      writer.publish();
+      // Lets the reader run on a single core, too.
+      std::this_thread::yield();
+    }
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    sc::shm_vector<std::uint64_t>::remove(name);
+  }
+#endif
+
+#if ERRORS
+  {
+    BEGIN_TEST(tm, "Errors", "misuse is reported");
+
+    std::string name = segment_name("errors");
+    bool thrown{false};
+    try {
+      sc::shm_vector<int> reader{name, sc::open_mode::read_only};
+    } catch (const std::system_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    sc::shm_vector<std::int32_t> writer{name, sc::open_mode::truncate};
+    writer.push_back(1);
+    writer.publish();
+    thrown = false;
+    try {
+      sc::shm_vector<std::int64_t> reader{name, sc::open_mode::read_only};
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    sc::shm_vector<std::int32_t> reader{name, sc::open_mode::read_only};
+    thrown = false;
+    try {
+      reader.push_back(2);
+    } catch (const std::logic_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    sc::shm_vector<std::int32_t> moved{std::move(reader)};
+    EXPECT_FALSE(reader.is_open());
+    EXPECT_EQ(moved.at(0), 1);
+    sc::shm_vector<std::int32_t>::remove(name);
+  }
+#endif
+
+#if DEAD_WRITER
+  {
+    BEGIN_TEST(tm, "DeadWriter", "readers time out on a dead writer");
+
+    using namespace std::chrono_literals;
+    std::string name = segment_name("dead");
+    {
+      sc::shm_vector<std::int32_t> writer{name, sc::open_mode::truncate};
+      writer.push_back(1);
+      writer.publish();
+    }
+    sc::shm_vector<std::int32_t> reader{name, sc::open_mode::read_only, 50ms};
+    EXPECT_EQ(reader.timeout(), 50ms);
+
+    pid_t pid = ::fork();
+    EXPECT_TRUE(pid != -1);
+    if (pid == 0) {
+      sc::shm_vector<std::int32_t> writer{name, sc::open_mode::read_write};
+      writer.push_back(2);
+      // Dies mid-update: the generation stays odd.
+      ::_exit(0);
+    }
+    int status{-1};
+    EXPECT_EQ(::waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // The old snapshot is kept, and nothing waits forever.
+    EXPECT_FALSE(reader.try_refresh());
+    EXPECT_EQ(reader.size(), 1ul);
+    bool thrown{false};
+    try {
+      reader.refresh();
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    thrown = false;
+    try {
+      sc::shm_vector<std::int32_t> late{name, sc::open_mode::read_only, 10ms};
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    // The next writer starts from the last published size and publishes.
+    sc::shm_vector<std::int32_t> writer{name, sc::open_mode::read_write};
+    writer.push_back(3);
+    writer.publish();
+    EXPECT_TRUE(reader.try_refresh());
+    EXPECT_EQ(reader.size(), 2ul);
+    EXPECT_EQ(reader.back(), 3);
+    sc::shm_vector<std::int32_t>::remove(name);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
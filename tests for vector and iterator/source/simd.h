@@ -0,0 +1,745 @@
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+#include <algorithm>   // std::min
+#include <atomic>      // std::atomic
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::int32_t, std::int64_t
+#include <stdexcept>   // std::length_error
+#include <type_traits> // std::is_arithmetic, std::conditional_t
+#include <utility>     // std::pair
+
+#include "vector.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define SC_SIMD_X86 1
+#include <immintrin.h>
+/// Compiles one function for an instruction set the build does not assume.
+#define SC_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SC_SIMD_X86 0
+#endif
+
+/// Sequence container namespace.
+namespace sc {
+/// Vectorized scans over vectors of arithmetic types.
+/*!
+ * The kernels read `data()` directly, so they skip the iterator and its
+ * checks. For `std::int32_t` and `float` they come in SSE2, AVX2 and
+ * AVX-512 versions, and the best one the CPU supports is picked at run
+ * time; every other arithmetic type, and every non-x86 build, uses the
+ * scalar versions.
+ *
+ * Results are the ones of the matching std algorithm, except that sum()
+ * adds floats in a different order. NaNs are handled as std does: one in
+ * first position is the minimum and the maximum, the others are skipped.
+ */
+namespace simd {
+/// Instruction sets, from the least capable up.
+enum class level { scalar, sse2, avx2, avx512 };
+
+/// The type sum() returns for `T`: 64-bit integers, or at least a double.
+template <typename T>
+using sum_t = std::conditional_t<
+    std::is_floating_point<T>::value,
+    std::conditional_t<(sizeof(T) > sizeof(double)), T, double>,
+    std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>>;
+
+/// The best level this CPU supports.
+inline level detected_level(void) {
+#if SC_SIMD_X86
+  static const level best = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return level::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return level::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+      return level::sse2;
+    }
+    return level::scalar;
+  }();
+  return best;
+#else
+  return level::scalar;
+#endif
+}
+
+namespace detail {
+inline std::atomic<level> &selected(void) {
+  static std::atomic<level> current{detected_level()};
+  return current;
+}
+} // namespace detail
+
+/// The level the kernels currently use.
+inline level active_level(void) {
+  return detail::selected().load(std::memory_order_relaxed);
+}
+/// Makes the kernels use `level_`, or the best supported level below it,
+/// and returns the level actually set. Meant for tests and benchmarks.
+inline level set_level(level level_) {
+  level best = detected_level();
+  level chosen = (level_ > best) ? best : level_;
+  detail::selected().store(chosen, std::memory_order_relaxed);
+  return chosen;
+}
+
+namespace detail {
+//=== Scalar kernels, for every arithmetic type.
+template <typename T> const T *find_scalar(const T *first_, const T *last_, T value_) {
+  for (; first_ != last_; ++first_) {
+    if (*first_ == value_) {
+      return first_;
+    }
+  }
+  return last_;
+}
+template <typename T>
+std::size_t count_scalar(const T *first_, const T *last_, T value_) {
+  std::size_t total{0};
+  for (; first_ != last_; ++first_) {
+    total += (*first_ == value_);
+  }
+  return total;
+}
+/// Smallest and largest of the non-empty range, folded into `bounds_`.
+template <typename T>
+std::pair<T, T> minmax_scalar(const T *first_, const T *last_,
+                              std::pair<T, T> bounds_) {
+  for (; first_ != last_; ++first_) {
+    if (*first_ < bounds_.first) {
+      bounds_.first = *first_;
+    }
+    if (bounds_.second < *first_) {
+      bounds_.second = *first_;
+    }
+  }
+  return bounds_;
+}
+template <typename T> sum_t<T> sum_scalar(const T *first_, const T *last_) {
+  sum_t<T> total{0};
+  for (; first_ != last_; ++first_) {
+    total += *first_;
+  }
+  return total;
+}
+
+#if SC_SIMD_X86
+/// Blocks per count() round; keeps 32-bit lane counters from wrapping.
+constexpr std::ptrdiff_t count_round{1 << 16};
+
+//=== SSE2
+SC_SIMD_TARGET("sse2") inline std::int64_t hsum_epi32(__m128i acc_) {
+  alignas(16) std::int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc_);
+  return std::int64_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+}
+SC_SIMD_TARGET("sse2") inline __m128i min_epi32_sse2(__m128i a_, __m128i b_) {
+  __m128i greater = _mm_cmpgt_epi32(a_, b_);
+  return _mm_or_si128(_mm_and_si128(greater, b_), _mm_andnot_si128(greater, a_));
+}
+SC_SIMD_TARGET("sse2") inline __m128i max_epi32_sse2(__m128i a_, __m128i b_) {
+  __m128i greater = _mm_cmpgt_epi32(a_, b_);
+  return _mm_or_si128(_mm_and_si128(greater, a_), _mm_andnot_si128(greater, b_));
+}
+
+SC_SIMD_TARGET("sse2")
+inline const std::int32_t *find_sse2(const std::int32_t *first_,
+                                     const std::int32_t *last_,
+                                     std::int32_t value_) {
+  const __m128i needle = _mm_set1_epi32(value_);
+  for (; last_ - first_ >= 4; first_ += 4) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first_));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+    if (mask != 0) {
+      return first_ + __builtin_ctz(unsigned(mask));
+    }
+  }
+  return find_scalar(first_, last_, value_);
+}
+SC_SIMD_TARGET("sse2")
+inline const float *find_sse2(const float *first_, const float *last_,
+                              float value_) {
+  const __m128 needle = _mm_set1_ps(value_);
+  for (; last_ - first_ >= 4; first_ += 4) {
+    int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(first_), needle));
+    if (mask != 0) {
+      return first_ + __builtin_ctz(unsigned(mask));
+    }
+  }
+  return find_scalar(first_, last_, value_);
+}
+SC_SIMD_TARGET("sse2")
+inline std::size_t count_sse2(const std::int32_t *first_,
+                              const std::int32_t *last_, std::int32_t value_) {
+  const __m128i needle = _mm_set1_epi32(value_);
+  std::size_t total{0};
+  while (last_ - first_ >= 4) {
+    const std::int32_t *stop =
+        first_ + 4 * std::min<std::ptrdiff_t>((last_ - first_) / 4, count_round);
+    __m128i acc = _mm_setzero_si128();
+    for (; first_ != stop; first_ += 4) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first_));
+      acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(block, needle));
+    }
+    total += std::size_t(hsum_epi32(acc));
+  }
+  return total + count_scalar(first_, last_, value_);
+}
+SC_SIMD_TARGET("sse2")
+inline std::size_t count_sse2(const float *first_, const float *last_,
+                              float value_) {
+  const __m128 needle = _mm_set1_ps(value_);
+  std::size_t total{0};
+  while (last_ - first_ >= 4) {
+    const float *stop =
+        first_ + 4 * std::min<std::ptrdiff_t>((last_ - first_) / 4, count_round);
+    __m128i acc = _mm_setzero_si128();
+    for (; first_ != stop; first_ += 4) {
+      __m128 equal = _mm_cmpeq_ps(_mm_loadu_ps(first_), needle);
+      acc = _mm_sub_epi32(acc, _mm_castps_si128(equal));
+    }
+    total += std::size_t(hsum_epi32(acc));
+  }
+  return total + count_scalar(first_, last_, value_);
+}
+SC_SIMD_TARGET("sse2")
+inline std::pair<std::int32_t, std::int32_t>
+minmax_sse2(const std::int32_t *first_, const std::int32_t *last_) {
+  std::pair<std::int32_t, std::int32_t> bounds{*first_, *first_};
+  if (last_ - first_ >= 4) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first_));
+    __m128i high = low;
+    for (first_ += 4; last_ - first_ >= 4; first_ += 4) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first_));
+      low = min_epi32_sse2(low, block);
+      high = max_epi32_sse2(high, block);
+    }
+    alignas(16) std::int32_t lows[4], highs[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lows), low);
+    _mm_store_si128(reinterpret_cast<__m128i *>(highs), high);
+    bounds = minmax_scalar(lows, lows + 4, bounds);
+    bounds = minmax_scalar(highs, highs + 4, bounds);
+  }
+  return minmax_scalar(first_, last_, bounds);
+}
+SC_SIMD_TARGET("sse2")
+inline std::pair<float, float> minmax_sse2(const float *first_,
+                                           const float *last_) {
+  std::pair<float, float> bounds{*first_, *first_};
+  if (last_ - first_ >= 4) {
+    // The lanes start from the first element, like the scalar fold. On a
+    // NaN, min/max return their second operand, so a NaN in `block` leaves
+    // the lane alone and NaNs are skipped the way std::min_element skips
+    // them; a NaN first element is kept, as std::min_element keeps it.
+    __m128 low = _mm_set1_ps(*first_);
+    __m128 high = low;
+    for (; last_ - first_ >= 4; first_ += 4) {
+      __m128 block = _mm_loadu_ps(first_);
+      low = _mm_min_ps(block, low);
+      high = _mm_max_ps(block, high);
+    }
+    alignas(16) float lows[4], highs[4];
+    _mm_store_ps(lows, low);
+    _mm_store_ps(highs, high);
+    bounds = minmax_scalar(lows, lows + 4, bounds);
+    bounds = minmax_scalar(highs, highs + 4, bounds);
+  }
+  return minmax_scalar(first_, last_, bounds);
+}
+SC_SIMD_TARGET("sse2")
+inline std::int64_t sum_sse2(const std::int32_t *first_,
+                             const std::int32_t *last_) {
+  __m128i acc = _mm_setzero_si128();
+  for (; last_ - first_ >= 4; first_ += 4) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first_));
+    // Widens to 64 bits by pairing each lane with its sign.
+    __m128i sign = _mm_srai_epi32(block, 31);
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(block, sign));
+    acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(block, sign));
+  }
+  alignas(16) std::int64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  return lanes[0] + lanes[1] + sum_scalar(first_, last_);
+}
+SC_SIMD_TARGET("sse2")
+inline double sum_sse2(const float *first_, const float *last_) {
+  __m128d acc = _mm_setzero_pd();
+  for (; last_ - first_ >= 4; first_ += 4) {
+    __m128 block = _mm_loadu_ps(first_);
+    acc = _mm_add_pd(acc, _mm_cvtps_pd(block));
+    acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(block, block)));
+  }
+  alignas(16) double lanes[2];
+  _mm_store_pd(lanes, acc);
+  return lanes[0] + lanes[1] + sum_scalar(first_, last_);
+}
+
+//=== AVX2
+SC_SIMD_TARGET("avx2") inline std::int64_t hsum_epi32(__m256i acc_) {
+  alignas(32) std::int32_t lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc_);
+  std::int64_t total{0};
+  for (std::int32_t lane : lanes) {
+    total += lane;
+  }
+  return total;
+}
+
+SC_SIMD_TARGET("avx2")
+inline const std::int32_t *find_avx2(const std::int32_t *first_,
+                                     const std::int32_t *last_,
+                                     std::int32_t value_) {
+  const __m256i needle = _mm256_set1_epi32(value_);
+  for (; last_ - first_ >= 8; first_ += 8) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first_));
+    int mask = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+    if (mask != 0) {
+      return first_ + __builtin_ctz(unsigned(mask));
+    }
+  }
+  return find_sse2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx2")
+inline const float *find_avx2(const float *first_, const float *last_,
+                              float value_) {
+  const __m256 needle = _mm256_set1_ps(value_);
+  for (; last_ - first_ >= 8; first_ += 8) {
+    int mask = _mm256_movemask_ps(
+        _mm256_cmp_ps(_mm256_loadu_ps(first_), needle, _CMP_EQ_OQ));
+    if (mask != 0) {
+      return first_ + __builtin_ctz(unsigned(mask));
+    }
+  }
+  return find_sse2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx2")
+inline std::size_t count_avx2(const std::int32_t *first_,
+                              const std::int32_t *last_, std::int32_t value_) {
+  const __m256i needle = _mm256_set1_epi32(value_);
+  std::size_t total{0};
+  while (last_ - first_ >= 8) {
+    const std::int32_t *stop =
+        first_ + 8 * std::min<std::ptrdiff_t>((last_ - first_) / 8, count_round);
+    __m256i acc = _mm256_setzero_si256();
+    for (; first_ != stop; first_ += 8) {
+      __m256i block =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first_));
+      acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(block, needle));
+    }
+    total += std::size_t(hsum_epi32(acc));
+  }
+  return total + count_sse2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx2")
+inline std::size_t count_avx2(const float *first_, const float *last_,
+                              float value_) {
+  const __m256 needle = _mm256_set1_ps(value_);
+  std::size_t total{0};
+  while (last_ - first_ >= 8) {
+    const float *stop =
+        first_ + 8 * std::min<std::ptrdiff_t>((last_ - first_) / 8, count_round);
+    __m256i acc = _mm256_setzero_si256();
+    for (; first_ != stop; first_ += 8) {
+      __m256 equal = _mm256_cmp_ps(_mm256_loadu_ps(first_), needle, _CMP_EQ_OQ);
+      acc = _mm256_sub_epi32(acc, _mm256_castps_si256(equal));
+    }
+    total += std::size_t(hsum_epi32(acc));
+  }
+  return total + count_sse2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx2")
+inline std::pair<std::int32_t, std::int32_t>
+minmax_avx2(const std::int32_t *first_, const std::int32_t *last_) {
+  std::pair<std::int32_t, std::int32_t> bounds{*first_, *first_};
+  if (last_ - first_ >= 8) {
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first_));
+    __m256i high = low;
+    for (first_ += 8; last_ - first_ >= 8; first_ += 8) {
+      __m256i block =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first_));
+      low = _mm256_min_epi32(low, block);
+      high = _mm256_max_epi32(high, block);
+    }
+    alignas(32) std::int32_t lows[8], highs[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lows), low);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(highs), high);
+    bounds = minmax_scalar(lows, lows + 8, bounds);
+    bounds = minmax_scalar(highs, highs + 8, bounds);
+  }
+  return minmax_scalar(first_, last_, bounds);
+}
+SC_SIMD_TARGET("avx2")
+inline std::pair<float, float> minmax_avx2(const float *first_,
+                                           const float *last_) {
+  std::pair<float, float> bounds{*first_, *first_};
+  if (last_ - first_ >= 8) {
+    // Same NaN handling as minmax_sse2().
+    __m256 low = _mm256_set1_ps(*first_);
+    __m256 high = low;
+    for (; last_ - first_ >= 8; first_ += 8) {
+      __m256 block = _mm256_loadu_ps(first_);
+      low = _mm256_min_ps(block, low);
+      high = _mm256_max_ps(block, high);
+    }
+    alignas(32) float lows[8], highs[8];
+    _mm256_store_ps(lows, low);
+    _mm256_store_ps(highs, high);
+    bounds = minmax_scalar(lows, lows + 8, bounds);
+    bounds = minmax_scalar(highs, highs + 8, bounds);
+  }
+  return minmax_scalar(first_, last_, bounds);
+}
+SC_SIMD_TARGET("avx2")
+inline std::int64_t sum_avx2(const std::int32_t *first_,
+                             const std::int32_t *last_) {
+  __m256i acc = _mm256_setzero_si256();
+  for (; last_ - first_ >= 8; first_ += 8) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first_));
+    acc = _mm256_add_epi64(
+        acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+    acc = _mm256_add_epi64(
+        acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+  }
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(first_, last_);
+}
+SC_SIMD_TARGET("avx2")
+inline double sum_avx2(const float *first_, const float *last_) {
+  __m256d acc = _mm256_setzero_pd();
+  for (; last_ - first_ >= 8; first_ += 8) {
+    acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(first_)));
+    acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(first_ + 4)));
+  }
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(first_, last_);
+}
+
+//=== AVX-512
+// GCC's unmasked AVX-512 intrinsics pass an `_mm512_undefined_*()` merge
+// source, which -Wmaybe-uninitialized takes for an uninitialized read.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+SC_SIMD_TARGET("avx512f") inline std::int64_t hsum_epi32(__m512i acc_) {
+  alignas(64) std::int32_t lanes[16];
+  _mm512_store_si512(lanes, acc_);
+  std::int64_t total{0};
+  for (std::int32_t lane : lanes) {
+    total += lane;
+  }
+  return total;
+}
+
+SC_SIMD_TARGET("avx512f")
+inline const std::int32_t *find_avx512(const std::int32_t *first_,
+                                       const std::int32_t *last_,
+                                       std::int32_t value_) {
+  const __m512i needle = _mm512_set1_epi32(value_);
+  for (; last_ - first_ >= 16; first_ += 16) {
+    __mmask16 mask =
+        _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(first_), needle);
+    if (mask != 0) {
+      return first_ + __builtin_ctz(unsigned(mask));
+    }
+  }
+  return find_avx2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx512f")
+inline const float *find_avx512(const float *first_, const float *last_,
+                                float value_) {
+  const __m512 needle = _mm512_set1_ps(value_);
+  for (; last_ - first_ >= 16; first_ += 16) {
+    __mmask16 mask =
+        _mm512_cmp_ps_mask(_mm512_loadu_ps(first_), needle, _CMP_EQ_OQ);
+    if (mask != 0) {
+      return first_ + __builtin_ctz(unsigned(mask));
+    }
+  }
+  return find_avx2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx512f")
+inline std::size_t count_avx512(const std::int32_t *first_,
+                                const std::int32_t *last_,
+                                std::int32_t value_) {
+  const __m512i needle = _mm512_set1_epi32(value_);
+  const __m512i one = _mm512_set1_epi32(1);
+  std::size_t total{0};
+  while (last_ - first_ >= 16) {
+    const std::int32_t *stop =
+        first_ + 16 * std::min<std::ptrdiff_t>((last_ - first_) / 16, count_round);
+    __m512i acc = _mm512_setzero_si512();
+    for (; first_ != stop; first_ += 16) {
+      __mmask16 equal =
+          _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(first_), needle);
+      acc = _mm512_mask_add_epi32(acc, equal, acc, one);
+    }
+    total += std::size_t(hsum_epi32(acc));
+  }
+  return total + count_avx2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx512f")
+inline std::size_t count_avx512(const float *first_, const float *last_,
+                                float value_) {
+  const __m512 needle = _mm512_set1_ps(value_);
+  const __m512i one = _mm512_set1_epi32(1);
+  std::size_t total{0};
+  while (last_ - first_ >= 16) {
+    const float *stop =
+        first_ + 16 * std::min<std::ptrdiff_t>((last_ - first_) / 16, count_round);
+    __m512i acc = _mm512_setzero_si512();
+    for (; first_ != stop; first_ += 16) {
+      __mmask16 equal =
+          _mm512_cmp_ps_mask(_mm512_loadu_ps(first_), needle, _CMP_EQ_OQ);
+      acc = _mm512_mask_add_epi32(acc, equal, acc, one);
+    }
+    total += std::size_t(hsum_epi32(acc));
+  }
+  return total + count_avx2(first_, last_, value_);
+}
+SC_SIMD_TARGET("avx512f")
+inline std::pair<std::int32_t, std::int32_t>
+minmax_avx512(const std::int32_t *first_, const std::int32_t *last_) {
+  std::pair<std::int32_t, std::int32_t> bounds{*first_, *first_};
+  if (last_ - first_ >= 16) {
+    __m512i low = _mm512_loadu_si512(first_);
+    __m512i high = low;
+    for (first_ += 16; last_ - first_ >= 16; first_ += 16) {
+      __m512i block = _mm512_loadu_si512(first_);
+      low = _mm512_min_epi32(low, block);
+      high = _mm512_max_epi32(high, block);
+    }
+    alignas(64) std::int32_t lows[16], highs[16];
+    _mm512_store_si512(lows, low);
+    _mm512_store_si512(highs, high);
+    bounds = minmax_scalar(lows, lows + 16, bounds);
+    bounds = minmax_scalar(highs, highs + 16, bounds);
+  }
+  return minmax_scalar(first_, last_, bounds);
+}
+SC_SIMD_TARGET("avx512f")
+inline std::pair<float, float> minmax_avx512(const float *first_,
+                                             const float *last_) {
+  std::pair<float, float> bounds{*first_, *first_};
+  if (last_ - first_ >= 16) {
+    // Same NaN handling as minmax_sse2().
+    __m512 low = _mm512_set1_ps(*first_);
+    __m512 high = low;
+    for (; last_ - first_ >= 16; first_ += 16) {
+      __m512 block = _mm512_loadu_ps(first_);
+      low = _mm512_min_ps(block, low);
+      high = _mm512_max_ps(block, high);
+    }
+    alignas(64) float lows[16], highs[16];
+    _mm512_store_ps(lows, low);
+    _mm512_store_ps(highs, high);
+    bounds = minmax_scalar(lows, lows + 16, bounds);
+    bounds = minmax_scalar(highs, highs + 16, bounds);
+  }
+  return minmax_scalar(first_, last_, bounds);
+}
+SC_SIMD_TARGET("avx512f")
+inline std::int64_t sum_avx512(const std::int32_t *first_,
+                               const std::int32_t *last_) {
+  __m512i acc = _mm512_setzero_si512();
+  for (; last_ - first_ >= 16; first_ += 16) {
+    __m512i block = _mm512_loadu_si512(first_);
+    acc = _mm512_add_epi64(
+        acc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(block)));
+    acc = _mm512_add_epi64(
+        acc, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(block, 1)));
+  }
+  alignas(64) std::int64_t lanes[8];
+  _mm512_store_si512(lanes, acc);
+  std::int64_t total{0};
+  for (std::int64_t lane : lanes) {
+    total += lane;
+  }
+  return total + sum_scalar(first_, last_);
+}
+SC_SIMD_TARGET("avx512f")
+inline double sum_avx512(const float *first_, const float *last_) {
+  __m512d acc = _mm512_setzero_pd();
+  for (; last_ - first_ >= 16; first_ += 16) {
+    acc = _mm512_add_pd(acc, _mm512_cvtps_pd(_mm256_loadu_ps(first_)));
+    acc = _mm512_add_pd(acc, _mm512_cvtps_pd(_mm256_loadu_ps(first_ + 8)));
+  }
+  alignas(64) double lanes[8];
+  _mm512_store_pd(lanes, acc);
+  double total{0};
+  for (double lane : lanes) {
+    total += lane;
+  }
+  return total + sum_scalar(first_, last_);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+/// Whether `T` has vectorized kernels.
+template <typename T>
+constexpr bool has_kernels_v =
+    SC_SIMD_X86 && (std::is_same<T, std::int32_t>::value ||
+                    std::is_same<T, float>::value);
+
+//=== Dispatch
+template <typename T> const T *find(const T *first_, const T *last_, T value_) {
+#if SC_SIMD_X86
+  if constexpr (has_kernels_v<T>) {
+    switch (active_level()) {
+    case level::avx512:
+      return find_avx512(first_, last_, value_);
+    case level::avx2:
+      return find_avx2(first_, last_, value_);
+    case level::sse2:
+      return find_sse2(first_, last_, value_);
+    case level::scalar:
+      break;
+    }
+  }
+#endif
+  return find_scalar(first_, last_, value_);
+}
+template <typename T>
+std::size_t count(const T *first_, const T *last_, T value_) {
+#if SC_SIMD_X86
+  if constexpr (has_kernels_v<T>) {
+    switch (active_level()) {
+    case level::avx512:
+      return count_avx512(first_, last_, value_);
+    case level::avx2:
+      return count_avx2(first_, last_, value_);
+    case level::sse2:
+      return count_sse2(first_, last_, value_);
+    case level::scalar:
+      break;
+    }
+  }
+#endif
+  return count_scalar(first_, last_, value_);
+}
+/// Smallest and largest element of a non-empty range.
+template <typename T> std::pair<T, T> minmax(const T *first_, const T *last_) {
+#if SC_SIMD_X86
+  if constexpr (has_kernels_v<T>) {
+    switch (active_level()) {
+    case level::avx512:
+      return minmax_avx512(first_, last_);
+    case level::avx2:
+      return minmax_avx2(first_, last_);
+    case level::sse2:
+      return minmax_sse2(first_, last_);
+    case level::scalar:
+      break;
+    }
+  }
+#endif
+  return minmax_scalar(first_, last_, {*first_, *first_});
+}
+template <typename T> sum_t<T> sum(const T *first_, const T *last_) {
+#if SC_SIMD_X86
+  if constexpr (has_kernels_v<T>) {
+    switch (active_level()) {
+    case level::avx512:
+      return sum_avx512(first_, last_);
+    case level::avx2:
+      return sum_avx2(first_, last_);
+    case level::sse2:
+      return sum_sse2(first_, last_);
+    case level::scalar:
+      break;
+    }
+  }
+#endif
+  return sum_scalar(first_, last_);
+}
+} // namespace detail
+
+//=== Algorithms
+/// `T`, in a position where it is not deduced, so `find(floats, 1)` works.
+template <typename T> using value_t = typename std::enable_if<true, T>::type;
+
+/// The first element equal to `value_`, or end().
+template <typename T, typename A, typename G, std::size_t N>
+typename vector<T, A, G, N>::const_iterator find(const vector<T, A, G, N> &vec_,
+                                                 value_t<T> value_) {
+  static_assert(std::is_arithmetic<T>::value, "sc::simd needs arithmetic types");
+  return vec_.begin() + (detail::find(vec_.data(), vec_.data() + vec_.size(),
+                                      value_) - vec_.data());
+}
+template <typename T, typename A, typename G, std::size_t N>
+typename vector<T, A, G, N>::iterator find(vector<T, A, G, N> &vec_,
+                                          value_t<T> value_) {
+  const auto &view = vec_;
+  return vec_.begin() + (find(view, value_) - view.begin());
+}
+/// Whether some element equals `value_`.
+template <typename T, typename A, typename G, std::size_t N>
+bool contains(const vector<T, A, G, N> &vec_, value_t<T> value_) {
+  return find(vec_, value_) != vec_.end();
+}
+/// Number of elements equal to `value_`.
+template <typename T, typename A, typename G, std::size_t N>
+std::size_t count(const vector<T, A, G, N> &vec_, value_t<T> value_) {
+  static_assert(std::is_arithmetic<T>::value, "sc::simd needs arithmetic types");
+  return detail::count(vec_.data(), vec_.data() + vec_.size(), value_);
+}
+/// The smallest and the largest element. Throws on an empty vector.
+template <typename T, typename A, typename G, std::size_t N>
+std::pair<T, T> minmax(const vector<T, A, G, N> &vec_) {
+  static_assert(std::is_arithmetic<T>::value, "sc::simd needs arithmetic types");
+  if (vec_.empty()) {
+    throw std::length_error("Vector está vazio!");
+  }
+  return detail::minmax(vec_.data(), vec_.data() + vec_.size());
+}
+namespace detail {
+/// The first element equal to `bound_`, a result of minmax(). A NaN bound
+/// only comes from a NaN first element, which find() would never match.
+template <typename V, typename T>
+auto locate(V &vec_, T bound_) -> decltype(vec_.begin()) {
+  return (bound_ != bound_) ? vec_.begin() : simd::find(vec_, bound_);
+}
+} // namespace detail
+/// The first smallest element, or end() if the vector is empty: the
+/// smallest value is found first, then searched for.
+template <typename T, typename A, typename G, std::size_t N>
+typename vector<T, A, G, N>::const_iterator
+min_element(const vector<T, A, G, N> &vec_) {
+  return vec_.empty() ? vec_.end() : detail::locate(vec_, minmax(vec_).first);
+}
+template <typename T, typename A, typename G, std::size_t N>
+typename vector<T, A, G, N>::iterator min_element(vector<T, A, G, N> &vec_) {
+  return vec_.empty() ? vec_.end() : detail::locate(vec_, minmax(vec_).first);
+}
+/// The first largest element, or end() if the vector is empty.
+template <typename T, typename A, typename G, std::size_t N>
+typename vector<T, A, G, N>::const_iterator
+max_element(const vector<T, A, G, N> &vec_) {
+  return vec_.empty() ? vec_.end() : detail::locate(vec_, minmax(vec_).second);
+}
+template <typename T, typename A, typename G, std::size_t N>
+typename vector<T, A, G, N>::iterator max_element(vector<T, A, G, N> &vec_) {
+  return vec_.empty() ? vec_.end() : detail::locate(vec_, minmax(vec_).second);
+}
+/// The sum of the elements, in 64-bit integers or at least doubles.
+template <typename T, typename A, typename G, std::size_t N>
+sum_t<T> sum(const vector<T, A, G, N> &vec_) {
+  static_assert(std::is_arithmetic<T>::value, "sc::simd needs arithmetic types");
+  return detail::sum(vec_.data(), vec_.data() + vec_.size());
+}
+} // namespace simd
+} // namespace sc
+
+#endif
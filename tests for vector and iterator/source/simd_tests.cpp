@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "simd.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Fifteenth batch of tests, focused on sc::simd
+// =============================================================
+
+// Every level agrees with the std algorithms on random inputs.
+#define MATCHES_SCALAR YES
+// Counters, sign handling and special float values.
+#define EDGE_CASES YES
+// Types without vector kernels use the scalar ones.
+#define OTHER_TYPES YES
+
+namespace {
+constexpr sc::simd::level levels[] = {sc::simd::level::scalar,
+                                      sc::simd::level::sse2,
+                                      sc::simd::level::avx2,
+                                      sc::simd::level::avx512};
+
+/// Equal values, counting two NaNs as equal.
+template <typename T> bool same_value(T lhs_, T rhs_) {
+  return lhs_ == rhs_ || (lhs_ != lhs_ && rhs_ != rhs_);
+}
+
+/// Checks every kernel on `vec_` against its std counterpart.
+template <typename T> bool agrees(const sc::vector<T> &vec_, T needle_) {
+  auto first = vec_.begin();
+  auto last = vec_.end();
+  bool ok = sc::simd::find(vec_, needle_) == std::find(first, last, needle_) &&
+            sc::simd::count(vec_, needle_) ==
+                std::size_t(std::count(first, last, needle_)) &&
+            sc::simd::contains(vec_, needle_) ==
+                (std::find(first, last, needle_) != last) &&
+            sc::simd::min_element(vec_) == std::min_element(first, last) &&
+            sc::simd::max_element(vec_) == std::max_element(first, last);
+  if (!vec_.empty()) {
+    auto bounds = sc::simd::minmax(vec_);
+    ok = ok && same_value(bounds.first, *std::min_element(first, last)) &&
+         same_value(bounds.second, *std::max_element(first, last));
+  }
+  auto exact = std::accumulate(first, last, sc::simd::sum_t<T>{0});
+  auto sum = sc::simd::sum(vec_);
+  if constexpr (std::is_floating_point<T>::value)
+    ok = ok && (same_value(sum, exact) ||
+                std::abs(sum - exact) <= 1e-9 * (1 + std::abs(exact)));
+  else
+    ok = ok && sum == exact;
+  return ok;
+}
+} // namespace
+
+void run_simd_tests(void) {
+  TestManager tm{"SIMD kernels testing"};
+  const sc::simd::level original = sc::simd::active_level();
+
+#if MATCHES_SCALAR
+  {
+    BEGIN_TEST(tm, "MatchesScalar", "every level agrees with std");
+
+    std::mt19937 gen{13};
+    bool same{true};
+    for (auto level : levels) {
+      sc::simd::set_level(level);
+      // Every tail length, and a few sizes past the widest block.
+      for (std::size_t n{0}; n < 300; n += (n < 70 ? 1 : 23)) {
+        sc::vector<std::int32_t> ints;
+        sc::vector<float> floats;
+        for (std::size_t i{0}; i < n; ++i) {
+          ints.push_back(std::int32_t(gen() % 64) - 32);
+          floats.push_back(float(int(gen() % 64) - 32) / 4.0f);
+        }
+        same = same && agrees(ints, std::int32_t(gen() % 80) - 40);
+        same = same && agrees(floats, float(int(gen() % 80) - 40) / 4.0f);
+        // NaNs anywhere, the first slot included.
+        if (n > 0) {
+          floats[gen() % n] = std::numeric_limits<float>::quiet_NaN();
+          if (n % 3 == 0)
+            floats[0] = std::numeric_limits<float>::quiet_NaN();
+          same = same && agrees(floats, float(int(gen() % 80) - 40) / 4.0f);
+        }
+      }
+    }
+    EXPECT_TRUE(same);
+  }
+#endif
+
+#if EDGE_CASES
+  {
+    BEGIN_TEST(tm, "EdgeCases", "wide counts, extremes and NaN");
+
+    // Enough equal elements to need several count() rounds.
+    sc::vector<std::int32_t> sevens(1'100'001);
+    std::fill(sevens.begin(), sevens.end(), 7);
+    sevens[1'100'000] = std::numeric_limits<std::int32_t>::min();
+    sevens[3] = std::numeric_limits<std::int32_t>::max();
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    sc::vector<float> specials{1.0f, -0.0f, nan, inf, 0.0f, -inf, 2.0f, nan,
+                               0.0f, 5.0f, -inf, 3.0f, 1.0f, 1.0f, 4.0f, 9.0f,
+                               0.0f, 8.0f};
+    bool same{true};
+    for (auto level : levels) {
+      sc::simd::set_level(level);
+      same = same && sc::simd::count(sevens, 7) == 1'099'999;
+      same = same && sc::simd::sum(sevens) ==
+                         std::int64_t(7) * 1'099'999 +
+                             std::numeric_limits<std::int32_t>::max() +
+                             std::numeric_limits<std::int32_t>::min();
+      auto bounds = sc::simd::minmax(sevens);
+      same = same && bounds.first == std::numeric_limits<std::int32_t>::min() &&
+             bounds.second == std::numeric_limits<std::int32_t>::max();
+      same = same && sc::simd::max_element(sevens) == sevens.begin() + 3;
+      // NaN never compares equal; +0.0 and -0.0 always do.
+      same = same && sc::simd::find(specials, nan) == specials.end();
+      same = same && sc::simd::count(specials, 0.0f) == 4;
+      same = same && sc::simd::find(specials, 0.0f) == specials.begin() + 1;
+      // NaNs are skipped, unless one comes first.
+      same = same && sc::simd::min_element(specials) == specials.begin() + 5;
+      same = same && sc::simd::max_element(specials) == specials.begin() + 3;
+      specials[0] = nan;
+      same = same && sc::simd::min_element(specials) == specials.begin();
+      same = same && sc::simd::max_element(specials) == specials.begin();
+      specials[0] = 1.0f;
+    }
+    EXPECT_TRUE(same);
+
+    sc::vector<float> empty;
+    EXPECT_TRUE(sc::simd::min_element(empty) == empty.end());
+    EXPECT_EQ(sc::simd::sum(empty), 0.0);
+    bool thrown{false};
+    try {
+      sc::simd::minmax(empty);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+#if OTHER_TYPES
+  {
+    BEGIN_TEST(tm, "OtherTypes", "scalar fallback for other types");
+
+    std::mt19937_64 gen{14};
+    sc::vector<std::int64_t> longs;
+    sc::vector<double> doubles;
+    sc::vector<std::uint8_t> bytes;
+    for (int i{0}; i < 1000; ++i) {
+      longs.push_back(std::int64_t(gen() % 1000) - 500);
+      doubles.push_back(double(gen() % 100) / 8.0);
+      bytes.push_back(std::uint8_t(gen()));
+    }
+    EXPECT_TRUE(agrees(longs, std::int64_t(17)));
+    EXPECT_TRUE(agrees(doubles, 2.5));
+    EXPECT_TRUE(agrees(bytes, std::uint8_t(200)));
+    // Unsigned bytes add up without wrapping.
+    EXPECT_EQ(sc::simd::sum(bytes),
+              std::accumulate(bytes.begin(), bytes.end(), std::uint64_t{0}));
+  }
+#endif
+
+  sc::simd::set_level(original);
+  tm.summary();
+  std::cout << "\n\n";
+}
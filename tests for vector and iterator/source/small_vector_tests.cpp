@@ -0,0 +1,193 @@
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Sixth batch of tests, focused on sc::small_vector
+// =============================================================
+
+// Up to N elements never touch the heap.
+#define INLINE_STORAGE YES
+// Past N the elements spill to the heap, and come back on shrink_to_fit().
+#define SPILL_TO_HEAP YES
+// Copies and moves work for both inline and heap storage.
+#define COPY_AND_MOVE YES
+// swap() between inline and heap storage.
+#define MIXED_SWAP YES
+
+namespace {
+/// Counts heap allocations, to tell inline storage from heap storage.
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+
+  static int allocations; //!< Number of allocate() calls.
+  static long live;       //!< Bytes currently handed out.
+
+  CountingAllocator(void) = default;
+  template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    ++allocations;
+    live += long(n * sizeof(T));
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T *ptr, std::size_t n) {
+    live -= long(n * sizeof(T));
+    ::operator delete(ptr);
+  }
+  friend bool operator==(const CountingAllocator &, const CountingAllocator &) {
+    return true;
+  }
+  friend bool operator!=(const CountingAllocator &, const CountingAllocator &) {
+    return false;
+  }
+};
+template <typename T> int CountingAllocator<T>::allocations{0};
+template <typename T> long CountingAllocator<T>::live{0};
+
+/// Tells whether `ptr` lies inside the object `obj`.
+template <typename C, typename P> bool inside(const C &obj, const P *ptr) {
+  auto *first = reinterpret_cast<const char *>(&obj);
+  auto *p = reinterpret_cast<const char *>(ptr);
+  return p >= first && p < first + sizeof(C);
+}
+} // namespace
+
+void run_small_vector_tests(void) {
+  TestManager tm{"Small vector testing"};
+  using alloc_t = CountingAllocator<std::string>;
+  using small_t = sc::small_vector<std::string, 4, alloc_t>;
+
+#if INLINE_STORAGE
+  {
+    BEGIN_TEST(tm, "InlineStorage", "no heap up to N elements");
+
+    alloc_t::allocations = 0;
+    small_t vec;
+    EXPECT_EQ(vec.capacity(), 4);
+    vec.push_back("a");
+    vec.emplace_back(3, 'b');
+    vec.insert(vec.begin(), "c");
+    vec.push_back("d");
+    EXPECT_EQ(vec, (small_t{"c", "a", "bbb", "d"}));
+    EXPECT_TRUE(inside(vec, vec.data()));
+    EXPECT_EQ(alloc_t::allocations, 0);
+
+    // The interface, iterators included, is the one of sc::vector.
+    EXPECT_TRUE((std::is_same<small_t::iterator,
+                              sc::vector<std::string>::iterator>::value));
+    std::string joined;
+    for (auto i = vec.begin(); i != vec.end(); ++i)
+      joined += *i;
+    EXPECT_EQ(joined, "cabbbd");
+  }
+#endif
+
+#if SPILL_TO_HEAP
+  {
+    BEGIN_TEST(tm, "SpillToHeap", "past N elements go to the heap");
+
+    {
+      alloc_t::allocations = 0;
+      small_t vec{"a", "b", "c", "d"};
+      vec.push_back("e");
+      EXPECT_EQ(alloc_t::allocations, 1);
+      EXPECT_FALSE(inside(vec, vec.data()));
+      EXPECT_EQ(vec.capacity(), 8);
+      EXPECT_EQ(vec[4], "e");
+
+      vec.erase(vec.begin(), vec.begin() + 3);
+      vec.shrink_to_fit();
+      EXPECT_TRUE(inside(vec, vec.data()));
+      EXPECT_EQ(vec.capacity(), 4);
+      EXPECT_EQ(vec, (small_t{"d", "e"}));
+    }
+    EXPECT_EQ(alloc_t::live, 0);
+
+    // Plain ints with the default allocator grow with realloc() once on
+    // the heap, but never realloc() the inline buffer.
+    sc::small_vector<int, 8> nums;
+    for (int i{0}; i < 100; ++i)
+      nums.push_back(i);
+    EXPECT_EQ(nums.size(), 100);
+    EXPECT_EQ(nums[99], 99);
+    nums.erase(nums.begin() + 2, nums.end());
+    nums.shrink_to_fit();
+    EXPECT_TRUE(inside(nums, nums.data()));
+    EXPECT_EQ(nums[1], 1);
+  }
+#endif
+
+#if COPY_AND_MOVE
+  {
+    BEGIN_TEST(tm, "CopyAndMove", "copy/move of inline and heap storage");
+
+    {
+      small_t inl{"a", "b"};
+      small_t heap{"1", "2", "3", "4", "5", "6"};
+
+      small_t inl_copy{inl};
+      small_t heap_copy{heap};
+      EXPECT_EQ(inl_copy, inl);
+      EXPECT_EQ(heap_copy, heap);
+      EXPECT_TRUE(inside(inl_copy, inl_copy.data()));
+
+      // Moving inline storage moves the elements themselves.
+      small_t inl_moved{std::move(inl)};
+      EXPECT_EQ(inl_moved, (small_t{"a", "b"}));
+      EXPECT_TRUE(inside(inl_moved, inl_moved.data()));
+      EXPECT_TRUE(inl.empty());
+
+      // Moving heap storage hands the buffer over.
+      const std::string *buffer = heap.data();
+      small_t heap_moved{std::move(heap)};
+      EXPECT_TRUE(heap_moved.data() == buffer);
+      EXPECT_TRUE(heap.empty());
+      EXPECT_EQ(heap.capacity(), 4);
+
+      heap = std::move(inl_moved);
+      inl_moved = std::move(heap_moved);
+      EXPECT_EQ(heap, (small_t{"a", "b"}));
+      EXPECT_EQ(inl_moved.size(), 6);
+      EXPECT_TRUE(inl_moved.data() == buffer);
+
+      heap_copy = inl_copy;
+      EXPECT_EQ(heap_copy, inl_copy);
+    }
+    EXPECT_EQ(alloc_t::live, 0);
+  }
+#endif
+
+#if MIXED_SWAP
+  {
+    BEGIN_TEST(tm, "MixedSwap", "swap between inline and heap storage");
+
+    {
+      small_t inl{"a"};
+      small_t heap{"1", "2", "3", "4", "5"};
+      const std::string *buffer = heap.data();
+
+      swap(inl, heap);
+      EXPECT_EQ(inl.size(), 5);
+      EXPECT_TRUE(inl.data() == buffer);
+      EXPECT_EQ(heap, (small_t{"a"}));
+      EXPECT_TRUE(inside(heap, heap.data()));
+
+      small_t other{"x", "y"};
+      swap(heap, other);
+      EXPECT_EQ(heap, (small_t{"x", "y"}));
+      EXPECT_EQ(other, (small_t{"a"}));
+    }
+    EXPECT_EQ(alloc_t::live, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
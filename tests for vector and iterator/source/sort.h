@@ -0,0 +1,645 @@
+#ifndef _SORT_H_
+#define _SORT_H_
+
+#include <algorithm>   // std::is_sorted, std::make_heap, std::inplace_merge
+#include <array>       // std::array
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <cstdint>     // std::uint8_t, std::uint64_t
+#include <cstring>     // std::memcpy
+#include <functional>  // std::less
+#include <limits>      // std::numeric_limits
+#include <memory>      // std::allocator
+#include <type_traits> // std::is_arithmetic, std::is_trivially_copyable,
+                       // std::conditional_t
+#include <utility>     // std::move, std::swap, std::pair
+#include <vector>      // std::vector
+
+#include "parallel.h"
+#include "vector.h"
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+//=== Radix keys
+/// The unsigned integer type with `Bytes` bytes.
+template <std::size_t Bytes> struct unsigned_of;
+template <> struct unsigned_of<1> { using type = std::uint8_t; };
+template <> struct unsigned_of<2> { using type = std::uint16_t; };
+template <> struct unsigned_of<4> { using type = std::uint32_t; };
+template <> struct unsigned_of<8> { using type = std::uint64_t; };
+
+/// Whether `T` can be sorted by its bytes: integers and IEEE floats of up
+/// to 8 bytes, but not `bool`.
+template <typename T>
+constexpr bool is_radix_key_v =
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) &&
+    (std::is_integral<T>::value || std::numeric_limits<T>::is_iec559);
+
+/// Maps `key_` to an unsigned integer that sorts in the same order.
+/*!
+ * Signed integers get their sign bit flipped. Floats get their sign bit
+ * flipped when positive, and all their bits flipped when negative, which
+ * also reverses the order of the negative ones. -0.0 sorts before +0.0,
+ * and NaNs go to the ends, by sign.
+ */
+template <typename T> auto radix_bits(T key_) {
+  using bits_t = typename unsigned_of<sizeof(T)>::type;
+  constexpr bits_t sign = bits_t(bits_t(1) << (8 * sizeof(T) - 1));
+  bits_t bits;
+  std::memcpy(&bits, &key_, sizeof(T));
+  if constexpr (std::is_floating_point<T>::value) {
+    return bits_t((bits & sign) ? ~bits : bits | sign);
+  } else if constexpr (std::is_signed<T>::value) {
+    return bits_t(bits ^ sign);
+  } else {
+    return bits;
+  }
+}
+
+/// Orders keys by `radix_bits()`, the order the radix sort produces.
+/*!
+ * Unlike `<` on floats, this is a strict weak order even with NaNs, and
+ * tells -0.0 from +0.0.
+ */
+struct radix_less {
+  template <typename T> bool operator()(T lhs_, T rhs_) const {
+    return radix_bits(lhs_) < radix_bits(rhs_);
+  }
+};
+
+/// The comparator that sorts `T`s like the radix sort: `radix_less` for
+/// floats, plain `<` for integers, where the two agree.
+template <typename T>
+using radix_order_t = std::conditional_t<std::is_floating_point<T>::value,
+                                         radix_less, std::less<>>;
+
+/// Byte `pass_` of `bits_`, counting from the least significant one.
+template <typename Bits> std::size_t radix_digit(Bits bits_, std::size_t pass_) {
+  return std::size_t(bits_ >> (8 * pass_)) & 0xff;
+}
+
+/// Below this many elements, radix sort loses to pdqsort.
+constexpr std::size_t radix_threshold{256};
+
+/// Sorts [data_, data_ + n_) by `key_(element)`, stably, one byte at a
+/// time from the least significant. `scratch_` has room for `n_`
+/// elements. A pass is skipped when all keys share its byte, so small
+/// keys in wide types cost fewer passes.
+template <typename T, typename Key>
+void lsd_radix_sort(T *data_, T *scratch_, std::size_t n_, Key key_) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "radix sort moves elements as bytes");
+  using bits_t = decltype(radix_bits(key_(*data_)));
+  constexpr std::size_t passes{sizeof(bits_t)};
+  // One read of the input counts the bytes of every pass.
+  std::array<std::array<std::size_t, 256>, passes> counts{};
+  for (std::size_t i{0}; i < n_; ++i) {
+    bits_t bits = radix_bits(key_(data_[i]));
+    for (std::size_t p{0}; p < passes; ++p) {
+      ++counts[p][radix_digit(bits, p)];
+    }
+  }
+  T *from = data_;
+  T *to = scratch_;
+  for (std::size_t p{0}; p < passes; ++p) {
+    if (counts[p][radix_digit(radix_bits(key_(from[0])), p)] == n_) {
+      continue;
+    }
+    std::size_t next{0};
+    for (auto &count : counts[p]) {
+      std::size_t here = count;
+      count = next;
+      next += here;
+    }
+    for (std::size_t i{0}; i < n_; ++i) {
+      to[counts[p][radix_digit(radix_bits(key_(from[i])), p)]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+  if (from != data_) {
+    std::memcpy(static_cast<void *>(data_), from, n_ * sizeof(T));
+  }
+}
+
+/// Room for as many elements as `vec_` holds, to be used as radix sort
+/// scratch: the spare capacity of `vec_` when it is big enough, a
+/// temporary block otherwise.
+template <typename T> class scratch_buffer {
+public:
+  template <typename Vec> explicit scratch_buffer(Vec &vec_) {
+    if (vec_.capacity() - vec_.size() >= vec_.size()) {
+      m_data = vec_.data() + vec_.size();
+    } else {
+      m_owned = vec_.size();
+      m_data = std::allocator<T>().allocate(m_owned);
+    }
+  }
+  scratch_buffer(const scratch_buffer &) = delete;
+  scratch_buffer &operator=(const scratch_buffer &) = delete;
+  ~scratch_buffer(void) {
+    if (m_owned > 0) {
+      std::allocator<T>().deallocate(m_data, m_owned);
+    }
+  }
+  T *data(void) const { return m_data; }
+
+private:
+  T *m_data{nullptr};      //!< First slot.
+  std::size_t m_owned{0};  //!< Slots allocated here, if any.
+};
+
+//=== pdqsort
+/*!
+ * Pattern-defeating quicksort (Orson Peters): introsort whose pivot is a
+ * median of 3 or a ninther, which notices already partitioned ranges and
+ * finishes them with a bounded insertion sort, which puts runs of keys
+ * equal to the previous pivot aside in one partition_left() pass, and
+ * which shuffles a few elements after a bad partition, falling back to
+ * heapsort after too many. For arithmetic types under the default order,
+ * partitioning compares a block of elements at a time and records the
+ * misplaced ones in offset buffers, so no comparison result is ever
+ * branched on (BlockQuicksort).
+ */
+namespace pdq {
+constexpr std::ptrdiff_t insertion_threshold{24}; //!< Insertion sort below.
+constexpr std::ptrdiff_t ninther_threshold{128};  //!< Ninther pivot above.
+constexpr std::ptrdiff_t partial_limit{8};        //!< Moves before giving up.
+constexpr std::ptrdiff_t block_size{64};          //!< Branchless block.
+
+/// Insertion sort; `Guarded` false means an element not greater than
+/// any of [first_, last_) sits right before `first_`.
+template <bool Guarded, typename T, typename Compare>
+void insertion_sort(T *first_, T *last_, Compare comp_) {
+  if (first_ == last_) {
+    return;
+  }
+  for (T *cur{first_ + 1}; cur != last_; ++cur) {
+    if (comp_(*cur, *(cur - 1))) {
+      T tmp = std::move(*cur);
+      T *sift = cur;
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while ((!Guarded || sift != first_) && comp_(tmp, *(sift - 1)));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+/// Insertion sort that gives up after `partial_limit` moves. True if it
+/// sorted the range.
+template <typename T, typename Compare>
+bool partial_insertion_sort(T *first_, T *last_, Compare comp_) {
+  if (first_ == last_) {
+    return true;
+  }
+  std::ptrdiff_t moves{0};
+  for (T *cur{first_ + 1}; cur != last_; ++cur) {
+    if (comp_(*cur, *(cur - 1))) {
+      T tmp = std::move(*cur);
+      T *sift = cur;
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while (sift != first_ && comp_(tmp, *(sift - 1)));
+      *sift = std::move(tmp);
+      moves += cur - sift;
+      if (moves > partial_limit) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T, typename Compare> void sort2(T *a_, T *b_, Compare comp_) {
+  if (comp_(*b_, *a_)) {
+    std::iter_swap(a_, b_);
+  }
+}
+template <typename T, typename Compare>
+void sort3(T *a_, T *b_, T *c_, Compare comp_) {
+  sort2(a_, b_, comp_);
+  sort2(b_, c_, comp_);
+  sort2(a_, b_, comp_);
+}
+
+/// Partitions [begin_, end_) around the pivot `*begin_`, with the
+/// elements equal to it on the right. Returns the final position of the
+/// pivot, and whether nothing had to move.
+template <bool Branchless, typename T, typename Compare>
+std::pair<T *, bool> partition_right(T *begin_, T *end_, Compare comp_) {
+  T pivot = std::move(*begin_);
+  T *first = begin_;
+  T *last = end_;
+  // The median of 3 guarantees an element >= pivot on the right.
+  while (comp_(*++first, pivot)) {
+  }
+  if (first - 1 == begin_) {
+    while (first < last && !comp_(*--last, pivot)) {
+    }
+  } else {
+    while (!comp_(*--last, pivot)) {
+    }
+  }
+  bool already_partitioned = first >= last;
+  if constexpr (!Branchless) {
+    while (first < last) {
+      std::iter_swap(first, last);
+      while (comp_(*++first, pivot)) {
+      }
+      while (!comp_(*--last, pivot)) {
+      }
+    }
+  } else if (!already_partitioned) {
+    std::iter_swap(first, last);
+    ++first;
+    // Offsets of the misplaced elements of the current left and right
+    // blocks, counted from `left_base` and `right_base`.
+    unsigned char left_offsets[block_size];
+    unsigned char right_offsets[block_size];
+    T *left_base = first;
+    T *right_base = last;
+    std::ptrdiff_t left_count{0}, right_count{0};
+    std::ptrdiff_t left_start{0}, right_start{0};
+    while (first < last) {
+      std::ptrdiff_t unknown = last - first;
+      std::ptrdiff_t left_split =
+          left_count == 0 ? (right_count == 0 ? unknown / 2 : unknown) : 0;
+      std::ptrdiff_t right_split = right_count == 0 ? unknown - left_split : 0;
+      left_split = std::min(left_split, block_size);
+      right_split = std::min(right_split, block_size);
+      for (std::ptrdiff_t i{0}; i < left_split; ++i) {
+        left_offsets[left_count] = static_cast<unsigned char>(i);
+        left_count += !comp_(*first, pivot);
+        ++first;
+      }
+      for (std::ptrdiff_t i{0}; i < right_split; ++i) {
+        right_offsets[right_count] = static_cast<unsigned char>(i + 1);
+        right_count += comp_(*--last, pivot);
+      }
+      std::ptrdiff_t swaps = std::min(left_count, right_count);
+      for (std::ptrdiff_t i{0}; i < swaps; ++i) {
+        std::iter_swap(left_base + left_offsets[left_start + i],
+                       right_base - right_offsets[right_start + i]);
+      }
+      left_count -= swaps;
+      right_count -= swaps;
+      left_start += swaps;
+      right_start += swaps;
+      if (left_count == 0) {
+        left_start = 0;
+        left_base = first;
+      }
+      if (right_count == 0) {
+        right_start = 0;
+        right_base = last;
+      }
+    }
+    // One side may still hold misplaced elements; move them to the middle.
+    if (left_count > 0) {
+      while (left_count-- > 0) {
+        std::iter_swap(left_base + left_offsets[left_start + left_count],
+                       --last);
+      }
+      first = last;
+    }
+    if (right_count > 0) {
+      while (right_count-- > 0) {
+        std::iter_swap(right_base - right_offsets[right_start + right_count],
+                       first);
+        ++first;
+      }
+    }
+  }
+  T *pivot_pos = first - 1;
+  *begin_ = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return {pivot_pos, already_partitioned};
+}
+
+/// Partitions [begin_, end_) around the pivot `*begin_`, with the
+/// elements equal to it on the left, and returns the pivot's position.
+/// Used when the pivot equals the element before the range, so the whole
+/// left side is done.
+template <typename T, typename Compare>
+T *partition_left(T *begin_, T *end_, Compare comp_) {
+  T pivot = std::move(*begin_);
+  T *first = begin_;
+  T *last = end_;
+  while (comp_(pivot, *--last)) {
+  }
+  if (last + 1 == end_) {
+    while (first < last && !comp_(pivot, *++first)) {
+    }
+  } else {
+    while (!comp_(pivot, *++first)) {
+    }
+  }
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp_(pivot, *--last)) {
+    }
+    while (!comp_(pivot, *++first)) {
+    }
+  }
+  *begin_ = std::move(*last);
+  *last = std::move(pivot);
+  return last;
+}
+
+/// Swaps a few elements of a side that came out too small, so the next
+/// pivot of that side is unlikely to be as bad.
+template <typename T> void break_patterns(T *first_, T *last_) {
+  std::ptrdiff_t size = last_ - first_;
+  if (size < insertion_threshold) {
+    return;
+  }
+  std::iter_swap(first_, first_ + size / 4);
+  std::iter_swap(last_ - 1, last_ - size / 4);
+  if (size > ninther_threshold) {
+    std::iter_swap(first_ + 1, first_ + (size / 4 + 1));
+    std::iter_swap(first_ + 2, first_ + (size / 4 + 2));
+    std::iter_swap(last_ - 2, last_ - (size / 4 + 1));
+    std::iter_swap(last_ - 3, last_ - (size / 4 + 2));
+  }
+}
+
+template <bool Branchless, typename T, typename Compare>
+void sort_loop(T *begin_, T *end_, Compare comp_, int bad_allowed_,
+               bool leftmost_) {
+  while (true) {
+    std::ptrdiff_t size = end_ - begin_;
+    if (size < insertion_threshold) {
+      if (leftmost_) {
+        insertion_sort<true>(begin_, end_, comp_);
+      } else {
+        insertion_sort<false>(begin_, end_, comp_);
+      }
+      return;
+    }
+    // The pivot goes to *begin_.
+    std::ptrdiff_t half = size / 2;
+    if (size > ninther_threshold) {
+      sort3(begin_, begin_ + half, end_ - 1, comp_);
+      sort3(begin_ + 1, begin_ + (half - 1), end_ - 2, comp_);
+      sort3(begin_ + 2, begin_ + (half + 1), end_ - 3, comp_);
+      sort3(begin_ + (half - 1), begin_ + half, begin_ + (half + 1), comp_);
+      std::iter_swap(begin_, begin_ + half);
+    } else {
+      sort3(begin_ + half, begin_, end_ - 1, comp_);
+    }
+    // Equal to the previous pivot: everything equal to it can stay left.
+    if (!leftmost_ && !comp_(*(begin_ - 1), *begin_)) {
+      begin_ = partition_left(begin_, end_, comp_) + 1;
+      continue;
+    }
+    auto [pivot_pos, already_partitioned] =
+        partition_right<Branchless>(begin_, end_, comp_);
+    std::ptrdiff_t left_size = pivot_pos - begin_;
+    std::ptrdiff_t right_size = end_ - (pivot_pos + 1);
+    if (left_size < size / 8 || right_size < size / 8) {
+      if (--bad_allowed_ == 0) {
+        std::make_heap(begin_, end_, comp_);
+        std::sort_heap(begin_, end_, comp_);
+        return;
+      }
+      break_patterns(begin_, pivot_pos);
+      break_patterns(pivot_pos + 1, end_);
+    } else if (already_partitioned &&
+               partial_insertion_sort(begin_, pivot_pos, comp_) &&
+               partial_insertion_sort(pivot_pos + 1, end_, comp_)) {
+      return;
+    }
+    // Recurse left, loop right.
+    sort_loop<Branchless>(begin_, pivot_pos, comp_, bad_allowed_, leftmost_);
+    begin_ = pivot_pos + 1;
+    leftmost_ = false;
+  }
+}
+
+/// Whether comparing `T`s with `Compare` is cheap and free of side
+/// effects, so block partitioning pays off.
+template <typename T, typename Compare>
+constexpr bool branchless_v =
+    std::is_arithmetic<T>::value && (std::is_same<Compare, std::less<T>>::value ||
+                                     std::is_same<Compare, std::less<>>::value ||
+                                     std::is_same<Compare, radix_less>::value);
+
+/// Sorts [first_, last_) with `comp_`.
+template <typename T, typename Compare>
+void sort(T *first_, T *last_, Compare comp_) {
+  std::ptrdiff_t size = last_ - first_;
+  int log2{0};
+  while (size > 1) {
+    size >>= 1;
+    ++log2;
+  }
+  sort_loop<branchless_v<T, Compare>>(first_, last_, comp_, log2 + 1, true);
+}
+} // namespace pdq
+
+/// Sorts `vec_` stably by `key_(element)`, an integer or float.
+template <typename Vec, typename Key> void sort_by_key(Vec &vec_, Key key_) {
+  using T = typename Vec::value_type;
+  std::size_t n = vec_.size();
+  if (n < 2) {
+    return;
+  }
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    scratch_buffer<T> scratch{vec_};
+    lsd_radix_sort(vec_.data(), scratch.data(), n, key_);
+  } else {
+    // Sort (key, index) pairs, then move the elements where they belong.
+    struct keyed {
+      std::decay_t<decltype(key_(vec_[0]))> key; //!< The element's key.
+      std::size_t index;                         //!< Where the element is.
+    };
+    std::vector<keyed> order(n), spare(n);
+    for (std::size_t i{0}; i < n; ++i) {
+      order[i] = keyed{key_(vec_[i]), i};
+    }
+    lsd_radix_sort(order.data(), spare.data(), n,
+                   [](const keyed &entry) { return entry.key; });
+    Vec sorted(vec_.get_allocator());
+    sorted.reserve(n);
+    for (const auto &entry : order) {
+      sorted.push_back(std::move(vec_[entry.index]));
+    }
+    vec_ = std::move(sorted);
+  }
+}
+} // namespace detail
+
+/// Sorts `vec_` in ascending order.
+/*!
+ * Integers and floats are radix sorted, one byte per pass, with the
+ * vector's spare capacity as scratch space when it has room for a copy
+ * of the elements; reserve() twice the size to sort without allocating.
+ * Floats are ordered by their bits after a sign flip, which matches `<`
+ * except that -0.0 comes before +0.0 and NaNs go to the ends, by sign;
+ * short vectors, sorted by pdqsort, get the same order. Other types go
+ * through pdqsort with `<`.
+ */
+template <typename T, typename A, typename G, std::size_t N>
+void sort(vector<T, A, G, N> &vec_) {
+  if constexpr (detail::is_radix_key_v<T>) {
+    detail::radix_order_t<T> order;
+    if (vec_.size() < detail::radix_threshold) {
+      detail::pdq::sort(vec_.data(), vec_.data() + vec_.size(), order);
+      return;
+    }
+    // Sorted input is common, and costs one early-exiting scan to spot.
+    if (std::is_sorted(vec_.begin(), vec_.end(), order)) {
+      return;
+    }
+    detail::sort_by_key(vec_, [](T x) { return x; });
+  } else {
+    detail::pdq::sort(vec_.data(), vec_.data() + vec_.size(), std::less<>{});
+  }
+}
+
+/// Sorts `vec_` with `comp_`, using pdqsort. Not stable.
+template <typename T, typename A, typename G, std::size_t N, typename Compare>
+void sort(vector<T, A, G, N> &vec_, Compare comp_) {
+  detail::pdq::sort(vec_.data(), vec_.data() + vec_.size(), comp_);
+}
+
+/// Sorts `vec_` stably by `key_(element)`, which must return an integer
+/// or a float: a radix sort of whole records by one of their fields.
+template <typename T, typename A, typename G, std::size_t N, typename Key>
+void sort_by_key(vector<T, A, G, N> &vec_, Key key_) {
+  detail::sort_by_key(vec_, key_);
+}
+
+namespace parallel {
+namespace detail {
+/// Radix sort of [data_, data_ + n_) on `pool_`. Each pass counts the
+/// bytes of every chunk, turns the counts into per chunk offsets, in
+/// chunk order, and lets each chunk scatter its own elements, so the
+/// result is as stable as the sequential one.
+template <typename T, typename Key>
+void lsd_radix_sort(thread_pool &pool_, T *data_, T *scratch_, std::size_t n_,
+                    Key key_) {
+  using bits_t = decltype(sc::detail::radix_bits(key_(*data_)));
+  constexpr std::size_t passes{sizeof(bits_t)};
+  using counts_t = std::array<std::size_t, 256>;
+  // A few chunks per thread is enough to balance, and keeps the counts small.
+  std::size_t width =
+      std::max(pool_.grain(), chunk_count(n_, 4 * pool_.size()));
+  std::size_t chunks = chunk_count(n_, width);
+  auto chunk_end = [n_, width](std::size_t c) {
+    return std::min(n_, (c + 1) * width);
+  };
+
+  // Skip the passes where all the keys share their byte.
+  std::vector<std::array<counts_t, passes>> all(chunks);
+  pool_.run(chunks, [&](std::size_t c) {
+    for (std::size_t i{c * width}; i < chunk_end(c); ++i) {
+      bits_t bits = sc::detail::radix_bits(key_(data_[i]));
+      for (std::size_t p{0}; p < passes; ++p) {
+        ++all[c][p][sc::detail::radix_digit(bits, p)];
+      }
+    }
+  });
+  std::vector<counts_t> counts(chunks);
+  T *from = data_;
+  T *to = scratch_;
+  for (std::size_t p{0}; p < passes; ++p) {
+    std::size_t digit = sc::detail::radix_digit(
+        sc::detail::radix_bits(key_(from[0])), p);
+    std::size_t same{0};
+    for (std::size_t c{0}; c < chunks; ++c) {
+      same += all[c][p][digit];
+    }
+    if (same == n_) {
+      continue;
+    }
+    pool_.run(chunks, [&](std::size_t c) {
+      counts[c].fill(0);
+      for (std::size_t i{c * width}; i < chunk_end(c); ++i) {
+        ++counts[c][sc::detail::radix_digit(
+            sc::detail::radix_bits(key_(from[i])), p)];
+      }
+    });
+    std::size_t next{0};
+    for (std::size_t d{0}; d < 256; ++d) {
+      for (std::size_t c{0}; c < chunks; ++c) {
+        std::size_t here = counts[c][d];
+        counts[c][d] = next;
+        next += here;
+      }
+    }
+    pool_.run(chunks, [&](std::size_t c) {
+      for (std::size_t i{c * width}; i < chunk_end(c); ++i) {
+        to[counts[c][sc::detail::radix_digit(
+            sc::detail::radix_bits(key_(from[i])), p)]++] = from[i];
+      }
+    });
+    std::swap(from, to);
+  }
+  if (from != data_) {
+    pool_.run(chunks, [&](std::size_t c) {
+      std::memcpy(static_cast<void *>(data_ + c * width), from + c * width,
+                  (chunk_end(c) - c * width) * sizeof(T));
+    });
+  }
+}
+
+/// Merge sort of [data_, data_ + n_) on `pool_`: pdqsort on chunks, then
+/// rounds of merges of neighbouring runs, each round in parallel. The
+/// last round is a single merge, so it runs on one thread.
+template <typename T, typename Compare>
+void merge_sort(thread_pool &pool_, T *data_, std::size_t n_, Compare comp_) {
+  std::size_t width =
+      std::max(pool_.grain(), chunk_count(n_, 4 * pool_.size()));
+  pool_.run(chunk_count(n_, width), [&](std::size_t c) {
+    sc::detail::pdq::sort(data_ + c * width,
+                          data_ + std::min(n_, (c + 1) * width), comp_);
+  });
+  for (; width < n_; width *= 2) {
+    pool_.run(chunk_count(n_, 2 * width), [&](std::size_t pair) {
+      std::size_t first = pair * 2 * width;
+      std::size_t middle = std::min(n_, first + width);
+      std::size_t last = std::min(n_, first + 2 * width);
+      std::inplace_merge(data_ + first, data_ + middle, data_ + last, comp_);
+    });
+  }
+}
+} // namespace detail
+
+/// Sorts `vec_` in ascending order on `pool_`: a parallel radix sort for
+/// integers and floats, a parallel merge sort otherwise. Same order as
+/// `sc::sort()`, and the same use of spare capacity.
+template <typename T, typename A, typename G, std::size_t N>
+void sort(thread_pool &pool_, vector<T, A, G, N> &vec_) {
+  if constexpr (sc::detail::is_radix_key_v<T>) {
+    sc::detail::radix_order_t<T> order;
+    if (vec_.size() < sc::detail::radix_threshold) {
+      detail::merge_sort(pool_, vec_.data(), vec_.size(), order);
+      return;
+    }
+    if (std::is_sorted(vec_.begin(), vec_.end(), order)) {
+      return;
+    }
+    sc::detail::scratch_buffer<T> scratch{vec_};
+    detail::lsd_radix_sort(pool_, vec_.data(), scratch.data(), vec_.size(),
+                           [](T x) { return x; });
+  } else {
+    detail::merge_sort(pool_, vec_.data(), vec_.size(), std::less<>{});
+  }
+}
+/// Sorts `vec_` with `comp_` on `pool_`, using a parallel merge sort.
+template <typename T, typename A, typename G, std::size_t N, typename Compare>
+void sort(thread_pool &pool_, vector<T, A, G, N> &vec_, Compare comp_) {
+  detail::merge_sort(pool_, vec_.data(), vec_.size(), comp_);
+}
+template <typename T, typename A, typename G, std::size_t N>
+void sort(vector<T, A, G, N> &vec_) {
+  sort(default_pool(), vec_);
+}
+} // namespace parallel
+} // namespace sc
+
+#endif
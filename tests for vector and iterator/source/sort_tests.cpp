@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sort.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Fourteenth batch of tests, focused on sc::sort
+// =============================================================
+
+// Integers and floats are radix sorted into std::sort's order.
+#define RADIX_KEYS YES
+// Other types and comparators go through pdqsort, on every input shape.
+#define PDQSORT_SHAPES YES
+// sort_by_key sorts whole records, stably.
+#define SORT_BY_KEY YES
+// sc::parallel::sort agrees with the sequential sort.
+#define PARALLEL_SORT YES
+// Zeros and NaNs land in key order, whatever the size of the vector.
+#define FLOAT_KEY_ORDER YES
+
+namespace {
+/// `n_` random values of `T`, from the full range of its bit patterns.
+template <typename T> sc::vector<T> random_values(std::size_t n_, unsigned seed_) {
+  std::mt19937_64 gen{seed_};
+  sc::vector<T> vec;
+  vec.reserve(n_);
+  for (std::size_t i{0}; i < n_; ++i) {
+    if constexpr (std::is_floating_point<T>::value)
+      vec.push_back(T(std::uniform_real_distribution<double>{-1e6, 1e6}(gen)));
+    else
+      vec.push_back(T(gen()));
+  }
+  return vec;
+}
+
+/// Sorts a copy of `vec_` with sc::sort and with std::sort, and compares.
+template <typename Vec> bool sorts_like_std(const Vec &vec_) {
+  Vec mine{vec_};
+  sc::sort(mine);
+  std::vector<typename Vec::value_type> expected(vec_.begin(), vec_.end());
+  std::sort(expected.begin(), expected.end());
+  return std::equal(mine.begin(), mine.end(), expected.begin(), expected.end());
+}
+
+/// A record with a key and a payload.
+struct Record {
+  std::uint32_t key;   //!< Sort key.
+  std::uint32_t order; //!< Position before sorting.
+};
+} // namespace
+
+void run_sort_tests(void) {
+  TestManager tm{"Sort testing"};
+
+#if RADIX_KEYS
+  {
+    BEGIN_TEST(tm, "RadixKeys", "radix sort agrees with std::sort");
+
+    EXPECT_TRUE(sorts_like_std(random_values<std::uint32_t>(10'000, 1)));
+    EXPECT_TRUE(sorts_like_std(random_values<std::uint64_t>(10'000, 2)));
+    EXPECT_TRUE(sorts_like_std(random_values<std::int32_t>(10'000, 3)));
+    EXPECT_TRUE(sorts_like_std(random_values<std::int8_t>(10'000, 4)));
+    EXPECT_TRUE(sorts_like_std(random_values<float>(10'000, 5)));
+    EXPECT_TRUE(sorts_like_std(random_values<double>(10'000, 6)));
+    EXPECT_TRUE(sorts_like_std(random_values<std::int64_t>(100, 7)));
+
+    // Extremes of both signs, and keys that only differ in one byte.
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    sc::vector<float> floats{3.5f, -inf, -0.5f, 0.0f, inf, -1e30f, 1e-30f, -2.0f};
+    for (int i{0}; i < 300; ++i)
+      floats.push_back(float(i % 7) - 3.0f);
+    EXPECT_TRUE(sorts_like_std(floats));
+    sc::vector<std::uint64_t> one_byte;
+    for (std::uint64_t i{0}; i < 1000; ++i)
+      one_byte.push_back((i * 37 % 256) << 40);
+    EXPECT_TRUE(sorts_like_std(one_byte));
+
+    // With room for a copy, the spare capacity is the scratch space.
+    sc::vector<std::uint32_t> vec = random_values<std::uint32_t>(5'000, 8);
+    vec.reserve(2 * vec.size());
+    auto *storage = vec.data();
+    auto capacity = vec.capacity();
+    sc::sort(vec);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+    EXPECT_EQ(vec.data(), storage);
+    EXPECT_EQ(vec.capacity(), capacity);
+  }
+#endif
+
+#if PDQSORT_SHAPES
+  {
+    BEGIN_TEST(tm, "PdqsortShapes", "pdqsort on every input shape");
+
+    constexpr int n{20'000};
+    std::mt19937 gen{9};
+    std::vector<std::vector<int>> shapes(6);
+    for (int i{0}; i < n; ++i) {
+      shapes[0].push_back(int(gen()));         // Uniform.
+      shapes[1].push_back(i);                  // Sorted.
+      shapes[2].push_back(n - i);              // Reversed.
+      shapes[3].push_back(int(gen() % 4));     // Many duplicates.
+      shapes[4].push_back(i < n / 2 ? i : n - i); // Organ pipe.
+      shapes[5].push_back(i % 100 == 0 ? int(gen()) : i); // Nearly sorted.
+    }
+    bool all_sorted{true};
+    for (const auto &shape : shapes) {
+      // Strings take the general path with the default order...
+      sc::vector<std::string> words;
+      for (int x : shape)
+        words.push_back(std::to_string(x));
+      all_sorted = all_sorted && sorts_like_std(words);
+      // ...and ints the branchless path, or a custom order.
+      sc::vector<int> ints(shape.begin(), shape.end());
+      sc::sort(ints, std::less<int>{});
+      all_sorted = all_sorted && std::is_sorted(ints.begin(), ints.end());
+      sc::sort(ints, std::greater<>{});
+      all_sorted = all_sorted && std::is_sorted(ints.begin(), ints.end(), std::greater<>{});
+    }
+    EXPECT_TRUE(all_sorted);
+
+    sc::vector<int> tiny{3, 1, 2};
+    sc::sort(tiny, std::less<int>{});
+    EXPECT_EQ(tiny, (sc::vector<int>{1, 2, 3}));
+    sc::vector<std::string> empty;
+    sc::sort(empty);
+    EXPECT_TRUE(empty.empty());
+  }
+#endif
+
+#if SORT_BY_KEY
+  {
+    BEGIN_TEST(tm, "SortByKey", "records sorted stably by one field");
+
+    std::mt19937 gen{10};
+    sc::vector<Record> records;
+    for (std::uint32_t i{0}; i < 50'000; ++i)
+      records.push_back(Record{std::uint32_t(gen() % 1000), i});
+    sc::sort_by_key(records, [](const Record &r) { return r.key; });
+    bool stable{true};
+    for (std::size_t i{1}; i < records.size(); ++i) {
+      const Record &a = records[i - 1];
+      const Record &b = records[i];
+      stable = stable && (a.key < b.key || (a.key == b.key && a.order < b.order));
+    }
+    EXPECT_TRUE(stable);
+
+    // Elements that cannot be copied as bytes are moved, once.
+    sc::vector<std::string> names{"delta", "alpha", "echo", "bravo", "charlie"};
+    sc::vector<std::string> by_length{names};
+    sc::sort_by_key(by_length, [](const std::string &s) { return -int(s.size()); });
+    EXPECT_EQ(by_length, (sc::vector<std::string>{"charlie", "delta", "alpha", "bravo", "echo"}));
+  }
+#endif
+
+#if PARALLEL_SORT
+  {
+    BEGIN_TEST(tm, "ParallelSort", "parallel sort matches the sequential one");
+
+    sc::parallel::thread_pool pool{4, 512};
+    bool same{true};
+    auto u64 = random_values<std::uint64_t>(100'003, 11);
+    auto expected = u64;
+    sc::sort(expected);
+    sc::parallel::sort(pool, u64);
+    same = same && u64 == expected;
+
+    auto doubles = random_values<double>(100'003, 12);
+    auto sorted_doubles = doubles;
+    sc::sort(sorted_doubles);
+    sc::parallel::sort(pool, doubles);
+    same = same && doubles == sorted_doubles;
+
+    // Duplicates in a wide type: most passes are skipped.
+    sc::vector<std::int64_t> dups;
+    for (int i{0}; i < 30'000; ++i)
+      dups.push_back((i * 7919) % 5 - 2);
+    sc::parallel::sort(pool, dups);
+    same = same && std::is_sorted(dups.begin(), dups.end());
+
+    sc::vector<std::string> words;
+    for (int i{0}; i < 20'000; ++i)
+      words.push_back(std::to_string(i * 7919 % 20'000));
+    auto sorted_words = words;
+    sc::sort(sorted_words);
+    sc::parallel::sort(pool, words);
+    same = same && words == sorted_words;
+    sc::parallel::sort(pool, words, std::greater<>{});
+    same = same && std::is_sorted(words.begin(), words.end(), std::greater<>{});
+    EXPECT_TRUE(same);
+  }
+#endif
+
+#if FLOAT_KEY_ORDER
+  {
+    BEGIN_TEST(tm, "FloatKeyOrder", "-0.0 before +0.0, NaNs at the ends");
+
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    sc::parallel::thread_pool pool{4, 512};
+    bool ordered{true};
+    // Below and above the radix threshold, sequentially and in parallel.
+    for (std::size_t n : {std::size_t{8}, std::size_t{4096}}) {
+      for (bool parallel : {false, true}) {
+        auto sort = [&](sc::vector<double> &vec) {
+          parallel ? sc::parallel::sort(pool, vec) : sc::sort(vec);
+        };
+        // Already sorted by `<`, but not in key order.
+        sc::vector<double> zeros;
+        for (std::size_t i{0}; i + 1 < n; ++i)
+          zeros.push_back(0.0);
+        zeros.push_back(-0.0);
+        sort(zeros);
+        ordered = ordered && std::signbit(zeros[0]);
+        for (std::size_t i{1}; i < n; ++i)
+          ordered = ordered && !std::signbit(zeros[i]);
+
+        sc::vector<double> nans;
+        for (std::size_t i{0}; i < n; ++i)
+          nans.push_back(double(i % 5));
+        nans[n / 2] = nan;
+        nans[n / 3] = -nan;
+        sort(nans);
+        ordered = ordered && std::isnan(nans[0]) && std::signbit(nans[0]);
+        ordered = ordered && std::isnan(nans[n - 1]) && !std::signbit(nans[n - 1]);
+        ordered = ordered && std::is_sorted(nans.begin() + 1, nans.end() - 1);
+      }
+    }
+    EXPECT_TRUE(ordered);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,33 @@
+#ifndef _SPAN_H_
+#define _SPAN_H_
+
+#include <cstddef> // std::size_t
+
+/// Sequence container namespace.
+namespace sc {
+/// A view over `size()` contiguous elements, like C++20's `std::span`.
+template <typename T> class span {
+public:
+  using size_type = std::size_t; //!< The size type.
+  using pointer = T *;           //!< Pointer to an element.
+  using reference = T &;         //!< Reference to an element.
+  using iterator = T *;          //!< The elements are contiguous.
+
+  constexpr span(void) noexcept = default;
+  constexpr span(pointer data_, size_type size_) noexcept
+      : m_data{data_}, m_size{size_} {}
+
+  constexpr pointer data(void) const noexcept { return m_data; }
+  constexpr size_type size(void) const noexcept { return m_size; }
+  constexpr bool empty(void) const noexcept { return m_size == 0; }
+  constexpr iterator begin(void) const noexcept { return m_data; }
+  constexpr iterator end(void) const noexcept { return m_data + m_size; }
+  constexpr reference operator[](size_type idx_) const { return m_data[idx_]; }
+
+private:
+  pointer m_data{nullptr}; //!< First element.
+  size_type m_size{0};     //!< Number of elements.
+};
+} // namespace sc
+
+#endif
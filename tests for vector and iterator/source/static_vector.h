@@ -0,0 +1,481 @@
+#ifndef _STATIC_VECTOR_H_
+#define _STATIC_VECTOR_H_
+
+#include <cstddef>          // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <iterator>         // std::distance
+#include <new>              // placement new, std::launder
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <type_traits>      // std::is_trivial
+#include <utility>          // std::move, std::forward
+
+#include "vector.h" // sc::MyForwardIterator
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+/// Inline slots for a `static_vector`, plus how many of them are in use.
+/*!
+ * Trivial types are kept in a plain array, so every special member stays
+ * trivial and the whole container can be used in constant expressions.
+ * C++17 requires such an array to be initialized, so it starts zeroed.
+ */
+template <typename T, std::size_t N, bool Trivial = std::is_trivial<T>::value>
+class static_storage {
+protected:
+  constexpr static_storage(void) noexcept : m_data{}, m_end{0} {}
+
+  constexpr T *slots(void) noexcept { return m_data; }
+  constexpr const T *slots(void) const noexcept { return m_data; }
+
+  /// Builds an element in slot `idx`.
+  template <typename... Args>
+  constexpr void build(std::size_t idx, Args &&...args) {
+    if constexpr (std::is_constructible<T, Args...>::value) {
+      m_data[idx] = T(std::forward<Args>(args)...);
+    } else {
+      m_data[idx] = T{std::forward<Args>(args)...};
+    }
+  }
+  /// Trivial types need no destruction.
+  constexpr void unbuild(std::size_t, std::size_t) noexcept {}
+
+  T m_data[N > 0 ? N : 1]; //!< The slots.
+  std::size_t m_end;       //!< How many slots hold an element.
+};
+
+/// Other types live in raw memory, built and destroyed one by one.
+template <typename T, std::size_t N> class static_storage<T, N, false> {
+protected:
+  static_storage(void) noexcept : m_end{0} {}
+  static_storage(const static_storage &other) : m_end{0} {
+    append(other.slots(), other.slots() + other.m_end);
+  }
+  static_storage(static_storage &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : m_end{0} {
+    append(std::make_move_iterator(other.slots()),
+           std::make_move_iterator(other.slots() + other.m_end));
+  }
+  static_storage &operator=(const static_storage &other) {
+    if (this != &other) {
+      assign_from(other.slots(), other.m_end);
+    }
+    return *this;
+  }
+  static_storage &operator=(static_storage &&other) noexcept(
+      std::is_nothrow_move_assignable<T>::value &&
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      assign_from(std::make_move_iterator(other.slots()), other.m_end);
+    }
+    return *this;
+  }
+  ~static_storage(void) { unbuild(0, m_end); }
+
+  T *slots(void) noexcept {
+    return std::launder(reinterpret_cast<T *>(m_buffer));
+  }
+  const T *slots(void) const noexcept {
+    return std::launder(reinterpret_cast<const T *>(m_buffer));
+  }
+
+  /// Builds an element in the raw slot `idx`.
+  template <typename... Args> void build(std::size_t idx, Args &&...args) {
+    ::new (static_cast<void *>(reinterpret_cast<T *>(m_buffer) + idx))
+        T(std::forward<Args>(args)...);
+  }
+  /// Destroys the elements in slots [`first_`, `last_`).
+  void unbuild(std::size_t first_, std::size_t last_) noexcept {
+    for (; first_ != last_; ++first_) {
+      slots()[first_].~T();
+    }
+  }
+
+  std::size_t m_end; //!< How many slots hold an element.
+
+private:
+  /// Appends [`first_`, `last_`), undoing the work if a copy throws.
+  template <typename InputItr> void append(InputItr first_, InputItr last_) {
+    try {
+      for (; first_ != last_; ++first_, ++m_end) {
+        build(m_end, *first_);
+      }
+    } catch (...) {
+      unbuild(0, m_end);
+      throw;
+    }
+  }
+  /// Overwrites our elements with the `count_` ones at `src_`.
+  template <typename InputItr> void assign_from(InputItr src_, std::size_t count_) {
+    std::size_t i{0};
+    for (; i < count_ && i < m_end; ++i, ++src_) {
+      slots()[i] = *src_;
+    }
+    for (; i < count_; ++i, ++src_) {
+      build(i, *src_);
+      ++m_end;
+    }
+    unbuild(count_, m_end);
+    m_end = count_;
+  }
+
+  alignas(T) unsigned char m_buffer[(N > 0 ? N : 1) * sizeof(T)]; //!< Raw slots.
+};
+} // namespace detail
+
+/// A vector with a fixed capacity of `N` elements, kept inline.
+/*!
+ * sc::static_vector never allocates: the elements live inside the object,
+ * so it can sit on the stack or inside another object at no extra cost.
+ * It offers the modifiers and accessors of `sc::vector`, with the same
+ * iterators, but its capacity never changes.
+ *
+ * Overflow policy: any operation that would take the size past `N` throws
+ * `std::length_error` before touching the container, which is left as it
+ * was.
+ *
+ * For trivial `T` every member is `constexpr`, so a static_vector can be
+ * filled at compile time to build lookup tables.
+ *
+ * \tparam T The type of the elements.
+ * \tparam N The capacity.
+ */
+template <typename T, std::size_t N>
+class static_vector : private detail::static_storage<T, N> {
+  using storage = detail::static_storage<T, N>;
+  using storage::build;
+  using storage::m_end;
+  using storage::slots;
+  using storage::unbuild;
+
+  //=== Aliases
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+
+  using iterator = MyForwardIterator<value_type>; //!< The iterator.
+  using const_iterator =
+      MyForwardIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  constexpr static_vector(void) noexcept = default;
+  /// `count_` value-initialized elements.
+  constexpr explicit static_vector(size_type count_) {
+    check_room(count_);
+    for (; m_end < count_; ++m_end) {
+      build(m_end);
+    }
+  }
+  constexpr static_vector(size_type count_, const_reference value_) {
+    assign(count_, value_);
+  }
+  constexpr static_vector(const std::initializer_list<T> &il) {
+    assign(il.begin(), il.end());
+  }
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  constexpr static_vector(InputItr first, InputItr last) {
+    assign(first, last);
+  }
+
+  //=== [II] ITERATORS
+  constexpr iterator begin(void) { return iterator{slots()}; }
+  constexpr iterator end(void) { return iterator{slots() + m_end}; }
+  constexpr const_iterator begin(void) const { return cbegin(); }
+  constexpr const_iterator end(void) const { return cend(); }
+  constexpr const_iterator cbegin(void) const {
+    return const_iterator{slots()};
+  }
+  constexpr const_iterator cend(void) const {
+    return const_iterator{slots() + m_end};
+  }
+
+  // [III] Capacity
+  constexpr size_type size(void) const { return m_end; }
+  static constexpr size_type capacity(void) { return N; }
+  static constexpr size_type max_size(void) { return N; }
+  constexpr bool empty(void) const { return m_end == 0; }
+  constexpr bool full(void) const { return m_end == N; }
+
+  // [IV] Modifiers
+  constexpr void clear(void) {
+    unbuild(0, m_end);
+    m_end = 0;
+  }
+  constexpr void push_back(const_reference value) { emplace_back(value); }
+  constexpr void push_back(value_type &&value) {
+    emplace_back(std::move(value));
+  }
+  /// Constructs a new element at the end from `args`.
+  template <typename... Args> constexpr reference emplace_back(Args &&...args) {
+    check_room(m_end + 1);
+    build(m_end, std::forward<Args>(args)...);
+    return slots()[m_end++];
+  }
+  constexpr void pop_back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    --m_end;
+    unbuild(m_end, m_end + 1);
+  }
+
+  constexpr iterator insert(iterator pos_, const_reference value_) {
+    return emplace_at(index_of(pos_), value_);
+  }
+  constexpr iterator insert(const_iterator pos_, const_reference value_) {
+    return emplace_at(index_of(pos_), value_);
+  }
+  constexpr iterator insert(iterator pos_, value_type &&value_) {
+    return emplace_at(index_of(pos_), std::move(value_));
+  }
+  constexpr iterator insert(const_iterator pos_, value_type &&value_) {
+    return emplace_at(index_of(pos_), std::move(value_));
+  }
+  /// Constructs a new element from `args` right before `pos_`.
+  template <typename... Args>
+  constexpr iterator emplace(iterator pos_, Args &&...args) {
+    return emplace_at(index_of(pos_), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos_, Args &&...args) {
+    return emplace_at(index_of(pos_), std::forward<Args>(args)...);
+  }
+  template <typename InputItr>
+  constexpr iterator insert(iterator pos_, InputItr first_, InputItr last_) {
+    return insert_range(index_of(pos_), first_, last_);
+  }
+  template <typename InputItr>
+  constexpr iterator insert(const_iterator pos_, InputItr first_, InputItr last_) {
+    return insert_range(index_of(pos_), first_, last_);
+  }
+  constexpr iterator insert(iterator pos_,
+                            const std::initializer_list<value_type> &ilist_) {
+    return insert_range(index_of(pos_), ilist_.begin(), ilist_.end());
+  }
+  constexpr iterator insert(const_iterator pos_,
+                            const std::initializer_list<value_type> &ilist_) {
+    return insert_range(index_of(pos_), ilist_.begin(), ilist_.end());
+  }
+
+  constexpr void assign(size_type count_, const_reference value_) {
+    check_room(count_);
+    size_type i{0};
+    for (; i < count_ && i < m_end; ++i) {
+      slots()[i] = value_;
+    }
+    for (; i < count_; ++i) {
+      build(i, value_);
+      ++m_end;
+    }
+    unbuild(count_, m_end);
+    m_end = count_;
+  }
+  constexpr void assign(const std::initializer_list<T> &ilist) {
+    assign(ilist.begin(), ilist.end());
+  }
+  template <typename InputItr> constexpr void assign(InputItr first, InputItr last) {
+    size_type count_ = std::distance(first, last);
+    check_room(count_);
+    size_type i{0};
+    for (; i < count_ && i < m_end; ++i, ++first) {
+      slots()[i] = *first;
+    }
+    for (; i < count_; ++i, ++first) {
+      build(i, *first);
+      ++m_end;
+    }
+    unbuild(count_, m_end);
+    m_end = count_;
+  }
+
+  constexpr iterator erase(iterator first, iterator last) {
+    return erase_range(index_of(first), index_of(last));
+  }
+  constexpr iterator erase(const_iterator first, const_iterator last) {
+    return erase_range(index_of(first), index_of(last));
+  }
+  constexpr iterator erase(iterator pos) {
+    return erase_range(index_of(pos), index_of(pos) + 1);
+  }
+  constexpr iterator erase(const_iterator pos) {
+    return erase_range(index_of(pos), index_of(pos) + 1);
+  }
+
+
+  // [V] Element access
+  constexpr reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return slots()[0];
+  }
+  constexpr const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return slots()[0];
+  }
+  constexpr reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return slots()[m_end - 1];
+  }
+  constexpr const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return slots()[m_end - 1];
+  }
+  constexpr reference operator[](size_type idx) { return slots()[idx]; }
+  constexpr const_reference operator[](size_type idx) const {
+    return slots()[idx];
+  }
+  constexpr reference at(size_type idx) {
+    if (idx >= m_end) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return slots()[idx];
+  }
+  constexpr const_reference at(size_type idx) const {
+    if (idx >= m_end) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return slots()[idx];
+  }
+  constexpr pointer data(void) { return slots(); }
+  constexpr const T *data(void) const { return slots(); }
+
+  // [VII] Friend functions.
+  friend std::ostream &operator<<(std::ostream &os_, const static_vector &v_) {
+    os_ << "{ ";
+    for (size_type i{0}; i < v_.m_end; ++i) {
+      os_ << v_.slots()[i] << " ";
+    }
+    os_ << "| }, m_end=" << v_.m_end << ", m_capacity=" << N;
+    return os_;
+  }
+  friend constexpr void swap(static_vector &first_, static_vector &second_) {
+    static_vector &longer = (first_.m_end < second_.m_end) ? second_ : first_;
+    static_vector &shorter = (first_.m_end < second_.m_end) ? first_ : second_;
+    size_type common = shorter.m_end;
+    for (size_type i{0}; i < common; ++i) {
+      T temp(std::move(first_.slots()[i]));
+      first_.slots()[i] = std::move(second_.slots()[i]);
+      second_.slots()[i] = std::move(temp);
+    }
+    for (size_type i{common}; i < longer.m_end; ++i) {
+      shorter.build(i, std::move(longer.slots()[i]));
+      ++shorter.m_end;
+    }
+    longer.unbuild(common, longer.m_end);
+    longer.m_end = common;
+  }
+
+private:
+  /// Throws if `count_` elements would not fit.
+  constexpr void check_room(size_type count_) const {
+    if (count_ > N) {
+      throw std::length_error("static_vector está cheio!");
+    }
+  }
+  /// Index of `pos_`, which must lie in [begin, end].
+  template <typename Itr> constexpr size_type index_of(Itr pos_) {
+    auto distance = pos_ - Itr{slots()};
+    if (distance < 0 || size_type(distance) > m_end) {
+      throw std::length_error("Não existe essa posição no vector");
+    }
+    return size_type(distance);
+  }
+
+  /// Inserts a new element built from `args` at index `distance`.
+  template <typename... Args>
+  constexpr iterator emplace_at(size_type distance, Args &&...args) {
+    // Built at the end first, so `args` may refer to our own elements.
+    emplace_back(std::forward<Args>(args)...);
+    if (distance + 1 < m_end) {
+      T value(std::move(slots()[m_end - 1]));
+      for (size_type i{m_end - 1}; i > distance; --i) {
+        slots()[i] = std::move(slots()[i - 1]);
+      }
+      slots()[distance] = std::move(value);
+    }
+    return iterator{slots() + distance};
+  }
+
+  /// Inserts the range [`first_`, `last_`) at index `distance`.
+  template <typename InputItr>
+  constexpr iterator insert_range(size_type distance, InputItr first_,
+                                  InputItr last_) {
+    size_type old_end = m_end;
+    check_room(m_end + size_type(std::distance(first_, last_)));
+    // Appending never moves what is already there, so the range may come
+    // from our own elements. It is then rotated into place.
+    for (; first_ != last_; ++first_, ++m_end) {
+      build(m_end, *first_);
+    }
+    reverse(distance, old_end);
+    reverse(old_end, m_end);
+    reverse(distance, m_end);
+    return iterator{slots() + distance};
+  }
+
+  /// Removes the elements in [`first_`, `last_`), shifting the tail down.
+  constexpr iterator erase_range(size_type first_, size_type last_) {
+    if (first_ > last_ || last_ > m_end) {
+      throw std::length_error("Não existe esse intervalo no vector");
+    }
+    size_type lenght = last_ - first_;
+    if (lenght == 0) {
+      // Nothing to remove; sliding the tail onto itself would self-move.
+      return iterator{slots() + first_};
+    }
+    for (size_type i{first_}; i + lenght < m_end; ++i) {
+      slots()[i] = std::move(slots()[i + lenght]);
+    }
+    unbuild(m_end - lenght, m_end);
+    m_end -= lenght;
+    return iterator{slots() + first_};
+  }
+  /// Reverses the elements in slots [`first_`, `last_`).
+  constexpr void reverse(size_type first_, size_type last_) {
+    while (first_ + 1 < last_) {
+      --last_;
+      T temp(std::move(slots()[first_]));
+      slots()[first_] = std::move(slots()[last_]);
+      slots()[last_] = std::move(temp);
+      ++first_;
+    }
+  }
+};
+
+// [VI] Operators
+template <typename T, std::size_t N>
+constexpr bool operator==(const static_vector<T, N> &vector1,
+                          const static_vector<T, N> &vector2) {
+  if (vector1.size() != vector2.size()) {
+    return false;
+  }
+  for (typename static_vector<T, N>::size_type i{0}; i < vector1.size(); ++i) {
+    if (!(vector1[i] == vector2[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+template <typename T, std::size_t N>
+constexpr bool operator!=(const static_vector<T, N> &vector1,
+                          const static_vector<T, N> &vector2) {
+  return !(vector1 == vector2);
+}
+} // namespace sc.
+
+#endif
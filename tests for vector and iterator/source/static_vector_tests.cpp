@@ -0,0 +1,185 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "static_vector.h"
+#include "test_helpers.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Seventh batch of tests, focused on sc::static_vector
+// =============================================================
+
+// A static_vector of a trivial type can be filled at compile time.
+#define CONSTEXPR_TABLE YES
+// Same modifiers and accessors as sc::vector.
+#define STATIC_MODIFIERS YES
+// Going past the capacity throws and leaves the container untouched.
+#define OVERFLOW_POLICY YES
+// Non-trivial elements are built and destroyed exactly once.
+#define STATIC_LIFETIME YES
+
+namespace {
+/// Squares of 0..N-1, built at compile time.
+template <std::size_t N> constexpr sc::static_vector<int, N> squares(void) {
+  sc::static_vector<int, N> table;
+  for (int i{0}; i < int(N); ++i)
+    table.push_back(i * i);
+  return table;
+}
+
+/// Exercises insert/erase in a constant expression.
+constexpr int edited_sum(void) {
+  sc::static_vector<int, 8> vec{1, 2, 3};
+  vec.insert(vec.begin(), 10);
+  vec.insert(vec.begin() + 2, {20, 30});
+  vec.erase(vec.begin() + 1);
+  vec.pop_back();
+  int sum{0};
+  for (int v : vec)
+    sum += v;
+  return sum * 100 + int(vec.size()); // {10, 20, 30, 2}
+}
+
+using test_helpers::Counted;
+} // namespace
+
+void run_static_vector_tests(void) {
+  TestManager tm{"Static vector testing"};
+
+#if CONSTEXPR_TABLE
+  {
+    BEGIN_TEST(tm, "ConstexprTable", "static_vector<int, N> in constexpr");
+
+    constexpr auto table = squares<16>();
+    static_assert(table.size() == 16, "built at compile time");
+    static_assert(table[15] == 225, "built at compile time");
+    static_assert(edited_sum() == 6204, "edited at compile time");
+    static_assert(std::is_trivially_copyable<sc::static_vector<int, 4>>::value,
+                  "trivial elements keep the container trivial");
+
+    EXPECT_EQ(table.front(), 0);
+    EXPECT_EQ(table.back(), 225);
+    EXPECT_EQ(table.at(3), 9);
+    EXPECT_EQ(edited_sum(), 6204);
+  }
+#endif
+
+#if STATIC_MODIFIERS
+  {
+    BEGIN_TEST(tm, "StaticModifiers", "push_back/insert/erase/assign");
+
+    sc::static_vector<std::string, 10> vec{"a", "b", "c"};
+    vec.push_back("d");
+    vec.emplace_back(2, 'e');
+    vec.insert(vec.begin() + 1, "x");
+    vec.insert(vec.begin(), vec.begin() + 3, vec.begin() + 5);
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 10>{"c", "d", "a", "x", "b",
+                                                        "c", "d", "ee"}));
+    vec.erase(vec.begin(), vec.begin() + 2);
+    vec.erase(vec.begin() + 1);
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 10>{"a", "b", "c", "d", "ee"}));
+    // An empty range removes nothing and leaves the tail alone.
+    vec.erase(vec.begin() + 2, vec.begin() + 2);
+    EXPECT_EQ(vec, (sc::static_vector<std::string, 10>{"a", "b", "c", "d", "ee"}));
+    EXPECT_EQ(vec.front(), "a");
+    EXPECT_EQ(vec.back(), "ee");
+    EXPECT_EQ(vec.at(2), "c");
+
+    vec.assign(3, "z");
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[2], "z");
+    vec.assign({"1", "2", "3", "4", "5", "6"});
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_EQ(vec.capacity(), 10);
+
+    sc::static_vector<std::string, 10> other{"q"};
+    swap(vec, other);
+    EXPECT_EQ(vec.size(), 1);
+    EXPECT_EQ(other[5], "6");
+
+    // No heap: the elements are inside the object.
+    auto *first = reinterpret_cast<const char *>(&other);
+    auto *data = reinterpret_cast<const char *>(other.data());
+    EXPECT_TRUE(data >= first && data < first + sizeof(other));
+  }
+#endif
+
+#if OVERFLOW_POLICY
+  {
+    BEGIN_TEST(tm, "OverflowPolicy", "std::length_error past the capacity");
+
+    sc::static_vector<int, 4> vec{1, 2, 3, 4};
+    EXPECT_TRUE(vec.full());
+
+    bool thrown{false};
+    try {
+      vec.push_back(5);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    thrown = false;
+    try {
+      vec.insert(vec.begin(), {7, 8});
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(vec, (sc::static_vector<int, 4>{1, 2, 3, 4}));
+
+    thrown = false;
+    try {
+      sc::static_vector<int, 4> big(5, 0);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    thrown = false;
+    try {
+      vec.at(4);
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+#if STATIC_LIFETIME
+  {
+    BEGIN_TEST(tm, "StaticLifetime", "ctor/dtor calls are balanced");
+
+    {
+      sc::static_vector<Counted, 8> vec;
+      vec.emplace_back("a long string that does not fit inline");
+      vec.emplace_back("b");
+      vec.insert(vec.begin(), Counted{"c"});
+      EXPECT_EQ(Counted::alive, 3);
+
+      sc::static_vector<Counted, 8> copy{vec};
+      sc::static_vector<Counted, 8> moved{std::move(copy)};
+      EXPECT_EQ(Counted::alive, 9);
+      EXPECT_EQ(moved, vec);
+
+      copy = vec;
+      vec.erase(vec.begin(), vec.end());
+      EXPECT_EQ(Counted::alive, 6);
+      vec = std::move(moved);
+      EXPECT_EQ(vec[1].value, "a long string that does not fit inline");
+      swap(vec, copy);
+      vec.pop_back();
+      EXPECT_EQ(vec.size(), 2);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,393 @@
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "test_helpers.h"
+#include "tm/test_manager.h"
+#include "vector.h"
+
+#define which_lib sc
+// To run tests with the STL's vector, uncomment the line below.
+// #define which_lib std
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Fourth batch of tests, focused on how the storage is managed
+// =============================================================
+
+// Elements without a default ctro can be stored.
+#define NON_DEFAULT_CTRO YES
+// reserve() must not construct any element in the spare capacity.
+#define RESERVE_NO_CONSTRUCT YES
+// Every element constructed is destroyed exactly once.
+#define BALANCED_LIFETIME YES
+// Types that opt into relocation are moved around bytewise.
+#define RELOCATION_TRAIT YES
+// insert()/erase() never reallocate when the capacity suffices.
+#define IN_PLACE_EDITS YES
+// Growth follows the GrowthPolicy template argument.
+#define GROWTH_POLICY YES
+// push_front()/pop_front() use spare room kept before the first element.
+#define FRONT_SLACK YES
+
+namespace {
+/// Counts how many objects are alive, to catch leaks and double destruction.
+struct Tracked {
+  static int alive; //!< Number of live objects.
+  int value;        //!< Payload.
+
+  explicit Tracked(int v) : value{v} { ++alive; }
+  Tracked(const Tracked &other) : value{other.value} { ++alive; }
+  Tracked(Tracked &&other) noexcept : value{other.value} { ++alive; }
+  Tracked &operator=(const Tracked &) = default;
+  Tracked &operator=(Tracked &&) = default;
+  ~Tracked() { --alive; }
+};
+int Tracked::alive{0};
+
+/// A Tracked whose copy ctor throws once `budget` copies have been made.
+/// Its move ctor may throw too, so the vector has to copy it around.
+struct Fragile : Tracked {
+  static int budget; //!< Copies left before the next one throws.
+
+  explicit Fragile(int v) : Tracked{v} {}
+  Fragile(const Fragile &other) : Tracked{(spend(), other)} {}
+  Fragile(Fragile &&other) : Fragile{static_cast<const Fragile &>(other)} {}
+  Fragile &operator=(const Fragile &) = default;
+  Fragile &operator=(Fragile &&) = default;
+  static void spend(void) {
+    if (budget-- == 0)
+      throw std::runtime_error("out of copies");
+  }
+};
+int Fragile::budget{0};
+
+/// Counts its copies and moves; relocation must not trigger either.
+struct Relocated {
+  static int transfers; //!< Number of copy/move constructions.
+  int value;            //!< Payload.
+
+  explicit Relocated(int v) : value{v} {}
+  Relocated(const Relocated &other) : value{other.value} { ++transfers; }
+  Relocated(Relocated &&other) noexcept : value{other.value} { ++transfers; }
+  Relocated &operator=(const Relocated &) = default;
+  Relocated &operator=(Relocated &&) = default;
+};
+int Relocated::transfers{0};
+} // namespace
+
+namespace sc {
+template <> struct is_trivially_relocatable<Relocated> : std::true_type {};
+} // namespace sc
+
+void run_storage_tests(void) {
+  TestManager tm{"Storage testing"};
+
+#if NON_DEFAULT_CTRO
+  {
+    BEGIN_TEST(tm, "NonDefaultCtro", "vector<T> with no T()");
+
+    which_lib::vector<Tracked> vec;
+    for (int i{0}; i < 10; ++i)
+      vec.emplace_back(i);
+    vec.insert(vec.begin() + 5, Tracked{100});
+    vec.erase(vec.begin());
+
+    EXPECT_EQ(vec.size(), 10);
+    EXPECT_EQ(vec[4].value, 100);
+    EXPECT_EQ(vec.back().value, 9);
+  }
+#endif
+
+#if RESERVE_NO_CONSTRUCT
+  {
+    BEGIN_TEST(tm, "ReserveNoConstruct", "vec.reserve(n) builds nothing");
+
+    which_lib::vector<Tracked> vec;
+    vec.reserve(1000);
+    EXPECT_EQ(vec.capacity(), 1000);
+    EXPECT_EQ(Tracked::alive, 0);
+
+    vec.emplace_back(1);
+    vec.emplace_back(2);
+    EXPECT_EQ(Tracked::alive, 2);
+  }
+#endif
+
+#if BALANCED_LIFETIME
+  {
+    BEGIN_TEST(tm, "BalancedLifetime", "ctor/dtor calls are balanced");
+
+    {
+      which_lib::vector<Tracked> vec;
+      for (int i{0}; i < 100; ++i)
+        vec.emplace_back(i);
+      vec.pop_back();
+      EXPECT_EQ(Tracked::alive, 99);
+      vec.shrink_to_fit();
+      EXPECT_EQ(Tracked::alive, 99);
+      vec.assign(10, Tracked{7});
+      EXPECT_EQ(Tracked::alive, 10);
+      which_lib::vector<Tracked> copy{vec};
+      EXPECT_EQ(Tracked::alive, 20);
+      vec.clear();
+      EXPECT_EQ(Tracked::alive, 10);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+
+    // Strings hold heap memory of their own, so a leak shows up under ASan.
+    which_lib::vector<std::string> words;
+    for (int i{0}; i < 50; ++i)
+      words.push_back(std::string(40, char('a' + i % 26)));
+    words.insert(words.begin(), std::string(40, 'z'));
+    words.erase(words.begin() + 10);
+    EXPECT_EQ(words.size(), 50);
+    EXPECT_EQ(words.front(), std::string(40, 'z'));
+
+    // A copy that throws halfway through growth leaves the vector intact.
+    {
+      which_lib::vector<Fragile> vec;
+      vec.reserve(4);
+      for (int i{0}; i < 4; ++i)
+        vec.emplace_back(i);
+      for (int budget : {0, 1, 2, 3}) {
+        Fragile::budget = budget;
+        bool thrown{false};
+        try {
+          vec.emplace(vec.begin() + 2, 99);
+        } catch (const std::runtime_error &) {
+          thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_EQ(vec.size(), 4);
+        EXPECT_EQ(vec.capacity(), 4);
+        EXPECT_EQ(Tracked::alive, 4);
+        EXPECT_EQ(vec[1].value, 1);
+        EXPECT_EQ(vec[2].value, 2);
+      }
+      Fragile extra[2]{Fragile{7}, Fragile{8}};
+      Fragile::budget = 3;
+      bool thrown{false};
+      try {
+        vec.insert(vec.begin() + 1, extra, extra + 2);
+      } catch (const std::runtime_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+      EXPECT_EQ(vec.size(), 4);
+      EXPECT_EQ(Tracked::alive, 6);
+      EXPECT_EQ(vec.back().value, 3);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+#if RELOCATION_TRAIT
+  {
+    BEGIN_TEST(tm, "RelocationTrait", "is_trivially_relocatable<T> opt-in");
+
+    which_lib::vector<Relocated> vec;
+    for (int i{0}; i < 1000; ++i)
+      vec.emplace_back(i);
+    // Growth only moves the element being added, never the old ones.
+    EXPECT_LT(Relocated::transfers, 20);
+
+    Relocated::transfers = 0;
+    vec.erase(vec.begin() + 10);
+    vec.shrink_to_fit();
+    EXPECT_EQ(Relocated::transfers, 0);
+    EXPECT_EQ(vec.size(), 999);
+    EXPECT_EQ(vec[9].value, 9);
+    EXPECT_EQ(vec[10].value, 11);
+    EXPECT_EQ(vec.back().value, 999);
+
+    // Plain arithmetic types take the same path.
+    which_lib::vector<double> nums;
+    for (int i{0}; i < 1000; ++i)
+      nums.push_back(i * 0.5);
+    nums.insert(nums.begin() + 1, nums.begin() + 2, nums.begin() + 4);
+    EXPECT_EQ(nums.size(), 1002);
+    EXPECT_EQ(nums[1], 1.0);
+    EXPECT_EQ(nums[2], 1.5);
+    EXPECT_EQ(nums[3], 0.5);
+    EXPECT_EQ(nums.back(), 499.5);
+
+    // A capacity whose byte count overflows is refused before realloc().
+    which_lib::vector<int> ints{1, 2, 3};
+    bool thrown{false};
+    try {
+      ints.reserve(std::size_t{1} << 62);
+    } catch (const std::length_error &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(ints, (which_lib::vector<int>{1, 2, 3}));
+    EXPECT_EQ(ints.capacity(), 3);
+  }
+#endif
+
+#if IN_PLACE_EDITS
+  {
+    BEGIN_TEST(tm, "InPlaceEdits", "insert/erase within capacity");
+
+    which_lib::vector<std::string> vec{"a", "b", "c", "d"};
+    vec.reserve(20);
+    const auto *storage = vec.data();
+
+    vec.insert(vec.begin() + 1, "x");
+    vec.insert(vec.begin() + 2, {"y", "z"});
+    vec.insert(vec.end() - 1, vec.begin(), vec.begin() + 2);
+    EXPECT_EQ(vec, (which_lib::vector<std::string>{"a", "x", "y", "z", "b",
+                                                   "c", "a", "x", "d"}));
+    vec.erase(vec.begin() + 1, vec.begin() + 4);
+    vec.erase(vec.begin());
+    EXPECT_EQ(vec, (which_lib::vector<std::string>{"b", "c", "a", "x", "d"}));
+    // An empty range removes nothing and leaves the tail alone.
+    vec.erase(vec.begin() + 2, vec.begin() + 2);
+    EXPECT_EQ(vec, (which_lib::vector<std::string>{"b", "c", "a", "x", "d"}));
+    vec.emplace(vec.begin() + 2, 3, 'w');
+    EXPECT_EQ(vec[2], "www");
+    EXPECT_EQ(vec.size(), 6);
+
+    // All edits happened in the original buffer.
+    EXPECT_TRUE(storage == vec.data());
+    EXPECT_EQ(vec.capacity(), 20);
+  }
+#endif
+
+#if GROWTH_POLICY
+  {
+    BEGIN_TEST(tm, "GrowthPolicy", "vector<T, Alloc, GrowthPolicy>");
+
+    // Collects the capacities a vector goes through while growing to `n`.
+    auto steps = [](auto vec, std::size_t n) {
+      std::string out;
+      for (std::size_t i{0}; i < n; ++i) {
+        auto before = vec.capacity();
+        vec.push_back(int(i));
+        if (vec.capacity() != before)
+          out += std::to_string(vec.capacity()) + " ";
+      }
+      return out;
+    };
+    using alloc_t = std::allocator<int>;
+    EXPECT_EQ(steps(sc::vector<int>{}, 20), "1 2 4 8 16 32 ");
+    EXPECT_EQ(steps(sc::vector<int, alloc_t, sc::growth::golden>{}, 20),
+              "1 2 3 4 6 9 13 19 28 ");
+    EXPECT_EQ(steps(sc::vector<int, alloc_t, sc::growth::fixed_step<8>>{}, 20),
+              "8 16 24 ");
+    // 4-byte ints: 16, 24, 40, 64 and 96 bytes are all size classes.
+    EXPECT_EQ(steps(sc::vector<int, alloc_t, sc::growth::size_class>{}, 20),
+              "4 6 10 16 24 ");
+
+    // A range insert grows to at least what it needs.
+    sc::vector<int, alloc_t, sc::growth::golden> vec{1, 2};
+    sc::vector<int> src(10);
+    vec.insert(vec.end(), src.begin(), src.end());
+    EXPECT_EQ(vec.capacity(), 12);
+    EXPECT_EQ(vec.size(), 12);
+  }
+#endif
+
+#if FRONT_SLACK
+  {
+    BEGIN_TEST(tm, "FrontSlack", "push_front/pop_front in amortized O(1)");
+
+    // Few buffers for many push_front()s, and data() stays contiguous.
+    sc::vector<int> nums;
+    int buffers{0};
+    std::uintptr_t last{0};
+    for (int i{0}; i < 1000; ++i) {
+      nums.push_front(i);
+      auto first = reinterpret_cast<std::uintptr_t>(nums.data());
+      if (first != last - sizeof(int))
+        ++buffers;
+      last = first;
+    }
+    EXPECT_LT(buffers, 25);
+    EXPECT_EQ(nums.size(), 1000);
+    EXPECT_EQ(nums.front(), 999);
+    EXPECT_EQ(nums.back(), 0);
+    EXPECT_EQ(nums.data()[500], 499);
+    nums.push_back(-1);
+    nums.pop_front();
+    EXPECT_EQ(nums.front(), 998);
+    EXPECT_EQ(nums.back(), -1);
+    nums.insert(nums.begin() + 1, 7);
+    EXPECT_EQ(nums[1], 7);
+
+    // A queue keeps reusing its buffer.
+    sc::vector<int> queue;
+    queue.reserve(64);
+    const int *buffer = queue.data();
+    for (int i{0}; i < 10'000; ++i) {
+      queue.push_back(i);
+      if (queue.size() > 16)
+        queue.pop_front();
+    }
+    EXPECT_EQ(queue.size(), 16);
+    EXPECT_EQ(queue.front(), 10'000 - 16);
+    EXPECT_TRUE(queue.data() >= buffer && queue.data() < buffer + 64);
+
+    // Elements that must be moved one by one, and must not leak.
+    {
+      sc::vector<Tracked> vec;
+      for (int i{0}; i < 100; ++i) {
+        vec.emplace_front(i);
+        vec.emplace_back(-i);
+      }
+      for (int i{0}; i < 50; ++i)
+        vec.pop_front();
+      EXPECT_EQ(Tracked::alive, 150);
+      EXPECT_EQ(vec.front().value, 49);
+      EXPECT_EQ(vec.back().value, -99);
+      vec.shrink_to_fit();
+      EXPECT_EQ(vec.capacity(), 150);
+      vec.push_front(vec.back());
+      EXPECT_EQ(vec.front().value, -99);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+
+    // Inline storage has front slack too.
+    sc::small_vector<std::string, 8> small;
+    small.push_back("b");
+    small.push_front("a");
+    small.push_front(small.back());
+    EXPECT_EQ(small, (sc::small_vector<std::string, 8>{"b", "a", "b"}));
+    small.pop_front();
+    small.pop_front();
+    small.pop_front();
+    EXPECT_TRUE(small.empty());
+    EXPECT_EQ(small.capacity(), 8);
+
+    // A copy that throws while the buffer grows gives the new block back.
+    {
+      test_helpers::CountingResource memory;
+      sc::pmr::vector<Fragile> fragile{&memory};
+      fragile.reserve(4);
+      for (int i{0}; i < 4; ++i)
+        fragile.emplace_back(i);
+      long held{memory.live};
+      Fragile::budget = 2;
+      bool thrown{false};
+      try {
+        fragile.emplace_front(-1);
+      } catch (const std::runtime_error &) {
+        thrown = true;
+      }
+      EXPECT_TRUE(thrown);
+      EXPECT_EQ(memory.live, held);
+      EXPECT_EQ(fragile.size(), 4);
+      EXPECT_EQ(Tracked::alive, 4);
+      EXPECT_EQ(fragile.front().value, 0);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
@@ -0,0 +1,89 @@
+#ifndef _TEST_HELPERS_H_
+#define _TEST_HELPERS_H_
+
+#include <cstddef>         // std::size_t
+#include <limits>          // std::numeric_limits
+#include <memory_resource> // std::pmr::memory_resource
+#include <new>             // std::bad_alloc
+#include <string>          // std::string
+#include <utility>         // std::move
+
+/// Element types and memory resources shared by the container tests.
+namespace test_helpers {
+/// Counts its copies and moves, and how many objects are alive.
+struct Counted {
+  inline static int alive{0};     //!< Number of live objects.
+  inline static int transfers{0}; //!< Number of copy/move constructions.
+  std::string value;              //!< Payload.
+
+  Counted(std::string v) : value{std::move(v)} { ++alive; }
+  Counted(const Counted &other) : value{other.value} {
+    ++alive;
+    ++transfers;
+  }
+  Counted(Counted &&other) noexcept : value{std::move(other.value)} {
+    ++alive;
+    ++transfers;
+  }
+  Counted &operator=(const Counted &) = default;
+  Counted &operator=(Counted &&) = default;
+  ~Counted() { --alive; }
+  bool operator==(const Counted &other) const { return value == other.value; }
+};
+
+/// A memory resource that counts the bytes it has handed out.
+class CountingResource : public std::pmr::memory_resource {
+public:
+  long live{0}; //!< Bytes handed out and not yet given back.
+  long budget{std::numeric_limits<long>::max()}; //!< Most `live` may reach.
+
+private:
+  void *do_allocate(std::size_t bytes_, std::size_t align_) override {
+    if (long(bytes_) > budget - live) {
+      throw std::bad_alloc{};
+    }
+    live += long(bytes_);
+    return std::pmr::new_delete_resource()->allocate(bytes_, align_);
+  }
+  void do_deallocate(void *ptr_, std::size_t bytes_,
+                     std::size_t align_) override {
+    live -= long(bytes_);
+    std::pmr::new_delete_resource()->deallocate(ptr_, bytes_, align_);
+  }
+  bool do_is_equal(const memory_resource &other_) const noexcept override {
+    return this == &other_;
+  }
+};
+
+/*! Copy-assigns and swaps containers of `int` that use
+ * `std::pmr::polymorphic_allocator`, each on a `CountingResource` of its
+ * own, and tells whether:
+ * - `a = b` keeps `a` on its own resource, and leaves `b`'s memory alone;
+ * - `swap()`, which pmr allocators do not propagate on, trades the
+ *   storage of two containers on the same resource;
+ * - every byte goes back to its resource.
+ */
+template <typename Container> bool pmr_assign_and_swap(void) {
+  CountingResource left, right;
+  bool ok{true};
+  {
+    Container a{&left};
+    Container b{&right};
+    for (int i{0}; i < 1000; ++i) {
+      b.push_back(i);
+    }
+    long held{right.live};
+    a = b;
+    ok = ok && a.get_allocator().resource() == &left && a == b;
+    ok = ok && right.live == held && left.live > 0;
+
+    Container c{&left};
+    c.push_back(7);
+    swap(a, c);
+    ok = ok && a.size() == 1 && a[0] == 7 && c == b;
+  }
+  return ok && left.live == 0 && right.live == 0;
+}
+} // namespace test_helpers
+
+#endif
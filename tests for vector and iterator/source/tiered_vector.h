@@ -0,0 +1,639 @@
+#ifndef _TIERED_VECTOR_H_
+#define _TIERED_VECTOR_H_
+
+#include <algorithm>        // std::equal
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <initializer_list> // std::initializer_list
+#include <iostream>         // std::ostream
+#include <iterator>         // std::random_access_iterator_tag
+#include <memory>           // std::allocator_traits
+#include <stdexcept>        // std::length_error, std::out_of_range
+#include <type_traits>      // std::enable_if_t
+#include <utility>          // std::move, std::forward, std::move_if_noexcept
+
+#include "vector.h" // sc::vector
+
+/// Sequence container namespace.
+namespace sc {
+namespace detail {
+/// One block of a `tiered_vector`: a ring of `size` elements from `head`.
+template <typename T> struct tier {
+  T *slots;         //!< The block's buffer, of the container's block size.
+  std::size_t head; //!< Slot of the block's first element.
+  std::size_t size; //!< Number of elements in the block.
+};
+} // namespace detail
+
+/// Random access iterator over a `tiered_vector`.
+/*!
+ * The iterator holds an index and finds its element the same way
+ * `tiered_vector::operator[]` does. `T` may be const.
+ */
+template <class T> class TieredIterator {
+  using tier = detail::tier<std::remove_cv_t<T>>;
+
+public:
+  using iterator = TieredIterator; //!< Alias to iterator.
+  typedef std::ptrdiff_t difference_type; //!< Distance between iterators.
+  typedef std::remove_cv_t<T> value_type; //!< Value type the iterator points to.
+  typedef T *pointer;                     //!< Pointer to the value type.
+  typedef T &reference;                   //!< Reference to the value type.
+  typedef std::random_access_iterator_tag
+      iterator_category; //!< Iterator category.
+
+  constexpr TieredIterator(void) = default;
+  /*! Iterator to the `idx_`-th element.
+   * \param tiers_ the block directory.
+   * \param shift_ log2 of the block size.
+   */
+  constexpr TieredIterator(const tier *tiers_, std::size_t shift_,
+                           std::size_t idx_)
+      : m_tiers{tiers_}, m_shift{shift_}, m_idx{idx_} {}
+
+  /// Converts an iterator into a const iterator, never the other way.
+  template <class U, typename = std::enable_if_t<
+                         std::is_convertible<U *, T *>::value &&
+                         !std::is_same<U, T>::value>>
+  constexpr TieredIterator(const TieredIterator<U> &other)
+      : m_tiers{other.m_tiers}, m_shift{other.m_shift}, m_idx{other.m_idx} {}
+
+  constexpr reference operator*(void) const { return *slot(m_idx); }
+  constexpr pointer operator->(void) const { return slot(m_idx); }
+  constexpr reference operator[](difference_type offset) const {
+    return *slot(m_idx + offset);
+  }
+
+  constexpr iterator &operator++(void) {
+    ++m_idx;
+    return *this;
+  }
+  constexpr iterator operator++(int) {
+    iterator dummy{*this};
+    ++m_idx;
+    return dummy;
+  }
+  constexpr iterator &operator--(void) {
+    --m_idx;
+    return *this;
+  }
+  constexpr iterator operator--(int) {
+    iterator dummy{*this};
+    --m_idx;
+    return dummy;
+  }
+  constexpr iterator &operator+=(difference_type offset) {
+    m_idx += offset;
+    return *this;
+  }
+  constexpr iterator &operator-=(difference_type offset) {
+    m_idx -= offset;
+    return *this;
+  }
+
+  friend constexpr iterator operator+(difference_type offset, iterator it) {
+    return it += offset;
+  }
+  friend constexpr iterator operator+(iterator it, difference_type offset) {
+    return it += offset;
+  }
+  friend constexpr iterator operator-(iterator it, difference_type offset) {
+    return it -= offset;
+  }
+  friend constexpr difference_type operator-(const iterator &lhs_,
+                                             const iterator &rhs_) {
+    return difference_type(lhs_.m_idx - rhs_.m_idx);
+  }
+
+  // Iterators into the same container compare by index.
+  friend constexpr bool operator==(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx == rhs_.m_idx;
+  }
+  friend constexpr bool operator!=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx != rhs_.m_idx;
+  }
+  friend constexpr bool operator<(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx < rhs_.m_idx;
+  }
+  friend constexpr bool operator>(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx > rhs_.m_idx;
+  }
+  friend constexpr bool operator<=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx <= rhs_.m_idx;
+  }
+  friend constexpr bool operator>=(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_idx >= rhs_.m_idx;
+  }
+
+  /// Index of the element the iterator points to.
+  constexpr std::size_t index(void) const { return m_idx; }
+
+private:
+  constexpr pointer slot(std::size_t idx_) const {
+    const tier &block = m_tiers[idx_ >> m_shift];
+    std::size_t mask = (std::size_t{1} << m_shift) - 1;
+    return block.slots + ((block.head + (idx_ & mask)) & mask);
+  }
+
+  const tier *m_tiers{nullptr}; //!< The block directory.
+  std::size_t m_shift{0};       //!< log2 of the block size.
+  std::size_t m_idx{0};         //!< Index of the element.
+
+  template <class U> friend class TieredIterator;
+};
+
+/// A sequence split into blocks, for inserts and erases anywhere in a
+/// large sequence.
+/*!
+ * Every block has `block_size()` slots, a power of two, and holds its
+ * elements as a ring; all blocks but the last are full. The `i`-th
+ * element is then in block `i / block_size()`, found in O(1) with a shift
+ * and a mask.
+ *
+ * An insert shifts elements only inside its own block, towards whichever
+ * end is closer, and then pushes one element from each later block into
+ * the front of the next one, which is O(1) per block thanks to the
+ * rings. An erase does the opposite; a range erase drops the blocks it
+ * covers whole and carries `count % block_size()` elements per later
+ * block. With blocks of about sqrt(n) slots both cost O(sqrt n), instead
+ * of the O(n) of `sc::vector`. The block size doubles as the sequence
+ * grows past `block_size()^2 / 2`.
+ *
+ * The block directory is an `sc::vector` of `detail::tier`s.
+ */
+template <typename T, typename Alloc = std::allocator<T>> class tiered_vector {
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using tier = detail::tier<T>;
+  using directory =
+      vector<tier, typename alloc_traits::template rebind_alloc<tier>>;
+  /// log2 of the smallest block size.
+  static constexpr std::size_t min_shift{6};
+
+public:
+  using size_type = unsigned long; //!< The size type.
+  using value_type = T;            //!< The value type.
+  using allocator_type = Alloc;    //!< The allocator type.
+  using pointer = value_type *; //!< Pointer to a value stored in the container.
+  using reference =
+      value_type &; //!< Reference to a value stored in the container.
+  using const_reference = const value_type &; //!< Const reference to a value
+                                              //!< stored in the container.
+  using iterator = TieredIterator<value_type>; //!< The iterator.
+  using const_iterator =
+      TieredIterator<const value_type>; //!< The const_iterator.
+
+  //=== [I] SPECIAL MEMBERS
+  tiered_vector(void) = default;
+  explicit tiered_vector(const Alloc &alloc_)
+      : m_alloc{alloc_}, m_tiers{directory_allocator()} {}
+  explicit tiered_vector(size_type count_, const_reference value_ = T(),
+                         const Alloc &alloc_ = Alloc())
+      : tiered_vector(alloc_) {
+    for (size_type i{0}; i < count_; ++i) {
+      push_back(value_);
+    }
+  }
+  tiered_vector(const std::initializer_list<T> &il,
+                const Alloc &alloc_ = Alloc())
+      : tiered_vector(il.begin(), il.end(), alloc_) {}
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  tiered_vector(InputItr first_, InputItr last_, const Alloc &alloc_ = Alloc())
+      : tiered_vector(alloc_) {
+    for (; first_ != last_; ++first_) {
+      push_back(*first_);
+    }
+  }
+  tiered_vector(const tiered_vector &other)
+      : tiered_vector(alloc_traits::select_on_container_copy_construction(
+            other.m_alloc)) {
+    for (const auto &value : other) {
+      push_back(value);
+    }
+  }
+  tiered_vector(tiered_vector &&other) noexcept
+      : m_alloc{std::move(other.m_alloc)}, m_tiers{std::move(other.m_tiers)},
+        m_size{other.m_size}, m_shift{other.m_shift} {
+    other.m_size = 0;
+    other.m_shift = min_shift;
+  }
+  /// Copy assignment: the allocator follows `other` only if it asks to
+  /// propagate on copy. The new blocks come from our allocator either way.
+  tiered_vector &operator=(const tiered_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    // Every block goes back to the allocator that gave it.
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      m_alloc = other.m_alloc;
+      // The empty directory follows, giving its buffer back if it must.
+      const directory empty{directory_allocator()};
+      m_tiers = empty;
+    }
+    for (const auto &value : other) {
+      push_back(value);
+    }
+    return *this;
+  }
+  tiered_vector &operator=(tiered_vector &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        m_alloc == other.m_alloc) {
+      // The blocks change hands.
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        m_alloc = std::move(other.m_alloc);
+      }
+      m_tiers = std::move(other.m_tiers);
+      m_size = other.m_size;
+      m_shift = other.m_shift;
+      other.m_size = 0;
+      other.m_shift = min_shift;
+    } else {
+      for (auto &value : other) {
+        push_back(std::move(value));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+  virtual ~tiered_vector(void) { clear(); }
+
+  allocator_type get_allocator(void) const { return m_alloc; }
+
+  //=== [II] ITERATORS
+  iterator begin(void) { return iterator{m_tiers.data(), m_shift, 0}; }
+  iterator end(void) { return iterator{m_tiers.data(), m_shift, m_size}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
+  const_iterator cbegin(void) const {
+    return const_iterator{m_tiers.data(), m_shift, 0};
+  }
+  const_iterator cend(void) const {
+    return const_iterator{m_tiers.data(), m_shift, m_size};
+  }
+
+  // [III] Capacity
+  size_type size(void) const { return m_size; }
+  bool empty(void) const { return m_size == 0; }
+  /// Slots per block.
+  size_type block_size(void) const { return size_type{1} << m_shift; }
+
+  // [IV] Modifiers
+  void clear(void) {
+    for (auto &block : m_tiers) {
+      for (size_type i{0}; i < block.size; ++i) {
+        destroy(slot(block, i));
+      }
+      alloc_traits::deallocate(m_alloc, block.slots, block_size());
+    }
+    m_tiers.clear();
+    m_size = 0;
+    m_shift = min_shift;
+  }
+  void push_back(const_reference value_) { emplace_back(value_); }
+  void push_back(value_type &&value_) { emplace_back(std::move(value_)); }
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (m_size == 0 || m_tiers.back().size == block_size()) {
+      // Build the value first: `args` may refer to one of our own elements.
+      T value(std::forward<Args>(args)...);
+      make_room();
+      return emplace_back_in(m_tiers.back(), std::move(value));
+    }
+    return emplace_back_in(m_tiers.back(), std::forward<Args>(args)...);
+  }
+  void pop_back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    tier &block = m_tiers.back();
+    destroy(slot(block, --block.size));
+    --m_size;
+    drop_empty_block();
+  }
+
+  iterator insert(const_iterator pos_, const_reference value_) {
+    return emplace_at(pos_.index(), value_);
+  }
+  iterator insert(const_iterator pos_, value_type &&value_) {
+    return emplace_at(pos_.index(), std::move(value_));
+  }
+  template <typename... Args>
+  iterator emplace(const_iterator pos_, Args &&...args) {
+    return emplace_at(pos_.index(), std::forward<Args>(args)...);
+  }
+  /// Inserts `[first_, last_)` before `pos_`, which must not point into it.
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  iterator insert(const_iterator pos_, InputItr first_, InputItr last_) {
+    size_type idx{pos_.index()};
+    for (size_type at{idx}; first_ != last_; ++first_, ++at) {
+      emplace_at(at, *first_);
+    }
+    return make_iterator(idx);
+  }
+  iterator insert(const_iterator pos_, const std::initializer_list<T> &il) {
+    return insert(pos_, il.begin(), il.end());
+  }
+
+  iterator erase(const_iterator pos_) {
+    if (pos_.index() >= m_size) {
+      throw std::out_of_range("Não existe essa posição no vector");
+    }
+    size_type idx{pos_.index()};
+    size_type k{idx >> m_shift};
+    erase_in(m_tiers[k], idx & mask());
+    // Each later block hands its first element to the one before it.
+    for (size_type j{k + 1}; j < m_tiers.size(); ++j) {
+      tier &prev = m_tiers[j - 1];
+      tier &cur = m_tiers[j];
+      pointer first = slot(cur, 0);
+      construct(slot(prev, prev.size), std::move_if_noexcept(*first));
+      destroy(first);
+      ++prev.size;
+      cur.head = (cur.head + 1) & mask();
+      --cur.size;
+    }
+    --m_size;
+    drop_empty_block();
+    return make_iterator(idx);
+  }
+  iterator erase(const_iterator first_, const_iterator last_) {
+    if (first_ > last_ || last_.index() > m_size) {
+      throw std::out_of_range("Não existe esse intervalo no vector");
+    }
+    size_type idx{first_.index()};
+    size_type count{size_type(last_ - first_)};
+    if (count == 0) {
+      return make_iterator(idx);
+    }
+    if (count == 1) {
+      return erase(first_);
+    }
+    size_type k{idx >> m_shift};
+    size_type last_k{(last_.index() - 1) >> m_shift};
+    if (k == last_k) {
+      erase_in(m_tiers[k], idx & mask(), count);
+    } else {
+      // The range ends block `k`, opens block `last_k`, and fills every
+      // block in between, which go away whole.
+      tier &head = m_tiers[k];
+      for (size_type i{idx & mask()}; i < head.size; ++i) {
+        destroy(slot(head, i));
+      }
+      head.size = idx & mask();
+      tier &tail = m_tiers[last_k];
+      size_type cut{((last_.index() - 1) & mask()) + 1};
+      for (size_type i{0}; i < cut; ++i) {
+        destroy(slot(tail, i));
+      }
+      tail.head = (tail.head + cut) & mask();
+      tail.size -= cut;
+      for (size_type j{k + 1}; j < last_k; ++j) {
+        for (size_type i{0}; i < m_tiers[j].size; ++i) {
+          destroy(slot(m_tiers[j], i));
+        }
+        alloc_traits::deallocate(m_alloc, m_tiers[j].slots, block_size());
+      }
+      m_tiers.erase(m_tiers.begin() + k + 1, m_tiers.begin() + last_k);
+    }
+    m_size -= count;
+    refill(k);
+    return make_iterator(idx);
+  }
+
+  // [V] Element access
+  reference operator[](size_type idx_) {
+    return *slot(m_tiers[idx_ >> m_shift], idx_ & mask());
+  }
+  const_reference operator[](size_type idx_) const {
+    const tier &block = m_tiers[idx_ >> m_shift];
+    return block.slots[(block.head + (idx_ & mask())) & mask()];
+  }
+  reference at(size_type idx_) {
+    if (idx_ >= m_size) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  const_reference at(size_type idx_) const {
+    if (idx_ >= m_size) {
+      throw std::out_of_range("não existe essa posição!");
+    }
+    return (*this)[idx_];
+  }
+  reference front(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[0];
+  }
+  const_reference front(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[0];
+  }
+  reference back(void) {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[m_size - 1];
+  }
+  const_reference back(void) const {
+    if (empty()) {
+      throw std::length_error("Vector está vazio!");
+    }
+    return (*this)[m_size - 1];
+  }
+
+  // [VI] Operators
+  friend bool operator==(const tiered_vector &lhs_, const tiered_vector &rhs_) {
+    return lhs_.size() == rhs_.size() &&
+           std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+  }
+  friend bool operator!=(const tiered_vector &lhs_, const tiered_vector &rhs_) {
+    return !(lhs_ == rhs_);
+  }
+  friend std::ostream &operator<<(std::ostream &os_, const tiered_vector &v_) {
+    os_ << "[ ";
+    for (const auto &value : v_) {
+      os_ << value << " ";
+    }
+    os_ << "]";
+    return os_;
+  }
+  friend void swap(tiered_vector &first_, tiered_vector &second_) {
+    using std::swap;
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      swap(first_.m_alloc, second_.m_alloc);
+    }
+    swap(first_.m_tiers, second_.m_tiers);
+    swap(first_.m_size, second_.m_size);
+    swap(first_.m_shift, second_.m_shift);
+  }
+
+private:
+  typename directory::allocator_type directory_allocator(void) const {
+    return typename directory::allocator_type(m_alloc);
+  }
+  size_type mask(void) const { return block_size() - 1; }
+  /// Slot of the `offset_`-th element of `block_`.
+  pointer slot(const tier &block_, size_type offset_) const {
+    return block_.slots + ((block_.head + offset_) & mask());
+  }
+  iterator make_iterator(size_type idx_) {
+    return iterator{m_tiers.data(), m_shift, idx_};
+  }
+
+  template <typename... Args> void construct(pointer ptr_, Args &&...args) {
+    alloc_traits::construct(m_alloc, ptr_, std::forward<Args>(args)...);
+  }
+  void destroy(pointer ptr_) { alloc_traits::destroy(m_alloc, ptr_); }
+  /// Moves the element at `src_` to the free slot `dst_`.
+  void move_slot(pointer src_, pointer dst_) {
+    construct(dst_, std::move_if_noexcept(*src_));
+    destroy(src_);
+  }
+
+  template <typename... Args>
+  reference emplace_back_in(tier &block_, Args &&...args) {
+    pointer dst = slot(block_, block_.size);
+    construct(dst, std::forward<Args>(args)...);
+    ++block_.size;
+    ++m_size;
+    return *dst;
+  }
+
+  template <typename... Args>
+  iterator emplace_at(size_type idx_, Args &&...args) {
+    if (idx_ > m_size) {
+      throw std::length_error("Não existe essa posição no vector");
+    }
+    // Build the value first: `args` may refer to one of our own elements.
+    T value(std::forward<Args>(args)...);
+    if (idx_ == m_size) {
+      emplace_back(std::move(value));
+      return make_iterator(idx_);
+    }
+    if (m_tiers.back().size == block_size()) {
+      make_room();
+    }
+    size_type k{idx_ >> m_shift};
+    // Each later block takes the last element of the one before it.
+    for (size_type j{m_tiers.size() - 1}; j > k; --j) {
+      tier &prev = m_tiers[j - 1];
+      tier &cur = m_tiers[j];
+      cur.head = (cur.head - 1) & mask();
+      move_slot(slot(prev, prev.size - 1), slot(cur, 0));
+      ++cur.size;
+      --prev.size;
+    }
+    insert_in(m_tiers[k], idx_ & mask(), std::move(value));
+    ++m_size;
+    return make_iterator(idx_);
+  }
+
+  /// Inserts into a block that is not full, shifting the shorter side.
+  void insert_in(tier &block_, size_type offset_, T &&value_) {
+    if (offset_ < block_.size / 2) {
+      block_.head = (block_.head - 1) & mask();
+      for (size_type i{0}; i < offset_; ++i) {
+        move_slot(slot(block_, i + 1), slot(block_, i));
+      }
+    } else {
+      for (size_type i{block_.size}; i > offset_; --i) {
+        move_slot(slot(block_, i - 1), slot(block_, i));
+      }
+    }
+    construct(slot(block_, offset_), std::move(value_));
+    ++block_.size;
+  }
+  /// Erases `count_` elements from a block, closing the hole from the
+  /// shorter side.
+  void erase_in(tier &block_, size_type offset_, size_type count_ = 1) {
+    for (size_type i{0}; i < count_; ++i) {
+      destroy(slot(block_, offset_ + i));
+    }
+    if (offset_ < block_.size - offset_ - count_) {
+      for (size_type i{offset_}; i > 0; --i) {
+        move_slot(slot(block_, i - 1), slot(block_, i - 1 + count_));
+      }
+      block_.head = (block_.head + count_) & mask();
+    } else {
+      for (size_type i{offset_}; i + count_ < block_.size; ++i) {
+        move_slot(slot(block_, i + count_), slot(block_, i));
+      }
+    }
+    block_.size -= count_;
+  }
+  /// Tops up the blocks from `k_` on, each from the front of the next one,
+  /// until all blocks but the last are full again. Blocks left empty go.
+  void refill(size_type k_) {
+    for (size_type j{k_}; j + 1 < m_tiers.size();) {
+      tier &prev = m_tiers[j];
+      tier &cur = m_tiers[j + 1];
+      for (; prev.size < block_size() && cur.size > 0; --cur.size) {
+        move_slot(slot(cur, 0), slot(prev, prev.size));
+        ++prev.size;
+        cur.head = (cur.head + 1) & mask();
+      }
+      if (cur.size > 0) {
+        ++j;
+      } else {
+        alloc_traits::deallocate(m_alloc, cur.slots, block_size());
+        m_tiers.erase(m_tiers.begin() + j + 1);
+      }
+    }
+    drop_empty_block();
+  }
+
+  /// Appends an empty block, first doubling the block size if the
+  /// sequence has outgrown it.
+  void make_room(void) {
+    if (m_size >= (block_size() * block_size()) / 2) {
+      regroup();
+    }
+    if (m_size == 0 || m_tiers.back().size == block_size()) {
+      m_tiers.push_back(
+          tier{alloc_traits::allocate(m_alloc, block_size()), 0, 0});
+    }
+  }
+  void drop_empty_block(void) {
+    if (!m_tiers.empty() && m_tiers.back().size == 0) {
+      alloc_traits::deallocate(m_alloc, m_tiers.back().slots, block_size());
+      m_tiers.pop_back();
+    }
+  }
+  /// Doubles the block size, merging the blocks two by two.
+  void regroup(void) {
+    size_type old_size{block_size()};
+    size_type new_size{old_size * 2};
+    directory merged{directory_allocator()};
+    merged.reserve((m_tiers.size() + 1) / 2);
+    for (size_type j{0}; j < m_tiers.size(); j += 2) {
+      tier block{alloc_traits::allocate(m_alloc, new_size), 0, 0};
+      for (size_type p{j}; p < j + 2 && p < m_tiers.size(); ++p) {
+        tier &old = m_tiers[p];
+        for (size_type i{0}; i < old.size; ++i) {
+          move_slot(old.slots + ((old.head + i) & (old_size - 1)),
+                    block.slots + block.size++);
+        }
+        alloc_traits::deallocate(m_alloc, old.slots, old_size);
+      }
+      merged.push_back(block);
+    }
+    m_tiers = std::move(merged);
+    ++m_shift;
+  }
+
+  Alloc m_alloc;                 //!< Allocates the blocks.
+  directory m_tiers;             //!< The blocks, in order.
+  size_type m_size{0};           //!< Number of elements.
+  size_type m_shift{min_shift};  //!< log2 of the block size.
+};
+} // namespace sc
+
+#endif
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "test_helpers.h"
+#include "tiered_vector.h"
+#include "tm/test_manager.h"
+
+#define YES 1
+#define NO 0
+
+// =============================================================
+// Tenth batch of tests, focused on sc::tiered_vector
+// =============================================================
+
+// Same results as std::vector for a random mix of edits.
+#define TIERED_EDITS YES
+// Blocks grow with the sequence; indexing and iterators stay right.
+#define BLOCK_GROWTH YES
+// Non-trivial elements are built and destroyed exactly once.
+#define TIERED_LIFETIME YES
+// Copy assignment keeps each side's memory resource.
+#define PMR_COPY_ASSIGN YES
+
+namespace {
+using test_helpers::Counted;
+
+/// Whether `tiered_` holds the same elements as `model_`.
+template <typename T>
+bool same(const sc::tiered_vector<T> &tiered_, const std::vector<T> &model_) {
+  return tiered_.size() == model_.size() &&
+         std::equal(model_.begin(), model_.end(), tiered_.begin());
+}
+} // namespace
+
+void run_tiered_vector_tests(void) {
+  TestManager tm{"Tiered vector testing"};
+
+#if TIERED_EDITS
+  {
+    BEGIN_TEST(tm, "TieredEdits", "insert/erase anywhere, checked against std::vector");
+
+    std::mt19937 gen{3};
+    sc::tiered_vector<std::string> tiered;
+    std::vector<std::string> model;
+    bool matched{true};
+    for (int step{0}; step < 6000; ++step) {
+      std::size_t pos = gen() % (model.size() + 1);
+      std::string item = std::to_string(step);
+      switch (gen() % 5) {
+      case 0:
+      case 1:
+      case 2:
+        tiered.insert(tiered.begin() + pos, item);
+        model.insert(model.begin() + pos, item);
+        break;
+      case 3:
+        if (pos < model.size()) {
+          tiered.erase(tiered.begin() + pos);
+          model.erase(model.begin() + pos);
+        }
+        break;
+      default:
+        tiered.push_back(item);
+        model.push_back(item);
+      }
+      if (step % 100 == 0)
+        matched = matched && same(tiered, model);
+    }
+    EXPECT_TRUE(matched);
+    EXPECT_TRUE(same(tiered, model));
+    EXPECT_TRUE(tiered.block_size() > 64);
+
+    tiered.erase(tiered.begin() + 100, tiered.begin() + 1500);
+    model.erase(model.begin() + 100, model.begin() + 1500);
+    // Ranges inside one block, across several, and empty ones.
+    for (std::size_t len : {0, 0, 3, 60, 64, 129, 300}) {
+      std::size_t pos = gen() % (model.size() - len + 1);
+      tiered.erase(tiered.begin() + pos, tiered.begin() + pos + len);
+      model.erase(model.begin() + pos, model.begin() + pos + len);
+      matched = matched && same(tiered, model);
+    }
+    EXPECT_TRUE(matched);
+    tiered.insert(tiered.begin() + 5, {"a", "b", "c"});
+    model.insert(model.begin() + 5, {"a", "b", "c"});
+    // An argument that refers to the container itself.
+    tiered.insert(tiered.begin(), tiered.back());
+    model.insert(model.begin(), model.back());
+    while (model.size() > 700) {
+      tiered.pop_back();
+      model.pop_back();
+    }
+    EXPECT_TRUE(same(tiered, model));
+    EXPECT_EQ(tiered.front(), model.front());
+    EXPECT_EQ(tiered.at(699), model.at(699));
+
+    bool thrown{false};
+    try {
+      tiered.at(700);
+    } catch (const std::out_of_range &) {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+  }
+#endif
+
+#if BLOCK_GROWTH
+  {
+    BEGIN_TEST(tm, "BlockGrowth", "block size follows sqrt(n)");
+
+    using iterator = sc::tiered_vector<int>::iterator;
+    static_assert(std::is_same<std::iterator_traits<iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "random access iterator");
+    static_assert(std::is_convertible<iterator,
+                                      sc::tiered_vector<int>::const_iterator>::value,
+                  "iterator converts to const_iterator");
+
+    sc::tiered_vector<int> vec;
+    EXPECT_EQ(vec.block_size(), 64);
+    for (int i{0}; i < 100'000; ++i)
+      vec.insert(vec.begin() + i / 2, i);
+    // 256 slots hold 256^2 / 2 = 32768 elements; then 512.
+    EXPECT_EQ(vec.block_size(), 512);
+    EXPECT_EQ(vec.size(), 100'000);
+
+    std::vector<int> model;
+    for (int i{0}; i < 100'000; ++i)
+      model.insert(model.begin() + i / 2, i);
+    EXPECT_TRUE(same(vec, model));
+    EXPECT_EQ(vec[77'777], model[77'777]);
+
+    std::sort(vec.begin(), vec.end());
+    EXPECT_EQ(vec.end() - vec.begin(), 100'000);
+    EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+    EXPECT_EQ(*std::lower_bound(vec.cbegin(), vec.cend(), 4242), 4242);
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.block_size(), 64);
+  }
+#endif
+
+#if TIERED_LIFETIME
+  {
+    BEGIN_TEST(tm, "TieredLifetime", "ctor/dtor calls are balanced");
+
+    {
+      sc::tiered_vector<Counted> vec;
+      for (int i{0}; i < 3000; ++i)
+        vec.emplace(vec.begin() + i / 3, std::string(20, char('a' + i % 26)));
+      EXPECT_EQ(Counted::alive, 3000);
+      vec.erase(vec.begin() + 10, vec.begin() + 1010);
+      vec.erase(vec.begin() + 500);
+      EXPECT_EQ(Counted::alive, 1999);
+
+      sc::tiered_vector<Counted> copy{vec};
+      EXPECT_EQ(Counted::alive, 3998);
+      EXPECT_EQ(copy, vec);
+      sc::tiered_vector<Counted> moved{std::move(copy)};
+      EXPECT_TRUE(copy.empty());
+      copy = moved;
+      moved = std::move(vec);
+      EXPECT_EQ(Counted::alive, 3998);
+      swap(moved, copy);
+      moved.clear();
+      EXPECT_EQ(Counted::alive, 1999);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+  }
+#endif
+
+#if PMR_COPY_ASSIGN
+  {
+    BEGIN_TEST(tm, "PmrCopyAssign", "a = b keeps a's memory resource");
+
+    using tiered =
+        sc::tiered_vector<int, std::pmr::polymorphic_allocator<int>>;
+    EXPECT_TRUE(test_helpers::pmr_assign_and_swap<tiered>());
+  }
+#endif
+
+  tm.summary();
+  std::cout << "\n\n";
+}
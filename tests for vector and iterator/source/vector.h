@@ -1,19 +1,36 @@
 #ifndef _VECTOR_H_
 #define _VECTOR_H_
 
-#include <algorithm>        // std::copy, std::equal, std::fill
+#include <algorithm>        // std::copy, std::equal, std::fill, std::min
 #include <cassert>          // assert()
 #include <cstddef>          // std::size_t
+#include <cstdlib>          // std::malloc, std::realloc, std::free
+#include <cstring>          // std::memcpy, std::memmove, std::memcmp
+#include <functional>       // std::less
 #include <exception>        // std::out_of_range
 #include <initializer_list> // std::initializer_list
 #include <iostream>         // std::cout, std::endl
 #include <iterator> // std::advance, std::begin(), std::end(), std::ostream_iterator
 #include <limits> // std::numeric_limits<T>
-#include <memory> // std::unique_ptr
+#include <memory> // std::unique_ptr, std::allocator_traits
+#include <memory_resource> // std::pmr::polymorphic_allocator
+#include <new>     // std::bad_alloc, std::align_val_t, placement new
+#include <type_traits> // std::is_trivially_copyable
+#include <utility> // std::move, std::forward, std::move_if_noexcept
+#if __cplusplus > 201703L
+#include <compare> // std::weak_ordering, std::three_way_comparable
+#endif
 
 /// Sequence container namespace.
 namespace sc {
-/// Implements tha infrastrcture to support a bidirectional iterator.
+/// Implements tha infrastrcture to support a random access iterator.
+/*!
+ * The iterator is a thin wrapper around a pointer into contiguous storage,
+ * so it models a random access iterator and, from C++20 on, a
+ * `std::contiguous_iterator`: `std::to_address()` gives the raw pointer
+ * back. An iterator converts to the matching const iterator, and both can
+ * be compared and subtracted with each other.
+ */
 template <class T> class MyForwardIterator {
 public:
   using iterator = MyForwardIterator; //!< Alias to iterator.
@@ -21,121 +38,138 @@ public:
   typedef std::ptrdiff_t
       difference_type;  //!< Difference type used to calculated distance between
                         //!< iterators.
-  typedef T value_type; //!< Value type the iterator points to.
+  typedef std::remove_cv_t<T> value_type; //!< Value type the iterator points to.
   typedef T *pointer;   //!< Pointer to the value type.
   typedef T &reference; //!< Reference to the value type.
   typedef const T &const_reference; //!< Reference to the value type.
-  typedef std::bidirectional_iterator_tag
+  typedef std::random_access_iterator_tag
       iterator_category; //!< Iterator category.
+#if __cplusplus > 201703L
+  typedef std::contiguous_iterator_tag
+      iterator_concept; //!< The elements are contiguous in memory.
+#endif
 
   /*! Create an iterator around a raw pointer.
    * \param pt_ raw pointer to the container.
    */
-  MyForwardIterator(pointer pt = nullptr) : m_ptr(pt) { /* empty */
+  constexpr MyForwardIterator(pointer pt = nullptr) : m_ptr(pt) { /* empty */
   }
 
+  /// Converts an iterator into a const iterator, never the other way.
+  template <class U, typename = std::enable_if_t<
+                         std::is_convertible<U *, T *>::value &&
+                         !std::is_same<U, T>::value>>
+  constexpr MyForwardIterator(const MyForwardIterator<U> &other)
+      : m_ptr{other.m_ptr} {}
+
   /// Access the content the iterator points to.
-  reference operator*(void) const {
+  constexpr reference operator*(void) const {
     assert(m_ptr != nullptr);
     return *m_ptr;
   }
 
-  /// Overloaded `->` operator.
-  pointer operator->(void) const {
-    assert(m_ptr != nullptr);
+  /// Overloaded `->` operator. Also how `std::to_address()` gets the
+  /// address, so it works on any iterator, `end()` included.
+  constexpr pointer operator->(void) const {
     return m_ptr;
   }
 
+  /// Access the content `offset` positions away.
+  constexpr reference operator[](difference_type offset) const {
+    return m_ptr[offset];
+  }
+
   /// Assignment operator.
-  iterator &operator=(const iterator &other){
+  constexpr iterator &operator=(const iterator &other){
     m_ptr = other.m_ptr;
     return *this;
 
   }
   /// Copy constructor.
-  MyForwardIterator(const iterator &other){
-    m_ptr = other.m_ptr;
-  }
+  constexpr MyForwardIterator(const iterator &other) : m_ptr{other.m_ptr} {}
 
   /// Pre-increment operator.
-  iterator operator++(void) {
+  constexpr iterator &operator++(void) {
     ++(m_ptr);
     return *this;
   }
 
   /// Post-increment operator.
-  iterator operator++(int) {
+  constexpr iterator operator++(int) {
     iterator dummy{*this};
     ++(m_ptr);
     return dummy;
   }
 
   /// Pre-decrement operator.
-  iterator operator--(void) {
+  constexpr iterator &operator--(void) {
     --(m_ptr);
     return *this;
   }
 
   /// Post-decrement operator.
-  iterator operator--(int) {
+  constexpr iterator operator--(int) {
     iterator dummy{*this};
     --(m_ptr);
     return dummy;
   }
 
-  iterator &operator+=(difference_type offset) {
+  constexpr iterator &operator+=(difference_type offset) {
     iterator &it{*this};
     m_ptr+=offset;
     return it;
   }
-  iterator &operator-=(difference_type offset) {
+  constexpr iterator &operator-=(difference_type offset) {
     iterator &it{*this};
     m_ptr-=offset;
     return it;
   }
 
-  friend bool operator<(const iterator &ita, const iterator &itb) {
-    return ita < itb ;
+  // The comparisons are friends, so a const iterator on either side makes
+  // the other one convert.
+  friend constexpr bool operator<(const iterator &ita, const iterator &itb) {
+    return ita.m_ptr < itb.m_ptr;
   }
-  friend bool operator>(const iterator &ita, const iterator &itb) {
-    return ita > itb;
+  friend constexpr bool operator>(const iterator &ita, const iterator &itb) {
+    return ita.m_ptr > itb.m_ptr;
   }
-  friend bool operator>=(const iterator &ita, const iterator &itb) {
-    return ita >= itb;
+  friend constexpr bool operator>=(const iterator &ita, const iterator &itb) {
+    return ita.m_ptr >= itb.m_ptr;
   }
-  friend bool operator<=(const iterator &ita, const iterator &itb) {
-    return ita <= itb;
+  friend constexpr bool operator<=(const iterator &ita, const iterator &itb) {
+    return ita.m_ptr <= itb.m_ptr;
   }
 
-  friend iterator operator+(difference_type offset, iterator it) {
+  friend constexpr iterator operator+(difference_type offset, iterator it) {
     iterator dummy;
     dummy.m_ptr = offset+it.m_ptr;
     return dummy;
   }
-  friend iterator operator+(iterator it, difference_type offset) {
+  friend constexpr iterator operator+(iterator it, difference_type offset) {
     iterator dummy;
     dummy.m_ptr = it.m_ptr+offset;
     return dummy;
   }
-  friend iterator operator-(iterator it, difference_type offset) {
+  friend constexpr iterator operator-(iterator it, difference_type offset) {
     iterator dummy;
     dummy.m_ptr = it.m_ptr-offset;
     return dummy;
   }
 
   /// Equality operator.
-  bool operator==(const iterator &rhs_) const {
-    return m_ptr == rhs_.m_ptr;
+  friend constexpr bool operator==(const iterator &lhs_, const iterator &rhs_) {
+    return lhs_.m_ptr == rhs_.m_ptr;
   }
 
   /// Not equality operator.
-  bool operator!=(const iterator &rhs_) const {
-    return !(*this == rhs_);
+  friend constexpr bool operator!=(const iterator &lhs_, const iterator &rhs_) {
+    return !(lhs_ == rhs_);
   }
 
   /// Returns the difference between two iterators.
-  difference_type operator-(const iterator &rhs_) const {
-    return m_ptr-rhs_.m_ptr;
+  friend constexpr difference_type operator-(const iterator &lhs_,
+                                             const iterator &rhs_) {
+    return lhs_.m_ptr - rhs_.m_ptr;
   }
 
   /// Stream extractor operator.
@@ -146,9 +180,121 @@ public:
   }
 
 private:
+  template <class U> friend class MyForwardIterator;
+
   pointer m_ptr; //!< The raw pointer.
 };
 
+/// Tells whether a `T` can be moved to another address with a raw byte copy.
+/*!
+ * Relocating such a type with `memcpy`/`memmove` is equivalent to move
+ * constructing the new object and destroying the old one. This holds for
+ * every trivially copyable type. Many other types, such as ones holding
+ * only an owning pointer, can opt in by specializing this trait to
+ * `std::true_type`.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/// Tells whether two `T`s are equal exactly when their bytes are.
+/*!
+ * Then whole ranges can be compared with `memcmp`. This holds for
+ * integers, enums and pointers, but not for floats (NaN, -0.0) nor for
+ * types with padding. Other types can opt in by specializing this trait
+ * to `std::true_type`.
+ */
+template <typename T>
+struct is_trivially_equality_comparable
+    : std::integral_constant<bool, std::is_integral<T>::value ||
+                                       std::is_enum<T>::value ||
+                                       std::is_pointer<T>::value> {};
+
+/// Growth policies: how much a full vector grows.
+/*!
+ * A policy is a type with a static member
+ * `std::size_t next(std::size_t capacity, std::size_t required, std::size_t elem_size)`
+ * that returns the new capacity, in elements, for a vector whose
+ * `capacity` is exhausted and that needs room for `required` elements.
+ * The vector never grows to less than `required`.
+ */
+namespace growth {
+/// Doubles the capacity: fewest reallocations, up to 50% slack.
+struct doubling {
+  static std::size_t next(std::size_t capacity, std::size_t, std::size_t) {
+    return (capacity == 0) ? 1 : capacity * 2;
+  }
+};
+
+/// Grows by 1.5x. Below the golden ratio, so after a few steps the blocks
+/// freed earlier add up to enough room to be reused by the next one.
+struct golden {
+  static std::size_t next(std::size_t capacity, std::size_t, std::size_t) {
+    return (capacity < 2) ? capacity + 1 : capacity + capacity / 2;
+  }
+};
+
+/// Grows by a fixed number of elements: minimal slack, O(n) reallocations.
+template <std::size_t Step> struct fixed_step {
+  static_assert(Step > 0, "the growth step must be positive");
+  static std::size_t next(std::size_t capacity, std::size_t, std::size_t) {
+    return capacity + Step;
+  }
+};
+
+/// Grows by 1.5x, then rounds the block up to the next size class of the
+/// memory allocator, so the bytes the allocator hands out anyway are usable.
+/*!
+ * Small blocks follow the classes of jemalloc/tcmalloc-like allocators, four
+ * per power of two (2^k, 1.25*2^k, 1.5*2^k, 1.75*2^k). Blocks past
+ * `page_threshold` are mapped in whole pages, so they are rounded to pages.
+ */
+struct size_class {
+  static constexpr std::size_t page_size{4096};       //!< Mapping granularity.
+  static constexpr std::size_t page_threshold{1 << 20}; //!< Page-rounded above.
+
+  /// Smallest size class that can hold `bytes`.
+  static std::size_t round_bytes(std::size_t bytes) {
+    if (bytes <= 16) {
+      return 16;
+    }
+    if (bytes >= page_threshold) {
+      return (bytes + page_size - 1) / page_size * page_size;
+    }
+    std::size_t base{16};
+    while (base * 2 <= bytes) {
+      base *= 2;
+    }
+    std::size_t step = base / 4;
+    return (bytes + step - 1) / step * step;
+  }
+  static std::size_t next(std::size_t capacity, std::size_t required,
+                          std::size_t elem_size) {
+    std::size_t target = std::max(golden::next(capacity, required, elem_size),
+                                  required);
+    return round_bytes(target * elem_size) / elem_size;
+  }
+};
+} // namespace growth
+
+namespace detail {
+/// Raw, suitably aligned room for `N` elements kept inside the container.
+template <typename T, std::size_t N> class inline_storage {
+protected:
+  T *inline_data(void) noexcept { return reinterpret_cast<T *>(m_buffer); }
+  const T *inline_data(void) const noexcept {
+    return reinterpret_cast<const T *>(m_buffer);
+  }
+
+private:
+  alignas(T) unsigned char m_buffer[N * sizeof(T)]; //!< Uninitialized slots.
+};
+/// No inline room at all: the container always lives on the heap.
+template <typename T> class inline_storage<T, 0> {
+protected:
+  T *inline_data(void) const noexcept { return nullptr; }
+};
+} // namespace detail
+
 /// This class implements the ADT list with dynamic array.
 /*!
  * sc::vector is a sequence container that encapsulates dynamic size arrays.
@@ -159,9 +305,28 @@ private:
  * This means that a pointer to an element of a vector may be passed to
  * any function that expects a pointer to an element of an array.
  *
+ * Memory is obtained through `Alloc`, with every request going through
+ * `std::allocator_traits`. The default `std::allocator` is special-cased
+ * to use `std::malloc` directly, so relocatable elements can grow in place
+ * with `std::realloc`.
+ *
+ * When `InlineN` is not zero, the first `InlineN` elements are kept in a
+ * buffer inside the vector itself, and the heap is only used past that;
+ * see `sc::small_vector`.
+ *
  * \tparam T The type of the elements.
+ * \tparam Alloc The allocator used to acquire memory and build elements.
+ * \tparam GrowthPolicy How much the capacity grows when the storage is full;
+ * see the `sc::growth` namespace.
+ * \tparam InlineN How many elements fit without touching the heap.
  */
-template <typename T> class vector {
+template <typename T, typename Alloc = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling, std::size_t InlineN = 0>
+class vector : private detail::inline_storage<T, InlineN> {
+  using alloc_traits = std::allocator_traits<Alloc>;
+  static_assert(std::is_same<typename alloc_traits::pointer, T *>::value,
+                "sc::vector needs an allocator with raw pointers");
+
   //=== Aliases
 public:
   using size_type = unsigned long; //!< The size type.
@@ -171,6 +336,7 @@ public:
       value_type &; //!< Reference to a value stored in the container.
   using const_reference = const value_type &; //!< Const reference to a value
                                               //!< stored in the container.
+  using allocator_type = Alloc; //!< The allocator type.
 
   using iterator =
       MyForwardIterator<value_type>; //!< The iterator, instantiated from a
@@ -182,68 +348,128 @@ public:
 
 public:
   //=== [I] SPECIAL MEMBERS (6 OF THEM)
-  explicit vector(size_type cp = 0) {
-    m_storage = new T[cp];
-    m_capacity = cp;
-    m_end = cp; // Array começa vazio.
-    /* for (size_type i{0}; i < m_end; ++i) {
-      m_storage[i] = new T();
-    } */
+  vector(void) noexcept(noexcept(Alloc()))
+      : m_end{0}, m_capacity{InlineN}, m_storage{this->inline_data()},
+        m_alloc{} {}
+  explicit vector(const Alloc &alloc_) noexcept
+      : m_end{0}, m_capacity{InlineN}, m_storage{this->inline_data()},
+        m_alloc{alloc_} {}
+  explicit vector(size_type cp, const Alloc &alloc_ = Alloc())
+      : m_end{0}, m_capacity{InlineN}, m_storage{this->inline_data()},
+        m_alloc{alloc_} {
+    if (cp > m_capacity) {
+      m_storage = allocate(cp);
+      m_capacity = cp;
+    }
+    try {
+      construct_n(m_storage, cp);
+    } catch (...) {
+      deallocate(m_storage, m_capacity);
+      throw;
+    }
+    m_end = cp;
   }
   virtual ~vector(void) {
-    if (m_storage)
-      delete[] m_storage;
-  }
-  vector(const vector &other){
-    m_capacity=other.m_capacity;
-    m_end=other.m_end;
-    m_storage=new T[other.m_capacity];
-    for(size_type i{0};i<other.m_end;++i){
-      m_storage[i]=other.m_storage[i];
-    } 
+    destroy(m_storage, m_storage + m_end);
+    free_storage();
   }
-  vector(const std::initializer_list<T> &il) {
-    m_capacity = il.size();
-    m_storage = new T[m_capacity];
-    m_end = m_capacity; // Array começa cheio.
-    // Copy the elements from the il into the array.
-    std::copy(il.begin(), il.end(), m_storage);
+  vector(const vector &other)
+      : vector(other.m_storage, other.m_storage + other.m_end,
+               alloc_traits::select_on_container_copy_construction(
+                   other.m_alloc)) {}
+  vector(const vector &other, const Alloc &alloc_)
+      : vector(other.m_storage, other.m_storage + other.m_end, alloc_) {}
+  vector(const std::initializer_list<T> &il, const Alloc &alloc_ = Alloc())
+      : vector(il.begin(), il.end(), alloc_) {}
+  template <typename InputItr,
+            typename = std::enable_if_t<!std::is_integral<InputItr>::value>>
+  vector(InputItr first, InputItr last, const Alloc &alloc_ = Alloc())
+      : m_end{0}, m_capacity{InlineN}, m_storage{this->inline_data()},
+        m_alloc{alloc_} {
+    size_type lenght = std::distance(first, last);
+    if (lenght > m_capacity) {
+      m_storage = allocate(lenght);
+      m_capacity = lenght;
+    }
+    try {
+      construct_from(first, last, m_storage);
+    } catch (...) {
+      deallocate(m_storage, m_capacity);
+      throw;
+    }
+    m_end = lenght;
   }
-  template <typename InputItr> 
-  vector(InputItr first, InputItr last){
-    size_type lenght=last-first;
-    m_end = m_capacity = lenght;
-    m_storage =new T[lenght];
-    for(size_type i{0};i<lenght;++i) {
-        m_storage[i]=*first;
-        first++;
+  /// Move constructor: steals the storage of `other`, leaving it empty.
+  /// Inline elements cannot be stolen, so they are moved one by one.
+  vector(vector &&other) noexcept(InlineN == 0 ||
+                                  std::is_nothrow_move_constructible<T>::value)
+      : m_end{0}, m_capacity{InlineN}, m_storage{this->inline_data()},
+        m_alloc{std::move(other.m_alloc)} {
+    steal(other);
+  }
+  /// Move constructor with a given allocator. Storage can only be stolen
+  /// when both allocators can free each other's memory.
+  vector(vector &&other, const Alloc &alloc_)
+      : m_end{0}, m_capacity{InlineN}, m_storage{this->inline_data()},
+        m_alloc{alloc_} {
+    if (alloc_traits::is_always_equal::value || m_alloc == other.m_alloc) {
+      steal(other);
+    } else {
+      assign(std::make_move_iterator(other.m_storage),
+             std::make_move_iterator(other.m_storage + other.m_end));
+      other.clear();
     }
   }
   vector &operator=(const vector &other){
     if (this == &other){
       return *this;
     }
-    if(other.m_capacity != this->m_capacity){
-      delete[] m_storage;
-      this->m_storage=new T[other.m_capacity];
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (m_alloc != other.m_alloc) {
+        // Our memory must go back to the allocator that gave it.
+        release();
+      }
+      m_alloc = other.m_alloc;
     }
-    this->m_capacity=other.m_capacity;
-    this->m_end=other.m_end;
-    for(size_type i{0};i<other.m_end;++i){
-      this->m_storage[i]=other.m_storage[i];
-    }        
+    assign(other.m_storage, other.m_storage + other.m_end);
     return *this;
-    
   }
+  /// Move assignment: releases our storage and takes over `other`'s.
+  vector &operator=(vector &&other) noexcept(
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value) &&
+      (InlineN == 0 || std::is_nothrow_move_constructible<T>::value)) {
+    if (this == &other) {
+      return *this;
+    }
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        m_alloc == other.m_alloc) {
+      release();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+        m_alloc = std::move(other.m_alloc);
+      }
+      steal(other);
+    } else {
+      // Different arenas: the elements have to be moved one by one.
+      assign(std::make_move_iterator(other.m_storage),
+             std::make_move_iterator(other.m_storage + other.m_end));
+      other.clear();
+    }
+    return *this;
+  }
+  /// Returns a copy of the allocator.
+  allocator_type get_allocator(void) const { return m_alloc; }
 
   //=== [II] ITERATORS
-  iterator begin(void) { return iterator{&m_storage[0]}; }
-  iterator end(void){ return iterator{&m_storage[m_end]}; }
+  iterator begin(void) { return iterator{m_storage}; }
+  iterator end(void){ return iterator{m_storage + m_end}; }
+  const_iterator begin(void) const { return cbegin(); }
+  const_iterator end(void) const { return cend(); }
   const_iterator cbegin(void) const { 
-    return const_iterator{&m_storage[0]}; 
+    return const_iterator{m_storage};
   }
   const_iterator cend(void) const { 
-    return const_iterator{&m_storage[m_end]}; 
+    return const_iterator{m_storage + m_end};
   }
   
   
@@ -256,422 +482,252 @@ public:
 
   // [IV] Modifiers
   void clear(void){
+    destroy(m_storage, m_storage + m_end);
     m_end = 0;
+    // Nothing left to keep contiguous: hand the front slack back to the end.
+    m_storage -= m_front;
+    m_capacity += m_front;
+    m_front = 0;
+  }
+  void push_front(const_reference value){
+    emplace_front(value);
+  }
+  void push_front(value_type &&value){
+    emplace_front(std::move(value));
+  }
+  /// Constructs a new element at the front from `args`. Amortized O(1):
+  /// the spare room kept before the first element is used up first.
+  template <typename... Args> reference emplace_front(Args &&...args) {
+    if (m_front == 0) {
+      // `args` may refer to one of our own elements, which are about to move.
+      T value(std::forward<Args>(args)...);
+      make_front_room();
+      construct(m_storage - 1, std::move(value));
+    } else {
+      construct(m_storage - 1, std::forward<Args>(args)...);
+    }
+    --m_storage;
+    --m_front;
+    ++m_capacity;
+    ++m_end;
+    return m_storage[0];
   }
-  void push_front(const_reference value);
   void push_back(const_reference value){
-    if(m_end==m_capacity){
-      if (m_capacity == 0){
-        m_capacity = 1;
-      }
-      else{
-        m_capacity *= 2;
+    emplace_back(value);
+  }
+  void push_back(value_type &&value){
+    emplace_back(std::move(value));
+  }
+  /// Constructs a new element at the end from `args`, growing if needed.
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if(m_end==m_capacity && front_reclaimable()){
+      // `args` may refer to one of our own elements, which are about to move.
+      T value(std::forward<Args>(args)...);
+      slide_to_front();
+      construct(m_storage + m_end, std::move(value));
+    }
+    else if(m_end==m_capacity){
+      size_type new_capacity = grown_capacity(m_end + 1);
+      if constexpr (growable_in_place) {
+        // `args` may refer to one of our own elements, and realloc() may
+        // release the block they live in.
+        T value(std::forward<Args>(args)...);
+        reallocate(new_capacity);
+        construct(m_storage + m_end, std::move(value));
+        return m_storage[m_end++];
       }
-      T *new_storage= new T[m_capacity];
-      for(size_type i{0};i<m_end;++i){
-        new_storage[i]=m_storage[i];
+      pointer new_storage = allocate(new_capacity);
+      // Build the value first: `args` may refer to one of our own elements.
+      try {
+        construct(new_storage + m_end, std::forward<Args>(args)...);
+      } catch (...) {
+        deallocate(new_storage, new_capacity);
+        throw;
       }
-      delete[] m_storage;
-      m_storage=new_storage;
+      relocate_around(m_end, 1, new_storage, new_capacity);
+      adopt(new_storage, new_capacity);
     }
-    m_storage[m_end]=value;
-    ++m_end;
+    else{
+      construct(m_storage + m_end, std::forward<Args>(args)...);
+    }
+    return m_storage[m_end++];
   }
   void pop_back(void){
     if(empty()){
       throw std::length_error("Vector está vazio!");
     }
     m_end--;
+    destroy(m_storage + m_end, m_storage + m_end + 1);
+  }
+  /// Removes the first element in O(1): its slot joins the front slack.
+  void pop_front(void){
+    if(empty()){
+      throw std::length_error("Vector está vazio!");
+    }
+    destroy(m_storage, m_storage + 1);
+    if (--m_end == 0) {
+      clear();
+      return;
+    }
+    ++m_storage;
+    ++m_front;
+    --m_capacity;
   }
-  void pop_front(void);
 
   iterator insert(iterator pos_, const_reference value_){
-    size_type distance = pos_ - m_storage;
-    if (m_end == m_capacity) {
-      size_type new_capacity;
-      if (m_capacity == 0){
-        new_capacity = 1;
-      } else{
-        new_capacity = m_capacity*2;  
-      }
-      T* new_storage = new T[new_capacity];
-      for (size_type i{0}; i<distance; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      new_storage[distance] = value_;
-      for (size_type i{distance}; i < m_end; ++i) {
-        new_storage[i + 1] = m_storage[i];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = new_capacity;
-            
-    } else {
-      T* new_storage = new T[m_capacity];
-      for (size_type i {0}; i<distance; ++i) {
-          new_storage[i] = m_storage[i];
-      }
-      new_storage[distance] = value_;
-      for (size_type i{distance}; i < m_end; ++i) {
-        new_storage[i + 1] = m_storage[i];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;    
-    }
-    ++m_end;
-    return pos_;
+    return emplace_at(pos_ - m_storage, value_);
   }
-  
   iterator insert(const_iterator pos_, const_reference value_){
-    size_type distance = pos_ - m_storage;
-    if (m_end == m_capacity) {
-      size_type new_capacity;
-      if (m_capacity == 0){
-        new_capacity = 1;
-      } else{
-        new_capacity = m_capacity*2;  
-      }
-      T* new_storage = new T[new_capacity];
-      for (size_type i{0}; i<distance; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      new_storage[distance] = value_;
-      for (size_type i{distance}; i < m_end; ++i) {
-        new_storage[i + 1] = m_storage[i];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = new_capacity;
-            
-    } else {
-      T* new_storage = new T[m_capacity];
-      for (size_type i {0}; i<distance; ++i) {
-          new_storage[i] = m_storage[i];
-      }
-      new_storage[distance] = value_;
-      for (size_type i{distance}; i < m_end; ++i) {
-        new_storage[i + 1] = m_storage[i];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;    
-    }
-    ++m_end;
-    return pos_;
+    return emplace_at(pos_ - m_storage, value_);
+  }
+  iterator insert(iterator pos_, value_type &&value_){
+    return emplace_at(pos_ - m_storage, std::move(value_));
+  }
+  iterator insert(const_iterator pos_, value_type &&value_){
+    return emplace_at(pos_ - m_storage, std::move(value_));
+  }
+  /// Constructs a new element from `args` right before `pos_`.
+  template <typename... Args>
+  iterator emplace(iterator pos_, Args &&...args) {
+    return emplace_at(pos_ - m_storage, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace(const_iterator pos_, Args &&...args) {
+    return emplace_at(pos_ - m_storage, std::forward<Args>(args)...);
   }
 
   template <typename InputItr>
   iterator insert(iterator pos_, InputItr first_, InputItr last_){
-    size_type distance = pos_ - m_storage;
-    size_type lenght = last_ - first_;
-    if (m_end + lenght > m_capacity) {
-      size_t new_capacity;
-      if (m_end + lenght >  m_capacity * 2){
-        new_capacity = m_end + lenght;
-      }
-      else{
-        new_capacity = m_capacity * 2;
-      }
-      T* new_storage = new T[new_capacity];
-      
-     
-      for (size_type i{0}; i<distance; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      //new_storage[distance] = value_;
-      size_type i = distance;
-      for (iterator it = first_; it != last_; ++it) {
-        new_storage[i++] = *it;
-      }
-      for (size_type j = distance; j < m_end; ++j) {
-        new_storage[i++] = m_storage[j];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = new_capacity;
-            
-    } else {
-      for (size_type i{m_end + lenght - 1}; i > distance + lenght - 1; --i) {
-          m_storage[i] = m_storage[i - lenght];
-      }
-      size_type i = distance;
-      for (iterator it = first_; it != last_; ++it) {
-        m_storage[i++] = *it;
-      }    
-    }
-    m_end += distance;
-    return m_storage+distance;
+    return insert_range(pos_ - m_storage, first_, last_);
   }
   template <typename InputItr>
   iterator insert(const_iterator pos_, InputItr first_, InputItr last_){
-    size_type distance = pos_ - m_storage;
-    size_type lenght = last_ - first_;
-    if (m_end + lenght > m_capacity) {
-      size_t new_capacity;
-      if (m_end + lenght >  m_capacity * 2){
-        new_capacity = m_end + lenght;
-      }
-      else{
-        new_capacity = m_capacity * 2;
-      }
-      T* new_storage = new T[new_capacity];
-      for (size_type i{0}; i<distance; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      //new_storage[distance] = value_;
-      size_type i = distance;
-      for (iterator it = first_; it != last_; ++it) {
-        new_storage[i++] = *it;
-      }
-      for (size_type j = distance; j < m_end; ++j) {
-        new_storage[i++] = m_storage[j];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = new_capacity;
-            
-    } else {
-      for (size_type i{m_end + lenght - 1}; i > distance + lenght - 1; --i) {
-          m_storage[i] = m_storage[i - lenght];
-      }
-      size_type i = distance;
-      for (iterator it = first_; it != last_; ++it) {
-        m_storage[i++] = *it;
-      }    
-    }
-    m_end += distance;
-    return m_storage+distance;
+    return insert_range(pos_ - m_storage, first_, last_);
   }
 
   iterator insert(iterator pos_,
                   const std::initializer_list<value_type> &ilist_){
-    /*size_type distance = pos_ - m_storage;
-    size_type lenght = ilist_.end() - ilist_.begin();
-    if (m_end + lenght > m_capacity) {
-      size_t new_capacity;
-      if (m_end + lenght >  m_capacity * 2){
-        new_capacity = m_end + lenght;
-      }
-      else{
-        new_capacity = m_capacity * 2;
-      }
-      T* new_storage = new T[new_capacity];
-      for (size_type i{0}; i<distance; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      //new_storage[distance] = value_;
-      size_type i = distance;
-      for (iterator it = ilist_.begin(); it != ilist_.end(); ++it) {
-        new_storage[i++] = *it;
-      }
-      for (size_type j = distance; j < m_end; ++j) {
-        new_storage[i++] = m_storage[j];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = new_capacity;
-            
-    } else {
-      for (size_type i{m_end + lenght - 1}; i > distance + lenght - 1; --i) {
-          m_storage[i] = m_storage[i - lenght];
-      }
-      size_type i = distance;
-      for (iterator it = ilist_.begin(); it != ilist_.end(); ++it) {
-        m_storage[i++] = *it;
-      }    
-    }
-    m_end += distance;
-    return m_storage+distance;*/
+    return insert_range(pos_ - m_storage, ilist_.begin(), ilist_.end());
   }
   iterator insert(const_iterator pos_,
                   const std::initializer_list<value_type> &ilist_){
-    /*size_type distance = pos_ - m_storage;
-    size_type lenght = ilist_.end() - ilist_.begin();
-    if (m_end + lenght > m_capacity) {
-      size_t new_capacity;
-      if (m_end + lenght >  m_capacity * 2){
-        new_capacity = m_end + lenght;
-      }
-      else{
-        new_capacity = m_capacity * 2;
-      }
-      T* new_storage = new T[new_capacity];
-      for (size_type i{0}; i<distance; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      //new_storage[distance] = value_;
-      size_type i = distance;
-      for (iterator it = ilist_.begin(); it != ilist_.end(); ++it) {
-        new_storage[i++] = *it;
-      }
-      for (size_type j = distance; j < m_end; ++j) {
-        new_storage[i++] = m_storage[j];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = new_capacity;
-            
-    } else {
-      for (size_type i{m_end + lenght - 1}; i > distance + lenght - 1; --i) {
-          m_storage[i] = m_storage[i - lenght];
-      }
-      size_type i = distance;
-      for (iterator it = ilist_.begin(); it != ilist_.end(); ++it) {
-        m_storage[i++] = *it;
-      }    
-    }
-    m_end += distance;
-    return m_storage+distance;*/
+    return insert_range(pos_ - m_storage, ilist_.begin(), ilist_.end());
   }
 
   void reserve(size_type new_capacity){
     if(new_capacity<=m_capacity){
       return;
     }        
-    T *new_storage = new T[new_capacity];
-    for(size_type i{0}; i<m_end; ++i){
-      new_storage[i]=m_storage[i];
-    }
-    delete[] m_storage;
-    m_storage = new_storage;
-    m_capacity = new_capacity;
+    reallocate(new_capacity);
   }
   void shrink_to_fit(void){
-    if(m_capacity==m_end){
+    if(m_capacity==m_end && m_front==0){
         return;
     }
-    T *new_storage=new T[m_end];
-    for(size_type i{0}; i<m_end; ++i){
-        new_storage[i] = m_storage[i];
-    }
-    delete[] m_storage;
-    m_storage=new_storage;
-    m_capacity=m_end;
+    reallocate(m_end);
   }
-
-  void assign(size_type count_, const_reference value_){
-    if (count_ > m_capacity){
-      T* new_storage = new T[count_];
-
-      for (size_t i = 0; i < m_end; ++i) {
-        new_storage[i] = m_storage[i];
-      }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = count_;
+  /*! Resizes to `count_` elements, default-initializing the new ones
+   * instead of value-initializing them: trivial types keep whatever bytes
+   * the slots held, so nothing is zeroed. Meant for buffers that are
+   * about to be overwritten, e.g. by `read()`.
+   */
+  void resize_for_overwrite(size_type count_){
+    if(count_<=m_end){
+      destroy(m_storage + count_, m_storage + m_end);
       m_end = count_;
-      for(size_type i{0};i<count_;++i){ 
-        m_storage[i]=value_;
-      }
+      return;
     }
-    else{
-      m_end = count_;
-      for(size_type i{0};i<count_;++i){ 
-        m_storage[i]=value_;
+    append_uninitialized(count_ - m_end);
+  }
+  /*! Appends `count_` default-initialized elements, growing the way
+   * `push_back()` does, and returns a pointer to the first of them.
+   */
+  pointer append_uninitialized(size_type count_){
+    if(m_end + count_ > m_capacity){
+      reallocate(grown_capacity(m_end + count_));
+    }
+    pointer first = m_storage + m_end;
+    if constexpr (!std::is_trivially_default_constructible<T>::value) {
+      pointer cur = first;
+      try {
+        for (; cur != first + count_; ++cur) {
+          ::new (static_cast<void *>(cur)) T;
+        }
+      } catch (...) {
+        destroy(first, cur);
+        throw;
       }
-    
     }
-    
-    
+    m_end += count_;
+    return first;
   }
-  void assign(const std::initializer_list<T> &ilist){
-    size_t count_ = ilist.end() - ilist.begin();
-    if (count_ > m_capacity){
-      T* new_storage = new T[count_];
 
-      for (size_t i = 0; i < m_end; ++i) {
-        new_storage[i] = m_storage[i];
+  void assign(size_type count_, const_reference value_){
+    if (count_ > m_capacity){
+      // `value_` may live in our storage: build the new buffer first.
+      pointer new_storage = allocate(count_);
+      try {
+        construct_n(new_storage, count_, value_);
+      } catch (...) {
+        deallocate(new_storage, count_);
+        throw;
       }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = count_;
+      clear();
+      adopt(new_storage, count_);
+      m_end = count_;
+    }
+    else if (count_ <= m_end){
+      std::fill_n(m_storage, count_, value_);
+      destroy(m_storage + count_, m_storage + m_end);
       m_end = count_;
-      for (size_t i = 0; i < count_; ++i) {
-          m_storage[i] = *(ilist.begin() + i);
-      }
     }
     else{
+      std::fill_n(m_storage, m_end, value_);
+      construct_n(m_storage + m_end, count_ - m_end, value_);
       m_end = count_;
-      for (size_t i = 0; i < count_; ++i) {
-        m_storage[i] = *(ilist.begin() + i);
-      }
-    
     }
-
-        
-       
+  }
+  void assign(const std::initializer_list<T> &ilist){
+    assign(ilist.begin(), ilist.end());
   }
   template <typename InputItr> 
   void assign(InputItr first, InputItr last){
-    size_t count_ = last - first;
+    size_type count_ = std::distance(first, last);
     if (count_ > m_capacity){
-      T* new_storage = new T[count_];
-
-      for (size_t i = 0; i < m_end; ++i) {
-        new_storage[i] = m_storage[i];
+      pointer new_storage = allocate(count_);
+      try {
+        construct_from(first, last, new_storage);
+      } catch (...) {
+        deallocate(new_storage, count_);
+        throw;
       }
-      delete[] m_storage;
-      m_storage = new_storage;
-      m_capacity = count_;
-      m_end = count_;
-      for (size_t i = 0; i < count_; ++i) {
-            m_storage[i] = *(first + i);
-        }
-      }
-      else{
-        m_end = count_;
-        for (size_t i = 0; i < count_; ++i) {
-          m_storage[i] = *(first + i);
-        }
-      
-      }
-  }
-  iterator erase(iterator first, iterator last);
-    
-    /*if (first >= last) {
-      throw std::length_error("Não existe esse intervalo no vector");   
-    } 
-    size_type distance = first - m_storage;
-    size_type lenght = last - first;
-    for (size_type i{distance}; i < m_end-1; ++i){
-      m_storage[i] = m_storage[i+lenght];
+      clear();
+      adopt(new_storage, count_);
     }
-    m_end -= lenght;
-    
-    return last;*/
-  iterator erase(const_iterator first, const_iterator last);
-    /*if (first >= last) {
-      throw std::length_error("Não existe esse intervalo no vector");   
-    } 
-    size_type distance = first - m_storage;
-    size_type lenght = last - first;
-    for (size_type i{distance}; i < m_end-1; ++i){
-      m_storage[i] = m_storage[i+lenght];
+    else if (count_ <= m_end){
+      std::copy(first, last, m_storage);
+      destroy(m_storage + count_, m_storage + m_end);
     }
-    m_end -= lenght;*/
-    
+    else{
+      InputItr mid = first;
+      std::advance(mid, m_end);
+      std::copy(first, mid, m_storage);
+      construct_from(mid, last, m_storage + m_end);
+    }
+    m_end = count_;
+  }
+  iterator erase(iterator first, iterator last){
+    return erase_range(first - m_storage, last - m_storage);
+  }
+  iterator erase(const_iterator first, const_iterator last){
+    return erase_range(first - m_storage, last - m_storage);
+  }
 
   iterator erase(const_iterator pos){
-    size_type distance = pos - m_storage;
-    if (distance < 0 || distance >= m_end) {
-      throw std::length_error("Não existe essa posição no vector");   
-    }
-    for (size_type i{distance}; i<m_end - 1; ++i) {
-      m_storage[i] = m_storage[i + 1];
-    }
-    --m_end; 
-    return pos;
+    return erase_at(pos - m_storage);
   }
   iterator erase(iterator pos){
-    size_type distance = pos - m_storage;
-    if (distance < 0 || distance >= m_end) {
-      throw std::length_error("Não existe essa posição no vector");   
-    }
-    for (size_type i{distance}; i<m_end - 1; ++i) {
-      m_storage[i] = m_storage[i + 1];
-    }
-    --m_end; 
-    return pos;
-    
+    return erase_at(pos - m_storage);
   }
 
   // [V] Element access
@@ -716,63 +772,645 @@ public:
     return m_storage[idx];
   }
   pointer data(void){
-    return *m_storage;
+    return m_storage;
   }
-  const_reference data(void) const{
+  const T *data(void) const{
     return m_storage;
   }
 
   // [VII] Friend functions.
-  friend std::ostream &operator<<(std::ostream &os_, const vector<T> &v_) {
-    // O que eu quero imprimir???
+  friend std::ostream &operator<<(std::ostream &os_, const vector &v_) {
+    // Only live elements are printed: the spare capacity is raw memory.
     os_ << "{ ";
-    for (auto i{0u}; i < v_.m_capacity; ++i) {
-      if (i == v_.m_end)
-        os_ << "| ";
+    for (auto i{0u}; i < v_.m_end; ++i) {
       os_ << v_.m_storage[i] << " ";
     }
-    os_ << "}, m_end=" << v_.m_end << ", m_capacity=" << v_.m_capacity;
+    os_ << "| }, m_end=" << v_.m_end << ", m_capacity=" << v_.m_capacity;
 
     return os_;
   }
-  friend void swap(vector<T> &first_, vector<T> &second_) {
+  friend void swap(vector &first_, vector &second_) {
     // enable ADL
     using std::swap;
 
-    // Swap each member of the class.
+    if constexpr (InlineN > 0) {
+      // Inline elements live inside the objects and cannot trade places.
+      if (first_.is_inline() || second_.is_inline()) {
+        vector temp{std::move(first_)};
+        first_ = std::move(second_);
+        second_ = std::move(temp);
+        return;
+      }
+    }
+
+    // Swap each member of the class. The allocators follow only when they
+    // are meant to; otherwise they must compare equal.
     swap(first_.m_end, second_.m_end);
     swap(first_.m_capacity, second_.m_capacity);
+    swap(first_.m_front, second_.m_front);
     swap(first_.m_storage, second_.m_storage);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      swap(first_.m_alloc, second_.m_alloc);
+    }
   }
 
 private:
   bool full(void) const;
 
+  /// Elements may be moved around with `memcpy`/`memmove`.
+  static constexpr bool relocatable = is_trivially_relocatable<T>::value;
+  /// `std::allocator` is served straight from `std::malloc`.
+  static constexpr bool default_alloc =
+      std::is_same<Alloc, std::allocator<T>>::value;
+  /// Over-aligned types cannot come from `std::malloc`.
+  static constexpr bool over_aligned =
+      alignof(T) > alignof(std::max_align_t);
+  /// Growth may extend the buffer in place with `std::realloc`.
+  static constexpr bool growable_in_place =
+      default_alloc && relocatable && !over_aligned;
+
+  /// Grabs raw, uninitialized memory for `count_` elements.
+  pointer allocate(size_type count_) {
+    if (count_ == 0) {
+      return nullptr;
+    }
+    if (count_ > std::numeric_limits<size_type>::max() / sizeof(T)) {
+      throw std::length_error("Capacidade grande demais!");
+    }
+    if constexpr (!default_alloc) {
+      return alloc_traits::allocate(m_alloc, count_);
+    } else if constexpr (over_aligned) {
+      return static_cast<pointer>(
+          ::operator new(count_ * sizeof(T), std::align_val_t{alignof(T)}));
+    } else {
+      void *ptr = std::malloc(count_ * sizeof(T));
+      if (ptr == nullptr) {
+        throw std::bad_alloc{};
+      }
+      return static_cast<pointer>(ptr);
+    }
+  }
+  /// Gives back the `count_` slots at `ptr_`, obtained with `allocate()`.
+  /// The inline buffer is never given back.
+  void deallocate(pointer ptr_, size_type count_) {
+    if (ptr_ == nullptr || ptr_ == this->inline_data()) {
+      return;
+    }
+    if constexpr (!default_alloc) {
+      alloc_traits::deallocate(m_alloc, ptr_, count_);
+    } else if constexpr (over_aligned) {
+      ::operator delete(static_cast<void *>(ptr_),
+                        std::align_val_t{alignof(T)});
+    } else {
+      std::free(static_cast<void *>(ptr_));
+    }
+  }
+
+  /// Builds an element in the raw slot `ptr_`, through the allocator.
+  template <typename... Args> void construct(pointer ptr_, Args &&...args) {
+    alloc_traits::construct(m_alloc, ptr_, std::forward<Args>(args)...);
+  }
+  /// Destroys the elements in [`first_`, `last_`), through the allocator.
+  void destroy(pointer first_, pointer last_) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (; first_ != last_; ++first_) {
+        alloc_traits::destroy(m_alloc, first_);
+      }
+    }
+  }
+  /// Builds copies of [`first_`, `last_`) in the raw memory at `dst_`.
+  /// On failure, whatever was already built is destroyed.
+  template <typename InputItr>
+  pointer construct_from(InputItr first_, InputItr last_, pointer dst_) {
+    if constexpr (default_alloc) {
+      return std::uninitialized_copy(first_, last_, dst_);
+    } else {
+      pointer cur = dst_;
+      try {
+        for (; first_ != last_; ++first_, ++cur) {
+          construct(cur, *first_);
+        }
+      } catch (...) {
+        destroy(dst_, cur);
+        throw;
+      }
+      return cur;
+    }
+  }
+  /// Builds `count_` elements from `args` (value-initialized if none) in
+  /// the raw memory at `dst_`. On failure, whatever was built is destroyed.
+  template <typename... Args>
+  void construct_n(pointer dst_, size_type count_, const Args &...args) {
+    pointer cur = dst_;
+    try {
+      for (; count_ > 0; --count_, ++cur) {
+        construct(cur, args...);
+      }
+    } catch (...) {
+      destroy(dst_, cur);
+      throw;
+    }
+  }
+
+  /// Moves `count_` elements from `src_` into the raw memory at `dst_`, and
+  /// destroys the originals. Relocatable types take a single `memcpy`;
+  /// the others fall back to a copy when moving could throw and leave the
+  /// source in a broken state.
+  void relocate(pointer src_, size_type count_, pointer dst_) {
+    if constexpr (relocatable) {
+      if (count_ > 0) {
+        std::memcpy(static_cast<void *>(dst_), static_cast<const void *>(src_),
+                    count_ * sizeof(T));
+      }
+    } else {
+      transfer(src_, count_, dst_);
+      destroy(src_, src_ + count_);
+    }
+  }
+  /// Moves (or copies, when moving could throw) `count_` elements from
+  /// `src_` into the raw memory at `dst_`, leaving the originals alive.
+  /// On failure, whatever was already built is destroyed.
+  pointer transfer(pointer src_, size_type count_, pointer dst_) {
+    if constexpr (std::is_nothrow_move_constructible<T>::value ||
+                  !std::is_copy_constructible<T>::value) {
+      return construct_from(std::make_move_iterator(src_),
+                            std::make_move_iterator(src_ + count_), dst_);
+    } else {
+      return construct_from(src_, src_ + count_, dst_);
+    }
+  }
+  /*! Relocates the live elements into `new_storage_`, around `gap_` slots at
+   * index `distance_` that are already built. The originals are destroyed
+   * only once both halves made it across; if either throws, the new buffer
+   * is torn down, gap included, and this vector is left as it was.
+   */
+  void relocate_around(size_type distance_, size_type gap_,
+                       pointer new_storage_, size_type new_capacity_) {
+    pointer hole = new_storage_ + distance_;
+    if constexpr (relocatable) {
+      relocate(m_storage, distance_, new_storage_);
+      relocate(m_storage + distance_, m_end - distance_, hole + gap_);
+    } else {
+      pointer built = new_storage_;
+      try {
+        built = transfer(m_storage, distance_, new_storage_);
+        transfer(m_storage + distance_, m_end - distance_, hole + gap_);
+      } catch (...) {
+        destroy(new_storage_, built);
+        destroy(hole, hole + gap_);
+        deallocate(new_storage_, new_capacity_);
+        throw;
+      }
+      destroy(m_storage, m_storage + m_end);
+    }
+  }
+
+  /// Capacity to grow to when at least `required_` slots are needed.
+  size_type grown_capacity(size_type required_) const {
+    return std::max<size_type>(
+        required_, GrowthPolicy::next(m_capacity, required_, sizeof(T)));
+  }
+
+  /// Moves the live elements into a buffer of `new_capacity` slots.
+  /// A buffer that fits inline always goes back there.
+  void reallocate(size_type new_capacity) {
+    if constexpr (InlineN > 0) {
+      if (new_capacity <= InlineN) {
+        if (is_inline()) {
+          slide_to_front();
+        } else {
+          relocate(m_storage, m_end, this->inline_data());
+          free_storage();
+          m_storage = this->inline_data();
+          m_front = 0;
+          m_capacity = InlineN;
+        }
+        return;
+      }
+    }
+    if constexpr (growable_in_place) {
+      // Let the allocator extend (or trim) the block where it stands.
+      // With front slack the block does not start at `m_storage`.
+      if (!is_inline() && m_front == 0) {
+        if (new_capacity == 0) {
+          deallocate(m_storage, m_capacity);
+          m_storage = nullptr;
+        } else {
+          // Same guard as allocate(): a wrapped byte count would reach
+          // realloc() as 0 and free the block under us.
+          if (new_capacity >
+              std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::length_error("Capacidade grande demais!");
+          }
+          void *ptr = std::realloc(static_cast<void *>(m_storage),
+                                   new_capacity * sizeof(T));
+          if (ptr == nullptr) {
+            throw std::bad_alloc{};
+          }
+          m_storage = static_cast<pointer>(ptr);
+        }
+        m_capacity = new_capacity;
+        return;
+      }
+    }
+    pointer new_storage = allocate(new_capacity);
+    relocate_around(m_end, 0, new_storage, new_capacity);
+    adopt(new_storage, new_capacity);
+  }
+
+  /// Inserts a new element built from `args` at index `distance`.
+  template <typename... Args>
+  iterator emplace_at(size_type distance, Args &&...args) {
+    if (distance > m_end) {
+      throw std::length_error("Não existe essa posição no vector");
+    }
+    if (distance == m_end) {
+      emplace_back(std::forward<Args>(args)...);
+      return iterator{m_storage + distance};
+    }
+    if (m_end < m_capacity) {
+      // Room to spare: open a hole by shifting the tail one slot up.
+      // The value is built first, as `args` may refer to the tail itself.
+      T value(std::forward<Args>(args)...);
+      pointer pos = m_storage + distance;
+      if constexpr (relocatable) {
+        std::memmove(static_cast<void *>(pos + 1),
+                     static_cast<const void *>(pos),
+                     (m_end - distance) * sizeof(T));
+        construct(pos, std::move(value));
+      } else {
+        construct(m_storage + m_end, std::move(m_storage[m_end - 1]));
+        std::move_backward(pos, m_storage + m_end - 1, m_storage + m_end);
+        *pos = std::move(value);
+      }
+      ++m_end;
+      return iterator{pos};
+    }
+    size_type new_capacity = grown_capacity(m_end + 1);
+    pointer new_storage = allocate(new_capacity);
+    // Build the value first: `args` may refer to one of our own elements.
+    try {
+      construct(new_storage + distance, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(new_storage, new_capacity);
+      throw;
+    }
+    relocate_around(distance, 1, new_storage, new_capacity);
+    adopt(new_storage, new_capacity);
+    ++m_end;
+    return iterator{m_storage + distance};
+  }
+
+  /// Inserts the range [`first_`, `last_`) at index `distance`.
+  template <typename InputItr>
+  iterator insert_range(size_type distance, InputItr first_, InputItr last_) {
+    if constexpr (std::is_same<InputItr, iterator>::value ||
+                  std::is_same<InputItr, const_iterator>::value ||
+                  std::is_convertible<InputItr, const T *>::value) {
+      // The range lives in our own storage, which is about to be shuffled.
+      if (first_ != last_ && owns(&*first_)) {
+        vector copy(first_, last_);
+        return insert_range(distance, std::make_move_iterator(copy.m_storage),
+                            std::make_move_iterator(copy.m_storage + copy.m_end));
+      }
+    }
+    size_type lenght = std::distance(first_, last_);
+    if (m_end + lenght > m_capacity) {
+      size_type new_capacity = grown_capacity(m_end + lenght);
+      pointer new_storage = allocate(new_capacity);
+      try {
+        construct_from(first_, last_, new_storage + distance);
+      } catch (...) {
+        deallocate(new_storage, new_capacity);
+        throw;
+      }
+      relocate_around(distance, lenght, new_storage, new_capacity);
+      adopt(new_storage, new_capacity);
+    } else {
+      // Shift the tail in place. Relocatable types just slide over with one
+      // memmove(). Otherwise the part that lands past `m_end` goes into raw
+      // memory and must be constructed, the rest is move-assigned.
+      pointer pos = m_storage + distance;
+      size_type tail = m_end - distance;
+      if constexpr (relocatable) {
+        std::memmove(static_cast<void *>(pos + lenght),
+                     static_cast<const void *>(pos), tail * sizeof(T));
+        try {
+          construct_from(first_, last_, pos);
+        } catch (...) {
+          std::memmove(static_cast<void *>(pos),
+                       static_cast<const void *>(pos + lenght),
+                       tail * sizeof(T));
+          throw;
+        }
+      } else if (tail > lenght) {
+        construct_from(std::make_move_iterator(m_storage + m_end - lenght),
+                       std::make_move_iterator(m_storage + m_end),
+                       m_storage + m_end);
+        std::move_backward(pos, m_storage + m_end - lenght, m_storage + m_end);
+        std::copy(first_, last_, pos);
+      } else {
+        construct_from(std::make_move_iterator(pos),
+                       std::make_move_iterator(m_storage + m_end), pos + lenght);
+        InputItr mid = first_;
+        std::advance(mid, tail);
+        std::copy(first_, mid, pos);
+        construct_from(mid, last_, m_storage + m_end);
+      }
+    }
+    m_end += lenght;
+    return iterator{m_storage + distance};
+  }
+
+  /// Takes over the storage of `other`, which is left empty. Our own
+  /// storage must have been released already. Inline elements are moved
+  /// into our own inline buffer instead.
+  void steal(vector &other) {
+    if (other.is_inline()) {
+      relocate(other.m_storage, other.m_end, m_storage);
+      m_end = other.m_end;
+      other.m_end = 0;
+      other.clear();
+      return;
+    }
+    m_storage = other.m_storage;
+    m_end = other.m_end;
+    m_front = other.m_front;
+    m_capacity = other.m_capacity;
+    other.m_storage = other.inline_data();
+    other.m_end = 0;
+    other.m_front = 0;
+    other.m_capacity = InlineN;
+  }
+
+  /// Destroys every element and gives the heap buffer back, if any.
+  void release(void) {
+    clear();
+    free_storage();
+    m_storage = this->inline_data();
+    m_capacity = InlineN;
+  }
+
+  /// Gives back the whole buffer, front slack included.
+  void free_storage(void) {
+    deallocate(m_storage - m_front, m_front + m_capacity);
+  }
+
+  /// Frees the current buffer and takes over `new_storage_`, which has
+  /// `new_capacity_` slots and holds the elements `front_` slots in.
+  void adopt(pointer new_storage_, size_type new_capacity_,
+             size_type front_ = 0) {
+    free_storage();
+    m_storage = new_storage_ + front_;
+    m_front = front_;
+    m_capacity = new_capacity_ - front_;
+  }
+
+  /// Tells whether the elements live in the inline buffer.
+  bool is_inline(void) const {
+    return InlineN > 0 && m_storage - m_front == this->inline_data();
+  }
+
+  /// Moves the live elements, within the same buffer, to start at `dst_`.
+  /// Relocatable types slide with one memmove(); the others are moved one
+  /// by one, constructing into raw slots and assigning over live ones.
+  void shift_to(pointer dst_) {
+    if (dst_ == m_storage) {
+      return;
+    }
+    if constexpr (relocatable) {
+      std::memmove(static_cast<void *>(dst_),
+                   static_cast<const void *>(m_storage), m_end * sizeof(T));
+    } else if (dst_ < m_storage) {
+      for (size_type i{0}; i < m_end; ++i) {
+        if (dst_ + i < m_storage) {
+          construct(dst_ + i, std::move(m_storage[i]));
+        } else {
+          dst_[i] = std::move(m_storage[i]);
+        }
+      }
+      destroy(std::max(dst_ + m_end, m_storage), m_storage + m_end);
+    } else {
+      for (size_type i{m_end}; i > 0; --i) {
+        if (dst_ + i - 1 >= m_storage + m_end) {
+          construct(dst_ + i - 1, std::move(m_storage[i - 1]));
+        } else {
+          dst_[i - 1] = std::move(m_storage[i - 1]);
+        }
+      }
+      destroy(m_storage, std::min(dst_, m_storage + m_end));
+    }
+    std::ptrdiff_t delta = m_storage - dst_;
+    m_capacity += delta;
+    m_front -= delta;
+    m_storage = dst_;
+  }
+
+  /// Gives all the front slack back to the end of the buffer.
+  void slide_to_front(void) { shift_to(m_storage - m_front); }
+
+  /// Tells whether a full back should slide the elements down rather than
+  /// grow: at least half the buffer is front slack. This keeps queue-like
+  /// use (push_back + pop_front) within a single buffer.
+  bool front_reclaimable(void) const {
+    return m_front > 0 && m_end <= (m_front + m_capacity) / 2;
+  }
+
+  /// Opens room before the first element. With at least half the buffer
+  /// free, the elements are recentered in place; otherwise the buffer
+  /// grows, as by `GrowthPolicy`, with the elements recentered in it.
+  void make_front_room(void) {
+    size_type total = m_front + m_capacity;
+    if (m_end < total / 2) {
+      shift_to(m_storage - m_front + (total - m_end + 1) / 2);
+      return;
+    }
+    size_type new_total = std::max<size_type>(
+        m_end + 1, GrowthPolicy::next(total, m_end + 1, sizeof(T)));
+    size_type front = (new_total - m_end + 1) / 2;
+    pointer new_storage = allocate(new_total);
+    try {
+      relocate(m_storage, m_end, new_storage + front);
+    } catch (...) {
+      deallocate(new_storage, new_total);
+      throw;
+    }
+    adopt(new_storage, new_total, front);
+  }
+
+  /// Tells whether `ptr_` points to one of our live elements.
+  bool owns(const T *ptr_) const {
+    return std::less_equal<const T *>{}(m_storage, ptr_) &&
+           std::less<const T *>{}(ptr_, m_storage + m_end);
+  }
+
+  /// Removes the element at index `distance`, shifting the tail down.
+  iterator erase_at(size_type distance) {
+    if (distance >= m_end) {
+      throw std::length_error("Não existe essa posição no vector");
+    }
+    return erase_range(distance, distance + 1);
+  }
+
+  /// Removes the elements in [`first_`, `last_`), shifting the tail down
+  /// once, by the whole gap.
+  iterator erase_range(size_type first_, size_type last_) {
+    if (first_ > last_ || last_ > m_end) {
+      throw std::length_error("Não existe esse intervalo no vector");
+    }
+    size_type lenght = last_ - first_;
+    if (lenght == 0) {
+      // Nothing to remove; sliding the tail onto itself would self-move.
+      return iterator{m_storage + first_};
+    }
+    if constexpr (relocatable) {
+      destroy(m_storage + first_, m_storage + last_);
+      std::memmove(static_cast<void *>(m_storage + first_),
+                   static_cast<const void *>(m_storage + last_),
+                   (m_end - last_) * sizeof(T));
+    } else {
+      std::move(m_storage + last_, m_storage + m_end, m_storage + first_);
+      destroy(m_storage + m_end - lenght, m_storage + m_end);
+    }
+    m_end -= lenght;
+    return iterator{m_storage + first_};
+  }
+
   size_type
       m_end; //!< The list's current size (or index past-last valid element).
-  size_type m_capacity; //!< The list's storage capacity.
-  T *m_storage;         //!< The list's data storage area.
+  size_type m_capacity; //!< The list's storage capacity, from `m_storage` on.
+  T *m_storage;         //!< The list's first element.
+  size_type m_front{0}; //!< Spare slots before `m_storage` (front slack).
+  Alloc m_alloc;        //!< Source of the storage area.
 };
 
+namespace detail {
+/// Index of the first position where [lhs_, lhs_ + n_) and [rhs_, rhs_ + n_)
+/// differ, or `n_`. Byte-comparable elements are compared a block at a
+/// time with `memcmp`, which the C library vectorizes.
+template <typename T>
+std::size_t mismatch(const T *lhs_, const T *rhs_, std::size_t n_) {
+  std::size_t i{0};
+  if constexpr (is_trivially_equality_comparable<T>::value) {
+    constexpr std::size_t page{4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1};
+    constexpr std::size_t line{64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1};
+    // Skip equal pages, then equal cache lines of the page that differs.
+    while (i < n_ && std::memcmp(lhs_ + i, rhs_ + i,
+                                 std::min(page, n_ - i) * sizeof(T)) == 0) {
+      i += page;
+    }
+    while (i < n_ && std::memcmp(lhs_ + i, rhs_ + i,
+                                 std::min(line, n_ - i) * sizeof(T)) == 0) {
+      i += line;
+    }
+  }
+  while (i < n_ && lhs_[i] == rhs_[i]) {
+    ++i;
+  }
+  return std::min(i, n_);
+}
+} // namespace detail
+
 // [VI] Operators
-template <typename T> bool 
-operator==(const vector<T> &vector1, const vector<T> &vector2){
-  for(auto i{0}; i<vector1.size(); ++i) {
-    if(vector1.at(i) != vector2.at(i)){
-      return false;
+/// Equal sizes and equal elements. Byte-comparable elements are compared
+/// with a single `memcmp`.
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+bool operator==(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+                const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  if (vector1.size() != vector2.size()) {
+    return false;
+  }
+  if constexpr (is_trivially_equality_comparable<T>::value) {
+    return vector1.empty() ||
+           std::memcmp(vector1.data(), vector2.data(),
+                       vector1.size() * sizeof(T)) == 0;
+  } else {
+    return std::equal(vector1.data(), vector1.data() + vector1.size(),
+                      vector2.data());
+  }
+}
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+bool operator!=(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+                const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  return !(vector1 == vector2);
+}
+#if __cplusplus > 201703L
+/// Lexicographic order: the first differing elements decide, or else the
+/// shorter vector comes first. Elements without `<=>` are ordered by `<`.
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+auto operator<=>(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+                 const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  auto order = [](const T &a, const T &b) {
+    if constexpr (std::three_way_comparable<T>) {
+      return a <=> b;
+    } else {
+      return a < b ? std::weak_ordering::less
+             : b < a ? std::weak_ordering::greater
+                     : std::weak_ordering::equivalent;
     }
+  };
+  if constexpr (is_trivially_equality_comparable<T>::value) {
+    std::size_t common = std::min(vector1.size(), vector2.size());
+    std::size_t i = detail::mismatch(vector1.data(), vector2.data(), common);
+    if (i < common) {
+      return order(vector1[i], vector2[i]);
+    }
+    return decltype(order(vector1[0], vector2[0]))(vector1.size() <=>
+                                                   vector2.size());
+  } else {
+    return std::lexicographical_compare_three_way(
+        vector1.data(), vector1.data() + vector1.size(), vector2.data(),
+        vector2.data() + vector2.size(), order);
   }
-  return true;
-};
-template <typename T> bool 
-operator!=(const vector<T> &vector1, const vector<T> &vector2){
-    for(auto i{0};i<vector1.size();++i) {
-      if(vector1.at(i)!=vector2.at(i)){
-        return true;
-      }
+}
+#else
+/// Lexicographic order: the first differing elements decide, or else the
+/// shorter vector comes first.
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+bool operator<(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+               const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  if constexpr (is_trivially_equality_comparable<T>::value) {
+    std::size_t common = std::min(vector1.size(), vector2.size());
+    std::size_t i = detail::mismatch(vector1.data(), vector2.data(), common);
+    if (i < common) {
+      return vector1[i] < vector2[i];
     }
-    return false;
+    return vector1.size() < vector2.size();
+  } else {
+    return std::lexicographical_compare(
+        vector1.data(), vector1.data() + vector1.size(), vector2.data(),
+        vector2.data() + vector2.size());
+  }
+}
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+bool operator>(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+               const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  return vector2 < vector1;
 }
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+bool operator<=(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+                const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  return !(vector2 < vector1);
+}
+template <typename T, typename Alloc, typename GrowthPolicy, std::size_t N>
+bool operator>=(const vector<T, Alloc, GrowthPolicy, N> &vector1,
+                const vector<T, Alloc, GrowthPolicy, N> &vector2) {
+  return !(vector1 < vector2);
+}
+#endif
+
+/// Vectors whose memory comes from a `std::pmr::memory_resource`.
+namespace pmr {
+template <typename T, typename GrowthPolicy = growth::doubling>
+using vector =
+    sc::vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+} // namespace pmr
+
+/// A vector that keeps up to `N` elements inline and spills to the heap
+/// only past that. Same interface and iterators as `sc::vector`.
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>,
+          typename GrowthPolicy = growth::doubling>
+using small_vector = vector<T, Alloc, GrowthPolicy, N>;
 
 } // namespace sc.
 
@@ -34,31 +34,31 @@
 // Initializer list assignment, as in vector<int> vec = { 1, 2, 3 };
 #define INITIALISZER_ASSIGNMENT YES
 // Size method
-#define SIZE NO
+#define SIZE YES
 // Clear method
 #define CLEAR YES
 // Push back method
 #define PUSH_BACK YES
 // Pop back method
-#define POP_BACK NO
+#define POP_BACK YES
 // Reference front, as in vec.front() = 3;
-#define REF_FRONT NO
+#define REF_FRONT YES
 // Const front, as in x = vec.front();
-#define CONST_FRONT NO
+#define CONST_FRONT YES
 // Reference back, as in vec.back() = 3;
-#define REF_BACK NO
+#define REF_BACK YES
 // Const back, as in x = vec.back();
-#define CONST_BACK NO
+#define CONST_BACK YES
 // Assign `count` elements with `value` to the vector: vec.assign(3,value);
 #define ASSIGN_COUNT_VALUES YES
 // Const index access operator, as in x = vec[3];
-#define CONST_INDEX_OP NO
+#define CONST_INDEX_OP YES
 // Reference index access operator, as in vec[3] = x;
-#define REF_INDEX_OP NO
+#define REF_INDEX_OP YES
 // Const index access operator with bounds check, as in x = vec.at(3);
 #define CONST_AT_INDEX YES
 // Reference index access operator with bounds check, as in vec.at(3) = x;
-#define REF_AT_INDEX NO
+#define REF_AT_INDEX YES
 // Reserve methos, that increases the vector storage capacity explicitly.
 #define RESERVE YES
 // Storage capacity of the vector.
@@ -74,9 +74,9 @@
 // Insert a range of elements before pos
 #define INSERT_RANGE YES
 // Insert a initializer list of elements before pos
-#define INSERT_INITIALIZER NO
+#define INSERT_INITIALIZER YES
 // Erase a range of elements begining at pos
-#define ERASE_RANGE NO
+#define ERASE_RANGE YES
 // Erase a single values at pos
 #define ERASE_SINGLE_VALUE YES
 